@@ -0,0 +1,393 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    ahrs.c
+ * @author  mario.kodba
+ * @brief   Fixed point Mahony orientation filter for MPU-9150 sensor data source file.
+ * @details Takes gyroscope (deg/s), accelerometer (mG) and magnetometer (0.1 uT) values as produced
+ *          by BSP_MPU9150_updateValues. Cortex-M0 has no FPU or divide instruction, so quaternion and
+ *          direction vectors are kept in Q30, angular rates in Q24, and division is only used once
+ *          per vector for normalization. Without valid magnetometer data filter falls back to
+ *          accelerometer only correction, in which case heading is not corrected.
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include <stddef.h>
+
+#include "ahrs.h"
+#include "compiler_abstraction.h"
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+#define AHRS_Q30_SHIFT              (30u)           //!< Number of fractional bits in Q30 format
+#define AHRS_Q24_TO_Q30_SHIFT       (24u)           //!< Shift of Q24 by Q30 product to get Q30 result
+#define AHRS_Q15_TO_Q30_SHIFT       (15u)           //!< Q15 to Q30 shift, used around square root
+#define AHRS_DEG_TO_RAD_Q24         (292818)        //!< pi / 180 in Q24
+#define AHRS_HALF_Q30               (1L << 29)      //!< 0.5 in Q30 format
+#define AHRS_MILLI_G_PER_HALF_G     (2000)          //!< Scales half gravity vector to mG
+#define AHRS_INVALID_SAMPLE_VALUE   (INT16_MIN)     //!< Magnetometer value marking invalid sample
+
+/***************************************************************************************************
+ *                          PRIVATE FUNCTION DECLARATIONS
+ **************************************************************************************************/
+__INLINE static int32_t AHRS_mul(int32_t a, int32_t b, uint8_t shift);
+static uint32_t AHRS_sqrt(uint32_t value);
+static bool AHRS_normalize(const int16_t *vector, int32_t *outVector);
+
+/***************************************************************************************************
+ *                         PUBLIC FUNCTION DEFINITIONS
+ **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Initializes AHRS instance, orientation starts from identity quaternion.
+ ***************************************************************************************************
+ * @param [in]  *ahrs   - pointer to AHRS instance.
+ * @param [in]  *config - pointer to AHRS configuration.
+ * @param [out] *outErr - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void AHRS_init(AHRS_instance_S *ahrs, const AHRS_config_S *config, AHRS_err_E *outErr) {
+
+    AHRS_err_E err = AHRS_err_NONE;
+    uint8_t i = 0u;
+
+    if((ahrs != NULL) && (config != NULL)) {
+        ahrs->config = config;
+
+        ahrs->q[0] = AHRS_Q30_ONE;
+        for(i = 1u; i < AHRS_QUATERNION_SIZE; i++) {
+            ahrs->q[i] = 0;
+        }
+
+        for(i = 0u; i < AHRS_AXIS_COUNT; i++) {
+            ahrs->integralFb[i] = 0;
+        }
+
+        AHRS_setSampleRate(ahrs, config->sampleRateHz, &err);
+
+        if(err == AHRS_err_NONE) {
+            AHRS_setOutputDivider(ahrs, config->outputDivider, &err);
+        }
+    } else {
+        err = AHRS_err_NULL_PARAM;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Sets rate at which AHRS_update is called, has to follow sensor sample rate.
+ ***************************************************************************************************
+ * @param [in]  *ahrs         - pointer to AHRS instance.
+ * @param [in]  sampleRateHz  - sensor sample rate in Hz.
+ * @param [out] *outErr       - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void AHRS_setSampleRate(AHRS_instance_S *ahrs, uint16_t sampleRateHz, AHRS_err_E *outErr) {
+
+    AHRS_err_E err = AHRS_err_NONE;
+
+    if(ahrs == NULL) {
+        err = AHRS_err_NULL_PARAM;
+    } else if(sampleRateHz == 0u) {
+        err = AHRS_err_INVALID_PARAM;
+    } else {
+        ahrs->halfDt = AHRS_Q30_ONE / (2 * (int32_t) sampleRateHz);
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Sets output rate as fraction of sample rate, independently of sensor sample rate.
+ ***************************************************************************************************
+ * @param [in]  *ahrs          - pointer to AHRS instance.
+ * @param [in]  outputDivider  - output is produced on every outputDivider-th sample.
+ * @param [out] *outErr        - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void AHRS_setOutputDivider(AHRS_instance_S *ahrs, uint8_t outputDivider, AHRS_err_E *outErr) {
+
+    AHRS_err_E err = AHRS_err_NONE;
+
+    if(ahrs == NULL) {
+        err = AHRS_err_NULL_PARAM;
+    } else if(outputDivider == 0u) {
+        err = AHRS_err_INVALID_PARAM;
+    } else {
+        ahrs->outputDivider = outputDivider;
+        ahrs->sampleCount = 0u;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Updates orientation with single sensor sample.
+ * @details Mahony complementary filter - error between measured and estimated gravity (and
+ *          magnetic field) direction is fed back into gyroscope rates, which are then integrated
+ *          into orientation quaternion.
+ ***************************************************************************************************
+ * @param [in]  *ahrs    - pointer to AHRS instance.
+ * @param [in]  *gyro    - pointer to gyroscope X, Y, Z values in deg/s.
+ * @param [in]  *acc     - pointer to accelerometer X, Y, Z values in mG.
+ * @param [in]  *mag     - pointer to magnetometer X, Y, Z values aligned to accelerometer axes,
+ *                         NULL if not available.
+ * @param [out] *output  - filled with orientation (and linear acceleration) when output is due.
+ ***************************************************************************************************
+ * @return true if output was filled, false otherwise.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+bool AHRS_update(AHRS_instance_S *ahrs,
+        const int16_t *gyro,
+        const int16_t *acc,
+        const int16_t *mag,
+        AHRS_output_S *output) {
+
+    int32_t *q = &ahrs->q[0];
+    int32_t g[AHRS_AXIS_COUNT];
+    int32_t a[AHRS_AXIS_COUNT];
+    int32_t m[AHRS_AXIS_COUNT];
+    int32_t halfV[AHRS_AXIS_COUNT];
+    int32_t halfE[AHRS_AXIS_COUNT] = { 0 };
+    bool outputReady = false;
+    uint8_t i = 0u;
+
+    // gyroscope rates to rad/s in Q24
+    for(i = 0u; i < AHRS_AXIS_COUNT; i++) {
+        g[i] = gyro[i] * AHRS_DEG_TO_RAD_Q24;
+    }
+
+    // quaternion products, used in all direction estimates
+    int32_t q0q0 = AHRS_mul(q[0], q[0], AHRS_Q30_SHIFT);
+    int32_t q0q1 = AHRS_mul(q[0], q[1], AHRS_Q30_SHIFT);
+    int32_t q0q2 = AHRS_mul(q[0], q[2], AHRS_Q30_SHIFT);
+    int32_t q0q3 = AHRS_mul(q[0], q[3], AHRS_Q30_SHIFT);
+    int32_t q1q1 = AHRS_mul(q[1], q[1], AHRS_Q30_SHIFT);
+    int32_t q1q2 = AHRS_mul(q[1], q[2], AHRS_Q30_SHIFT);
+    int32_t q1q3 = AHRS_mul(q[1], q[3], AHRS_Q30_SHIFT);
+    int32_t q2q2 = AHRS_mul(q[2], q[2], AHRS_Q30_SHIFT);
+    int32_t q2q3 = AHRS_mul(q[2], q[3], AHRS_Q30_SHIFT);
+    int32_t q3q3 = AHRS_mul(q[3], q[3], AHRS_Q30_SHIFT);
+
+    // estimated direction of gravity (half vector)
+    halfV[0] = q1q3 - q0q2;
+    halfV[1] = q0q1 + q2q3;
+    halfV[2] = q0q0 - AHRS_HALF_Q30 + q3q3;
+
+    // accelerometer is not valid in free fall, skip feedback then
+    if(AHRS_normalize(acc, &a[0]) == true) {
+        // error is cross product between measured and estimated direction of gravity
+        halfE[0] = AHRS_mul(a[1], halfV[2], AHRS_Q30_SHIFT) - AHRS_mul(a[2], halfV[1], AHRS_Q30_SHIFT);
+        halfE[1] = AHRS_mul(a[2], halfV[0], AHRS_Q30_SHIFT) - AHRS_mul(a[0], halfV[2], AHRS_Q30_SHIFT);
+        halfE[2] = AHRS_mul(a[0], halfV[1], AHRS_Q30_SHIFT) - AHRS_mul(a[1], halfV[0], AHRS_Q30_SHIFT);
+
+        if((mag != NULL) && (mag[0] != AHRS_INVALID_SAMPLE_VALUE) && (AHRS_normalize(mag, &m[0]) == true)) {
+            int32_t halfW[AHRS_AXIS_COUNT];
+            int32_t hx = 0;
+            int32_t hy = 0;
+            int32_t bx = 0;
+            int32_t bz = 0;
+
+            // reference direction of Earth's magnetic field, rotated to earth frame
+            hx = 2 * (AHRS_mul(m[0], AHRS_HALF_Q30 - q2q2 - q3q3, AHRS_Q30_SHIFT)
+                    + AHRS_mul(m[1], q1q2 - q0q3, AHRS_Q30_SHIFT)
+                    + AHRS_mul(m[2], q1q3 + q0q2, AHRS_Q30_SHIFT));
+            hy = 2 * (AHRS_mul(m[0], q1q2 + q0q3, AHRS_Q30_SHIFT)
+                    + AHRS_mul(m[1], AHRS_HALF_Q30 - q1q1 - q3q3, AHRS_Q30_SHIFT)
+                    + AHRS_mul(m[2], q2q3 - q0q1, AHRS_Q30_SHIFT));
+            bz = 2 * (AHRS_mul(m[0], q1q3 - q0q2, AHRS_Q30_SHIFT)
+                    + AHRS_mul(m[1], q2q3 + q0q1, AHRS_Q30_SHIFT)
+                    + AHRS_mul(m[2], AHRS_HALF_Q30 - q1q1 - q2q2, AHRS_Q30_SHIFT));
+            // horizontal component, square root is taken in Q15 precision
+            hx >>= AHRS_Q15_TO_Q30_SHIFT;
+            hy >>= AHRS_Q15_TO_Q30_SHIFT;
+            bx = (int32_t) (AHRS_sqrt((uint32_t) (hx * hx) + (uint32_t) (hy * hy)) << AHRS_Q15_TO_Q30_SHIFT);
+
+            // estimated direction of magnetic field (half vector)
+            halfW[0] = AHRS_mul(bx, AHRS_HALF_Q30 - q2q2 - q3q3, AHRS_Q30_SHIFT) + AHRS_mul(bz, q1q3 - q0q2, AHRS_Q30_SHIFT);
+            halfW[1] = AHRS_mul(bx, q1q2 - q0q3, AHRS_Q30_SHIFT) + AHRS_mul(bz, q0q1 + q2q3, AHRS_Q30_SHIFT);
+            halfW[2] = AHRS_mul(bx, q0q2 + q1q3, AHRS_Q30_SHIFT) + AHRS_mul(bz, AHRS_HALF_Q30 - q1q1 - q2q2, AHRS_Q30_SHIFT);
+
+            halfE[0] += AHRS_mul(m[1], halfW[2], AHRS_Q30_SHIFT) - AHRS_mul(m[2], halfW[1], AHRS_Q30_SHIFT);
+            halfE[1] += AHRS_mul(m[2], halfW[0], AHRS_Q30_SHIFT) - AHRS_mul(m[0], halfW[2], AHRS_Q30_SHIFT);
+            halfE[2] += AHRS_mul(m[0], halfW[1], AHRS_Q30_SHIFT) - AHRS_mul(m[1], halfW[0], AHRS_Q30_SHIFT);
+        }
+
+        for(i = 0u; i < AHRS_AXIS_COUNT; i++) {
+            if(ahrs->config->twoKi > 0) {
+                // integral feedback over sample period (2 * halfDt)
+                ahrs->integralFb[i] += AHRS_mul(AHRS_mul(ahrs->config->twoKi, halfE[i], AHRS_Q30_SHIFT),
+                        2 * ahrs->halfDt,
+                        AHRS_Q30_SHIFT);
+                g[i] += ahrs->integralFb[i];
+            } else {
+                ahrs->integralFb[i] = 0;
+            }
+
+            // proportional feedback
+            g[i] += AHRS_mul(ahrs->config->twoKp, halfE[i], AHRS_Q30_SHIFT);
+        }
+    }
+
+    // rate of change of quaternion, rates scaled by half sample period to Q30
+    for(i = 0u; i < AHRS_AXIS_COUNT; i++) {
+        g[i] = AHRS_mul(g[i], ahrs->halfDt, AHRS_Q24_TO_Q30_SHIFT);
+    }
+
+    int32_t qa = q[0];
+    int32_t qb = q[1];
+    int32_t qc = q[2];
+
+    q[0] += -AHRS_mul(qb, g[0], AHRS_Q30_SHIFT) - AHRS_mul(qc, g[1], AHRS_Q30_SHIFT) - AHRS_mul(q[3], g[2], AHRS_Q30_SHIFT);
+    q[1] += AHRS_mul(qa, g[0], AHRS_Q30_SHIFT) + AHRS_mul(qc, g[2], AHRS_Q30_SHIFT) - AHRS_mul(q[3], g[1], AHRS_Q30_SHIFT);
+    q[2] += AHRS_mul(qa, g[1], AHRS_Q30_SHIFT) - AHRS_mul(qb, g[2], AHRS_Q30_SHIFT) + AHRS_mul(q[3], g[0], AHRS_Q30_SHIFT);
+    q[3] += AHRS_mul(qa, g[2], AHRS_Q30_SHIFT) + AHRS_mul(qb, g[1], AHRS_Q30_SHIFT) - AHRS_mul(qc, g[0], AHRS_Q30_SHIFT);
+
+    // quaternion stays close to unit length, so single Newton step (3 - n^2) / 2 renormalizes it
+    int32_t normSq = 0;
+    for(i = 0u; i < AHRS_QUATERNION_SIZE; i++) {
+        normSq += AHRS_mul(q[i], q[i], AHRS_Q30_SHIFT);
+    }
+    int32_t normFactor = AHRS_Q30_ONE + ((AHRS_Q30_ONE - normSq) / 2);
+    for(i = 0u; i < AHRS_QUATERNION_SIZE; i++) {
+        q[i] = AHRS_mul(q[i], normFactor, AHRS_Q30_SHIFT);
+    }
+
+    ahrs->sampleCount++;
+    if(ahrs->sampleCount >= ahrs->outputDivider) {
+        ahrs->sampleCount = 0u;
+
+        if(output != NULL) {
+            for(i = 0u; i < AHRS_QUATERNION_SIZE; i++) {
+                output->quaternion[i] = (int16_t) (q[i] >> AHRS_OUTPUT_QUATERNION_SHIFT);
+            }
+#if (AHRS_LINEAR_ACC_ENABLED == true)
+            // gravity in sensor frame is estimated before this sample's update, error is negligible
+            for(i = 0u; i < AHRS_AXIS_COUNT; i++) {
+                output->linearAcc[i] = (int16_t) (acc[i] - AHRS_mul(halfV[i], AHRS_MILLI_G_PER_HALF_G, AHRS_Q30_SHIFT));
+            }
+#endif
+            outputReady = true;
+        }
+    }
+
+    return outputReady;
+}
+
+/***************************************************************************************************
+ *                          PRIVATE FUNCTION DEFINITIONS
+ **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Multiplies two fixed point values and shifts result back to wanted format.
+ ***************************************************************************************************
+ * @param [in]  a     - first factor.
+ * @param [in]  b     - second factor.
+ * @param [in]  shift - number of fractional bits removed from 64-bit product.
+ ***************************************************************************************************
+ * @return Shifted product.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static int32_t AHRS_mul(int32_t a, int32_t b, uint8_t shift) {
+
+    return (int32_t) (((int64_t) a * b) >> shift);
+}
+
+/***********************************************************************************************//**
+ * @brief Integer square root, bit by bit.
+ ***************************************************************************************************
+ * @param [in]  value - value to take square root of.
+ ***************************************************************************************************
+ * @return Square root rounded down.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint32_t AHRS_sqrt(uint32_t value) {
+
+    uint32_t root = 0u;
+    uint32_t bit = 1uL << 30u;
+
+    while(bit > value) {
+        bit >>= 2u;
+    }
+
+    while(bit != 0u) {
+        if(value >= (root + bit)) {
+            value -= root + bit;
+            root = (root >> 1u) + bit;
+        } else {
+            root >>= 1u;
+        }
+        bit >>= 2u;
+    }
+
+    return root;
+}
+
+/***********************************************************************************************//**
+ * @brief Normalizes 3-axis sensor vector to unit length in Q30.
+ ***************************************************************************************************
+ * @param [in]  *vector    - pointer to X, Y, Z sensor values.
+ * @param [out] *outVector - pointer to normalized vector in Q30.
+ ***************************************************************************************************
+ * @return false if vector has zero length, true otherwise.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static bool AHRS_normalize(const int16_t *vector, int32_t *outVector) {
+
+    uint32_t normSq = 0u;
+    int32_t invNorm = 0;
+    uint8_t i = 0u;
+
+    // 3 * 32768^2 still fits in 32 bits
+    for(i = 0u; i < AHRS_AXIS_COUNT; i++) {
+        normSq += (uint32_t) (vector[i] * vector[i]);
+    }
+
+    if(normSq != 0u) {
+        // each component is at most norm long, so product with 1 / norm fits in Q30
+        invNorm = AHRS_Q30_ONE / (int32_t) AHRS_sqrt(normSq);
+        for(i = 0u; i < AHRS_AXIS_COUNT; i++) {
+            outVector[i] = vector[i] * invNorm;
+        }
+    }
+
+    return (normSq != 0u);
+}
+
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
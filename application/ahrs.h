@@ -0,0 +1,100 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    ahrs.h
+ * @author  mario.kodba
+ * @brief   Fixed point Mahony orientation filter for MPU-9150 sensor data header file.
+ **************************************************************************************************/
+
+#ifndef AHRS_H_
+#define AHRS_H_
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+//! If set to true linear acceleration (gravity removed) is sent along orientation quaternion
+#define AHRS_LINEAR_ACC_ENABLED     true
+
+#define AHRS_QUATERNION_SIZE        (4u)        //!< Number of quaternion components
+#define AHRS_AXIS_COUNT             (3u)        //!< Number of sensor axes
+#define AHRS_Q30_ONE                (1L << 30)  //!< 1.0 in Q30 format
+#define AHRS_Q24_ONE                (1L << 24)  //!< 1.0 in Q24 format
+#define AHRS_OUTPUT_QUATERNION_SHIFT (16u)      //!< Q30 to Q14 shift for quaternion output
+
+/***************************************************************************************************
+ *                              ENUMERATIONS
+ **************************************************************************************************/
+//! AHRS error enumeration
+typedef enum AHRS_err_ENUM {
+    AHRS_err_NONE               = 0u,   //!< No error
+    AHRS_err_NULL_PARAM,                //!< NULL parameter error
+    AHRS_err_INVALID_PARAM              //!< Parameter out of range error
+} AHRS_err_E;
+
+/***************************************************************************************************
+ *                              DATA STRUCTURES
+ **************************************************************************************************/
+//! AHRS configuration structure
+typedef struct AHRS_config_STRUCT {
+    uint16_t sampleRateHz;                      //!< Rate at which AHRS_update is called
+    int32_t twoKp;                              //!< Proportional feedback gain (2 * Kp) in Q24
+    int32_t twoKi;                              //!< Integral feedback gain (2 * Ki) in Q24, 0 disables integral feedback
+    uint8_t outputDivider;                      //!< Output is produced on every outputDivider-th sample
+} AHRS_config_S;
+
+//! AHRS output, sent over BLE
+typedef struct AHRS_output_STRUCT {
+    int16_t quaternion[AHRS_QUATERNION_SIZE];   //!< Orientation quaternion w, x, y, z in Q14
+#if (AHRS_LINEAR_ACC_ENABLED == true)
+    int16_t linearAcc[AHRS_AXIS_COUNT];         //!< Linear acceleration in sensor frame in mG
+#endif
+} AHRS_output_S;
+
+//! AHRS instance structure
+typedef struct AHRS_instance_STRUCT {
+    const AHRS_config_S *config;                //!< Pointer to AHRS configuration
+    int32_t q[AHRS_QUATERNION_SIZE];            //!< Orientation quaternion in Q30
+    int32_t integralFb[AHRS_AXIS_COUNT];        //!< Integral feedback in rad/s, Q24
+    int32_t halfDt;                             //!< Half of sample period in seconds, Q30
+    uint8_t outputDivider;                      //!< Output is produced on every outputDivider-th sample
+    uint8_t sampleCount;                        //!< Samples since last output
+} AHRS_instance_S;
+
+/***************************************************************************************************
+ *                              GLOBAL VARIABLES
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *                         PUBLIC FUNCTION DECLARATIONS
+ **************************************************************************************************/
+void AHRS_init(AHRS_instance_S *ahrs, const AHRS_config_S *config, AHRS_err_E *outErr);
+void AHRS_setSampleRate(AHRS_instance_S *ahrs, uint16_t sampleRateHz, AHRS_err_E *outErr);
+void AHRS_setOutputDivider(AHRS_instance_S *ahrs, uint8_t outputDivider, AHRS_err_E *outErr);
+bool AHRS_update(AHRS_instance_S *ahrs,
+        const int16_t *gyro,
+        const int16_t *acc,
+        const int16_t *mag,
+        AHRS_output_S *output);
+
+#endif // #ifndef AHRS_H_
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
@@ -35,24 +35,51 @@
  *                              DEFINES
  **************************************************************************************************/
 #define BLE_ECGS_ON_WRITE_NOTIFICATION_BYTE_SIZE        (2u)    //!< Number of bytes received in CCCD handle write event for notification.
+#define BLE_ECGS_CP_ECG_CONFIG_SIZE                     (2u)    //!< Control point ECG configuration parameters size - conversion rate, PGA gain.
+#define BLE_ECGS_CP_CONN_PARAMS_SIZE                    (8u)    //!< Control point connection parameters size - 4 uint16 values.
 
 /***************************************************************************************************
  *                          GLOBAL VARIABLES
  **************************************************************************************************/
+//! Control point opcode table, size of request parameters for each opcode
+static const uint8_t ecgsCpParamSize[BLE_ECGS_CP_OP_COUNT] = {
+    [BLE_ECGS_CP_OP_START_STREAMS]      = 1u,
+    [BLE_ECGS_CP_OP_STOP_STREAMS]       = 1u,
+    [BLE_ECGS_CP_OP_SET_ECG_CONFIG]     = BLE_ECGS_CP_ECG_CONFIG_SIZE,
+    [BLE_ECGS_CP_OP_SET_MPU_CONFIG]     = BLE_ECGS_MPU_CONFIG_BYTE_SIZE,
+    [BLE_ECGS_CP_OP_SELECT_CODEC]       = 1u,
+    [BLE_ECGS_CP_OP_SET_CONN_PARAMS]    = BLE_ECGS_CP_CONN_PARAMS_SIZE,
+    [BLE_ECGS_CP_OP_GET_CAPABILITIES]   = 0u,
+};
 
 
 /***************************************************************************************************
  *                          PRIVATE FUNCTION DECLARATIONS
  **************************************************************************************************/
-static void BLE_ECGS_ecgDataCharAdd(BLE_ECGS_custom_S *customService,
+static void BLE_ECGS_streamCharAdd(BLE_ECGS_custom_S *customService,
         const BLE_ECGS_customInit_S *customInit,
         BLE_ECGS_err_E *err);
-static void BLE_ECGS_mpuDataCharAdd(BLE_ECGS_custom_S *customService,
+static void BLE_ECGS_mpuConfigCharAdd(BLE_ECGS_custom_S *customService,
+        const BLE_ECGS_customInit_S *customInit,
+        BLE_ECGS_err_E *err);
+static void BLE_ECGS_leadOffCharAdd(BLE_ECGS_custom_S *customService,
+        const BLE_ECGS_customInit_S *customInit,
+        BLE_ECGS_err_E *err);
+static void BLE_ECGS_controlPointCharAdd(BLE_ECGS_custom_S *customService,
         const BLE_ECGS_customInit_S *customInit,
         BLE_ECGS_err_E *err);
 static void BLE_ECGS_onConnect(BLE_ECGS_custom_S *customService, ble_evt_t const *p_ble_evt);
 static void BLE_ECGS_onWrite(BLE_ECGS_custom_S *customService, ble_evt_t *p_ble_evt);
 static void BLE_ECGS_onDisconnect(BLE_ECGS_custom_S *customService, ble_evt_t const *p_ble_evt);
+static void BLE_ECGS_onTxComplete(BLE_ECGS_custom_S *customService);
+static void BLE_ECGS_onAuthorizeRequest(BLE_ECGS_custom_S *customService, ble_evt_t *ble_evt);
+static void BLE_ECGS_onControlPointRequest(BLE_ECGS_custom_S *customService, const uint8_t *data, uint16_t len);
+static void BLE_ECGS_mpuConfigDecode(const uint8_t *data, BLE_ECGS_mpuConfig_S *mpuConfig);
+static uint32_t BLE_ECGS_notify(BLE_ECGS_custom_S *customService,
+        uint16_t valueHandle,
+        uint8_t *data,
+        uint16_t len);
+static uint32_t BLE_ECGS_streamSend(BLE_ECGS_custom_S *customService, uint8_t size);
 
 /***************************************************************************************************
  *                          PUBLIC FUNCTION DEFINITIONS
@@ -78,6 +105,14 @@ void BLE_ECGS_init(BLE_ECGS_custom_S *customService,
     if((customService != NULL) && (customInit != NULL)) {
         // initialize service structure
         customService->conn_handle = BLE_CONN_HANDLE_INVALID;
+        customService->tx_buffer_count = 0u;
+        customService->tx_queued = 0u;
+        customService->tx_completed = 0u;
+        customService->stream_sequence = 0u;
+        customService->stream_length = 0u;
+        customService->stream_record_offset = 0u;
+        customService->control_point_indication_enabled = false;
+        customService->control_point_busy = false;
         // set application event handler
         customService->evt_handler = customInit->evt_handler;
 
@@ -101,13 +136,23 @@ void BLE_ECGS_init(BLE_ECGS_custom_S *customService,
         }
 
         if(localErr == BLE_ECGS_err_NONE) {
-            // add ECG data characteristics
-            BLE_ECGS_ecgDataCharAdd(customService, customInit, &localErr);
+            // add sensor data stream characteristics
+            BLE_ECGS_streamCharAdd(customService, customInit, &localErr);
+        }
+
+        if(localErr == BLE_ECGS_err_NONE) {
+            // add MPU configuration characteristics
+            BLE_ECGS_mpuConfigCharAdd(customService, customInit, &localErr);
+        }
+
+        if(localErr == BLE_ECGS_err_NONE) {
+            // add lead-off status characteristics
+            BLE_ECGS_leadOffCharAdd(customService, customInit, &localErr);
         }
 
         if(localErr == BLE_ECGS_err_NONE) {
-            // add MPU data characteristics
-            BLE_ECGS_mpuDataCharAdd(customService, customInit, &localErr);
+            // add control point characteristics
+            BLE_ECGS_controlPointCharAdd(customService, customInit, &localErr);
         }
     } else {
         localErr = BLE_ECGS_err_NULL_PARAM;
@@ -145,9 +190,26 @@ void BLE_ECGS_onBleEvt(ble_evt_t *ble_evt, void *context) {
                 BLE_ECGS_onWrite(customService, ble_evt);
                 break;
 
+            case BLE_GATTS_EVT_RW_AUTHORIZE_REQUEST:
+                BLE_ECGS_onAuthorizeRequest(customService, ble_evt);
+                break;
+
+            case BLE_GATTS_EVT_HVC:
+                // control point response confirmed, next request can be accepted
+                if(ble_evt->evt.gatts_evt.params.hvc.handle == customService->control_point_handles.value_handle) {
+                    customService->control_point_busy = false;
+                }
+                break;
+
+            case BLE_GATTS_EVT_TIMEOUT:
+                // no more ATT traffic on this link, it is going to be disconnected
+                customService->control_point_busy = false;
+                break;
+
             case BLE_EVT_TX_COMPLETE:
-                // should set free at least one TX buffer
-                muhaBleTxBufferAvailable = true;
+                // returns credits for all notifications transmitted in last connection event
+                customService->tx_completed += ble_evt->evt.common_evt.params.tx_complete.count;
+                BLE_ECGS_onTxComplete(customService);
                 break;
 
             default:
@@ -157,68 +219,233 @@ void BLE_ECGS_onBleEvt(ble_evt_t *ble_evt, void *context) {
 }
 
 /***********************************************************************************************//**
- * @brief Function for update custom BLE characteristic, meant for ECG ADC data.
+ * @brief Function appends record to sensor data stream.
+ * @details Record is queued whole or not at all, it is sent by BLE_ECGS_streamFlush. Records of
+ *          all types share stream notifications, so record may start in one notification and end
+ *          in the next one.
+ *
+ *          Record layout, multi-byte values are LSB first:
+ *          - byte 0: record type (bits 7..4), BLE_ECGS_FLAG_x (bits 3..0).
+ *          - byte 1: number of bytes following this one.
+ *          - byte 2: number of samples in record.
+ *          - byte 3..4: TIMER1 value of first sample in record.
+ *          - byte 5..: payload.
  ***************************************************************************************************
- * @param [in]  customService   - Pointer to custom ECG service structure.
- * @param [in]  ecgData         - Pointer to array of data to be written to characteristic.
- * @return NRF error code.
+ * @param [in]  customService   - Pointer to custom custom service structure.
+ * @param [in]  type            - Record type.
+ * @param [in]  header          - Pointer to record header.
+ * @param [in]  data            - Pointer to record payload.
+ * @param [in]  size            - Payload size, up to BLE_ECGS_RECORD_MAX_PAYLOAD.
+ * @return NRF_ERROR_NO_MEM if record does not fit in stream buffer right now, NRF_ERROR_INVALID_STATE
+ *         if peer did not enable stream notifications.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    16.04.2021.
+ * @date    17.10.2026.
  **************************************************************************************************/
-uint32_t BLE_ECGS_ecgDataUpdate(BLE_ECGS_custom_S *customService, uint8_t *ecgData) {
+uint32_t BLE_ECGS_recordWrite(BLE_ECGS_custom_S *customService,
+        BLE_ECGS_recordType_E type,
+        const BLE_ECGS_recordHeader_S *header,
+        const uint8_t *data,
+        uint8_t size) {
 
     uint32_t err_code = NRF_SUCCESS;
-    uint16_t len = NRF51_MUHA_ADS1192_BLE_BYTE_SIZE;
-    ble_gatts_hvx_params_t hvx_params;
+    uint8_t *record = NULL;
 
-    // send value if connected and peer enabled notifications for ECG characteristic
-    if((customService->conn_handle != BLE_CONN_HANDLE_INVALID) &&
-            (muhaEcgNotificationEnabled == true)) {
+    if(size > BLE_ECGS_RECORD_MAX_PAYLOAD) {
+        err_code = NRF_ERROR_DATA_SIZE;
+    } else if(muhaStreamNotificationEnabled == false) {
+        err_code = NRF_ERROR_INVALID_STATE;
+    } else if((customService->stream_length + BLE_ECGS_RECORD_HEADER_SIZE + size) > BLE_ECGS_STREAM_BUFFER_SIZE) {
+        err_code = NRF_ERROR_NO_MEM;
+    } else {
+        record = &customService->stream_buffer[customService->stream_length];
 
-        hvx_params.handle = customService->custom_value_handles.value_handle;
-        hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
-        hvx_params.offset = 0u;
-        hvx_params.p_len  = &len;
-        hvx_params.p_data = ecgData;
+        record[0] = (uint8_t) ((type << BLE_ECGS_RECORD_TYPE_SHIFT) | (header->flags & BLE_ECGS_RECORD_FLAGS_MASK));
+        record[1] = (uint8_t) ((BLE_ECGS_RECORD_HEADER_SIZE - BLE_ECGS_RECORD_TL_SIZE) + size);
+        record[2] = header->sampleCount;
+        (void) uint16_encode(header->timestamp, &record[3]);
+        memcpy(&record[BLE_ECGS_RECORD_HEADER_SIZE], data, size);
 
-        err_code = sd_ble_gatts_hvx(customService->conn_handle, &hvx_params);
-    } else {
-        err_code = NRF_ERROR_INVALID_STATE;
+        customService->stream_length += BLE_ECGS_RECORD_HEADER_SIZE + size;
+    }
+
+    return err_code;
+}
+
+/***********************************************************************************************//**
+ * @brief Function sends queued stream bytes as notifications, as long as there are TX credits.
+ * @details Full notifications are always sent. Partially filled notification is sent only if no
+ *          notification is in flight, otherwise it waits to be topped up with next records until
+ *          BLE_EVT_TX_COMPLETE. Stream bytes are kept if SoftDevice TX buffers are full or peer
+ *          has not enabled stream notifications, and are dropped if they can not be sent for any
+ *          other reason.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom custom service structure.
+ * @return NRF error code of the last notification.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint32_t BLE_ECGS_streamFlush(BLE_ECGS_custom_S *customService) {
+
+    uint32_t err_code = NRF_SUCCESS;
+    uint8_t credits = BLE_ECGS_txCreditsGet(customService);
+    uint8_t size = MIN(customService->stream_length, BLE_ECGS_STREAM_PAYLOAD_SIZE);
+
+    while((err_code != BLE_ERROR_NO_TX_PACKETS) && (err_code != NRF_ERROR_INVALID_STATE) &&
+            (credits != 0u) && (size != 0u) &&
+            ((size == BLE_ECGS_STREAM_PAYLOAD_SIZE) || (credits == customService->tx_buffer_count))) {
+
+        err_code = BLE_ECGS_streamSend(customService, size);
+
+        credits = BLE_ECGS_txCreditsGet(customService);
+        size = MIN(customService->stream_length, BLE_ECGS_STREAM_PAYLOAD_SIZE);
     }
 
     return err_code;
 }
 
 /***********************************************************************************************//**
- * @brief Function for update custom BLE characteristic, meant for MPU sensor data.
+ * @brief Function for update of MPU configuration characteristic value, read by peer.
+ * @details Value is set in attribute table only, peer is not notified. Can be called while not
+ *          connected.
  ***************************************************************************************************
  * @param [in]  customService   - Pointer to custom custom service structure.
- * @param [in]  mpuData         - Pointer to array of data to be written to characteristic.
+ * @param [in]  mpuConfig       - Pointer to MPU configuration currently applied.
  * @return NRF error code.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    16.04.2021.
+ * @date    17.10.2026.
  **************************************************************************************************/
-uint32_t BLE_ECGS_mpuDataUpdate(BLE_ECGS_custom_S *customService, uint8_t *mpuData) {
+uint32_t BLE_ECGS_mpuConfigUpdate(BLE_ECGS_custom_S *customService, const BLE_ECGS_mpuConfig_S *mpuConfig) {
+
+    ble_gatts_value_t gatts_value;
+    uint8_t configData[BLE_ECGS_MPU_CONFIG_BYTE_SIZE];
+
+    (void) uint16_encode(mpuConfig->sampleRateHz, &configData[0]);
+    configData[2] = mpuConfig->dlpf;
+    configData[3] = mpuConfig->gyroRange;
+    configData[4] = mpuConfig->accRange;
+
+    memset(&gatts_value, 0, sizeof(gatts_value));
 
+    gatts_value.len     = BLE_ECGS_MPU_CONFIG_BYTE_SIZE;
+    gatts_value.offset  = 0u;
+    gatts_value.p_value = &configData[0];
+
+    return sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID,
+            customService->mpu_config_handles.value_handle,
+            &gatts_value);
+}
+
+/***********************************************************************************************//**
+ * @brief Function for update lead-off status characteristic, called on lead-off status change.
+ * @details Value is set in attribute table only, so it can be read. Change is reported to peer
+ *          as BLE_ECGS_RECORD_LEAD_OFF stream record.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom custom service structure.
+ * @param [in]  leadOff         - Lead-off status, BSP_ECG_ADS1192_LOFF_x bits.
+ * @return NRF error code.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint32_t BLE_ECGS_leadOffUpdate(BLE_ECGS_custom_S *customService, uint8_t leadOff) {
+
+    ble_gatts_value_t gatts_value;
+
+    memset(&gatts_value, 0, sizeof(gatts_value));
+
+    gatts_value.len     = BLE_ECGS_LEAD_OFF_BYTE_SIZE;
+    gatts_value.offset  = 0u;
+    gatts_value.p_value = &leadOff;
+
+    return sd_ble_gatts_value_set(BLE_CONN_HANDLE_INVALID,
+            customService->lead_off_handles.value_handle,
+            &gatts_value);
+}
+
+/***********************************************************************************************//**
+ * @brief Function returns number of notifications that can be queued to SoftDevice right now.
+ * @details Every queued notification takes one credit, BLE_EVT_TX_COMPLETE returns as many
+ *          credits as packets were transmitted. Called from main context.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom custom service structure.
+ * @return Number of free SoftDevice TX buffers, 0 if not in a connection.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint8_t BLE_ECGS_txCreditsGet(const BLE_ECGS_custom_S *customService) {
+
+    uint8_t inFlight = (uint8_t) (customService->tx_queued - customService->tx_completed);
+    uint8_t credits = 0u;
+
+    if(inFlight < customService->tx_buffer_count) {
+        credits = customService->tx_buffer_count - inFlight;
+    }
+
+    return credits;
+}
+
+/***********************************************************************************************//**
+ * @brief Function responds to control point request with indication.
+ * @details Has to be called exactly once for every BLE_ECGS_EVT_CONTROL_POINT_REQUEST event, next
+ *          request is rejected with ATT error until response is confirmed by peer. Can be called from
+ *          main context after request was processed.
+ *
+ *          Response layout:
+ *          - byte 0: BLE_ECGS_CP_RESPONSE_OPCODE.
+ *          - byte 1: request opcode.
+ *          - byte 2: result (BLE_ECGS_cpResult_E).
+ *          - byte 3..: response data.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom custom service structure.
+ * @param [in]  opcode          - Opcode of request responded to.
+ * @param [in]  result          - Result of request.
+ * @param [in]  data            - Pointer to response data, may be NULL if size is 0.
+ * @param [in]  size            - Response data size, up to BLE_ECGS_CP_MAX_RESPONSE_DATA.
+ * @return NRF error code.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint32_t BLE_ECGS_controlPointRespond(BLE_ECGS_custom_S *customService,
+        uint8_t opcode,
+        BLE_ECGS_cpResult_E result,
+        const uint8_t *data,
+        uint8_t size) {
+
+    uint32_t err_code = NRF_ERROR_INVALID_STATE;
+    uint8_t response[BLE_ECGS_CP_MAX_SIZE];
+    uint16_t len = BLE_ECGS_CP_RESPONSE_HEADER_SIZE + size;
     ble_gatts_hvx_params_t hvx_params;
-    uint32_t err_code = NRF_SUCCESS;
-    uint16_t len = NRF51_MUHA_MPU9150_BLE_BYTE_SIZE;
 
-    // send value if connected and peer enabled notifications for MPU characteristic
-    if((customService->conn_handle != BLE_CONN_HANDLE_INVALID) &&
-            (muhaMpuNotificationEnabled == true)) {
+    if(size > BLE_ECGS_CP_MAX_RESPONSE_DATA) {
+        err_code = NRF_ERROR_DATA_SIZE;
+    } else if(customService->conn_handle != BLE_CONN_HANDLE_INVALID) {
+        response[0] = BLE_ECGS_CP_RESPONSE_OPCODE;
+        response[1] = opcode;
+        response[2] = (uint8_t) result;
+        if(size != 0u) {
+            memcpy(&response[BLE_ECGS_CP_RESPONSE_HEADER_SIZE], data, size);
+        }
 
-        hvx_params.handle = customService->mpu_handles.value_handle;
-        hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+        memset(&hvx_params, 0, sizeof(hvx_params));
+
+        hvx_params.handle = customService->control_point_handles.value_handle;
+        hvx_params.type   = BLE_GATT_HVX_INDICATION;
         hvx_params.offset = 0u;
         hvx_params.p_len  = &len;
-        hvx_params.p_data = mpuData;
+        hvx_params.p_data = &response[0];
 
+        // indications do not take SoftDevice TX buffers, so no TX credit is used
         err_code = sd_ble_gatts_hvx(customService->conn_handle, &hvx_params);
-    } else {
-        err_code = NRF_ERROR_INVALID_STATE;
+    }
+
+    // there is no confirmation to wait for, next request can be accepted
+    if(err_code != NRF_SUCCESS) {
+        customService->control_point_busy = false;
     }
 
     return err_code;
@@ -228,7 +455,7 @@ uint32_t BLE_ECGS_mpuDataUpdate(BLE_ECGS_custom_S *customService, uint8_t *mpuDa
  *                         PRIVATE FUNCTION DEFINITIONS
  **************************************************************************************************/
 /***********************************************************************************************//**
- * @brief Function for adding the ECG data characteristic.
+ * @brief Function for adding the sensor data stream characteristic.
  ***************************************************************************************************
  * @param [in]  customService   - Pointer to custom custom service structure.
  * @param [in]  customInit      - Pointer to initialization custom service structure.
@@ -237,7 +464,7 @@ uint32_t BLE_ECGS_mpuDataUpdate(BLE_ECGS_custom_S *customService, uint8_t *mpuDa
  * @author  mario.kodba
  * @date    16.04.2021.
  **************************************************************************************************/
-static void BLE_ECGS_ecgDataCharAdd(BLE_ECGS_custom_S *customService,
+static void BLE_ECGS_streamCharAdd(BLE_ECGS_custom_S *customService,
         const BLE_ECGS_customInit_S *customInit,
         BLE_ECGS_err_E *err) {
 
@@ -270,32 +497,32 @@ static void BLE_ECGS_ecgDataCharAdd(BLE_ECGS_custom_S *customService,
 
     memset(&attr_md, 0, sizeof(attr_md));
 
-    attr_md.read_perm  = customInit->custom_value_char_attr_md.read_perm;
-    attr_md.write_perm = customInit->custom_value_char_attr_md.write_perm;
+    attr_md.read_perm  = customInit->stream_char_attr_md.read_perm;
+    attr_md.write_perm = customInit->stream_char_attr_md.write_perm;
     attr_md.vloc       = BLE_GATTS_VLOC_STACK;
     attr_md.rd_auth    = 0;
     attr_md.wr_auth    = 0;
-    // variable length
-    attr_md.vlen       = 0;
+    // variable length, last notification before idle link may be partially filled
+    attr_md.vlen       = 1;
 
     ble_uuid.type = customService->uuid_type;
-    ble_uuid.uuid = ECG_VALUE_CHAR_UUID;
+    ble_uuid.uuid = STREAM_CHAR_UUID;
 
     memset(&attr_char_value, 0, sizeof(attr_char_value));
 
     attr_char_value.p_uuid    = &ble_uuid;
     attr_char_value.p_attr_md = &attr_md;
     // sets initial length (in bytes) of characteristic data
-    attr_char_value.init_len  = NRF51_MUHA_ADS1192_BLE_BYTE_SIZE;
+    attr_char_value.init_len  = BLE_ECGS_STREAM_HEADER_SIZE;
     attr_char_value.init_offs = 0;
     // sets max length (in bytes) of characteristic data
-    attr_char_value.max_len   = NRF51_MUHA_ADS1192_BLE_BYTE_SIZE;
+    attr_char_value.max_len   = BLE_ECGS_STREAM_PACKET_SIZE;
 
     // add new characteristic to SoftDevice
     err_code = sd_ble_gatts_characteristic_add(customService->service_handle,
             &char_md,
             &attr_char_value,
-            &customService->custom_value_handles);
+            &customService->stream_handles);
 
     if (err_code != NRF_SUCCESS) {
        localErr = BLE_ECGS_err_CHARACTERISTIC_INIT_FAIL;
@@ -307,71 +534,205 @@ static void BLE_ECGS_ecgDataCharAdd(BLE_ECGS_custom_S *customService,
 }
 
 /***********************************************************************************************//**
- * @brief Function for adding the ECG MPU data characteristic.
+ * @brief Function for adding the MPU configuration characteristic.
+ * @details Peer writes requested configuration, value is then overwritten with configuration
+ *          actually applied, so it can be read back.
  ***************************************************************************************************
  * @param [in]  customService   - Pointer to custom custom service structure.
  * @param [in]  customInit      - Pointer to initialization custom service structure.
  * @param [out] err             - Pointer to error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    16.04.2021.
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void BLE_ECGS_mpuDataCharAdd(BLE_ECGS_custom_S *customService,
+static void BLE_ECGS_mpuConfigCharAdd(BLE_ECGS_custom_S *customService,
         const BLE_ECGS_customInit_S *customInit,
         BLE_ECGS_err_E *err) {
 
     BLE_ECGS_err_E localErr = BLE_ECGS_err_NONE;
     uint32_t err_code;
     ble_gatts_char_md_t char_md;
-    ble_gatts_attr_md_t cccd_md;
     ble_gatts_attr_t attr_char_value;
     ble_uuid_t ble_uuid;
     ble_gatts_attr_md_t attr_md;
 
-    memset(&cccd_md, 0, sizeof(cccd_md));
+    memset(&char_md, 0, sizeof(char_md));
 
-    // read operation on Cccd should be possible without authentication
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&cccd_md.read_perm);
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&cccd_md.write_perm);
+    char_md.char_props.read   = 1;
+    char_md.char_props.write  = 1;
+    char_md.char_props.notify = 0;
+    char_md.p_char_user_desc  = NULL;
+    char_md.p_char_pf         = NULL;
+    char_md.p_user_desc_md    = NULL;
+    char_md.p_cccd_md         = NULL;
+    char_md.p_sccd_md         = NULL;
+
+    memset(&attr_md, 0, sizeof(attr_md));
+
+    attr_md.read_perm  = customInit->mpu_config_char_attr_md.read_perm;
+    attr_md.write_perm = customInit->mpu_config_char_attr_md.write_perm;
+    attr_md.vloc       = BLE_GATTS_VLOC_STACK;
+    attr_md.rd_auth    = 0;
+    attr_md.wr_auth    = 0;
+    attr_md.vlen       = 0;
+
+    ble_uuid.type = customService->uuid_type;
+    ble_uuid.uuid = MPU_CONFIG_CHAR_UUID;
+
+    memset(&attr_char_value, 0, sizeof(attr_char_value));
+
+    attr_char_value.p_uuid    = &ble_uuid;
+    attr_char_value.p_attr_md = &attr_md;
+    attr_char_value.init_len  = BLE_ECGS_MPU_CONFIG_BYTE_SIZE;
+    attr_char_value.init_offs = 0;
+    attr_char_value.max_len   = BLE_ECGS_MPU_CONFIG_BYTE_SIZE;
+
+    err_code = sd_ble_gatts_characteristic_add(customService->service_handle,
+            &char_md,
+            &attr_char_value,
+            &customService->mpu_config_handles);
+
+    if(err_code != NRF_SUCCESS) {
+       localErr = BLE_ECGS_err_CHARACTERISTIC_INIT_FAIL;
+    }
 
-    cccd_md.vloc = BLE_GATTS_VLOC_STACK;
+    if(err != NULL) {
+        *err = localErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function for adding the ADS1192 lead-off status characteristic.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom custom service structure.
+ * @param [in]  customInit      - Pointer to initialization custom service structure.
+ * @param [out] err             - Pointer to error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BLE_ECGS_leadOffCharAdd(BLE_ECGS_custom_S *customService,
+        const BLE_ECGS_customInit_S *customInit,
+        BLE_ECGS_err_E *err) {
+
+    BLE_ECGS_err_E localErr = BLE_ECGS_err_NONE;
+    uint32_t err_code;
+    ble_gatts_char_md_t char_md;
+    ble_gatts_attr_t attr_char_value;
+    ble_uuid_t ble_uuid;
+    ble_gatts_attr_md_t attr_md;
 
     memset(&char_md, 0, sizeof(char_md));
 
     char_md.char_props.read   = 1;
     char_md.char_props.write  = 0;
-    char_md.char_props.notify = 1;
+    char_md.char_props.notify = 0;
     char_md.p_char_user_desc  = NULL;
     char_md.p_char_pf         = NULL;
     char_md.p_user_desc_md    = NULL;
-    char_md.p_cccd_md         = &cccd_md;
+    char_md.p_cccd_md         = NULL;
     char_md.p_sccd_md         = NULL;
 
     memset(&attr_md, 0, sizeof(attr_md));
 
-    attr_md.read_perm  = customInit->mpu_data_char_attr_md.read_perm;
-    attr_md.write_perm = customInit->mpu_data_char_attr_md.write_perm;
+    attr_md.read_perm  = customInit->lead_off_char_attr_md.read_perm;
+    attr_md.write_perm = customInit->lead_off_char_attr_md.write_perm;
     attr_md.vloc       = BLE_GATTS_VLOC_STACK;
     attr_md.rd_auth    = 0;
     attr_md.wr_auth    = 0;
     attr_md.vlen       = 0;
 
     ble_uuid.type = customService->uuid_type;
-    ble_uuid.uuid = MPU_VALUE_CHAR_UUID;
+    ble_uuid.uuid = LEAD_OFF_CHAR_UUID;
 
     memset(&attr_char_value, 0, sizeof(attr_char_value));
 
     attr_char_value.p_uuid    = &ble_uuid;
     attr_char_value.p_attr_md = &attr_md;
-    attr_char_value.init_len  = NRF51_MUHA_MPU9150_BLE_BYTE_SIZE;
+    attr_char_value.init_len  = BLE_ECGS_LEAD_OFF_BYTE_SIZE;
     attr_char_value.init_offs = 0;
-    // sets max length (in bytes) of characteristic data
-    attr_char_value.max_len   = NRF51_MUHA_MPU9150_BLE_BYTE_SIZE;
+    attr_char_value.max_len   = BLE_ECGS_LEAD_OFF_BYTE_SIZE;
+
+    err_code = sd_ble_gatts_characteristic_add(customService->service_handle,
+            &char_md,
+            &attr_char_value,
+            &customService->lead_off_handles);
+
+    if(err_code != NRF_SUCCESS) {
+       localErr = BLE_ECGS_err_CHARACTERISTIC_INIT_FAIL;
+    }
+
+    if(err != NULL) {
+        *err = localErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function for adding the control point characteristic.
+ * @details Writes are authorized by the service, so request is rejected in write response if peer
+ *          did not enable indications or previous request is still being processed.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom custom service structure.
+ * @param [in]  customInit      - Pointer to initialization custom service structure.
+ * @param [out] err             - Pointer to error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BLE_ECGS_controlPointCharAdd(BLE_ECGS_custom_S *customService,
+        const BLE_ECGS_customInit_S *customInit,
+        BLE_ECGS_err_E *err) {
+
+    BLE_ECGS_err_E localErr = BLE_ECGS_err_NONE;
+    uint32_t err_code;
+    ble_gatts_char_md_t char_md;
+    ble_gatts_attr_md_t cccd_md;
+    ble_gatts_attr_t attr_char_value;
+    ble_uuid_t ble_uuid;
+    ble_gatts_attr_md_t attr_md;
+
+    memset(&cccd_md, 0, sizeof(cccd_md));
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&cccd_md.read_perm);
+    cccd_md.write_perm = customInit->control_point_char_attr_md.cccd_write_perm;
+    cccd_md.vloc       = BLE_GATTS_VLOC_STACK;
+
+    memset(&char_md, 0, sizeof(char_md));
+
+    char_md.char_props.read     = 0;
+    char_md.char_props.write    = 1;
+    char_md.char_props.indicate = 1;
+    char_md.p_char_user_desc    = NULL;
+    char_md.p_char_pf           = NULL;
+    char_md.p_user_desc_md      = NULL;
+    char_md.p_cccd_md           = &cccd_md;
+    char_md.p_sccd_md           = NULL;
+
+    memset(&attr_md, 0, sizeof(attr_md));
+
+    attr_md.read_perm  = customInit->control_point_char_attr_md.read_perm;
+    attr_md.write_perm = customInit->control_point_char_attr_md.write_perm;
+    attr_md.vloc       = BLE_GATTS_VLOC_STACK;
+    attr_md.rd_auth    = 0;
+    attr_md.wr_auth    = 1;
+    // variable length, size of request depends on opcode
+    attr_md.vlen       = 1;
+
+    ble_uuid.type = customService->uuid_type;
+    ble_uuid.uuid = CONTROL_POINT_CHAR_UUID;
+
+    memset(&attr_char_value, 0, sizeof(attr_char_value));
+
+    attr_char_value.p_uuid    = &ble_uuid;
+    attr_char_value.p_attr_md = &attr_md;
+    attr_char_value.init_len  = 0;
+    attr_char_value.init_offs = 0;
+    attr_char_value.max_len   = BLE_ECGS_CP_MAX_SIZE;
 
     err_code = sd_ble_gatts_characteristic_add(customService->service_handle,
             &char_md,
             &attr_char_value,
-            &customService->mpu_handles);
+            &customService->control_point_handles);
 
     if(err_code != NRF_SUCCESS) {
        localErr = BLE_ECGS_err_CHARACTERISTIC_INIT_FAIL;
@@ -395,7 +756,25 @@ static void BLE_ECGS_onConnect(BLE_ECGS_custom_S *customService, const ble_evt_t
 
     BLE_ECGS_evt_S evt;
 
+    uint8_t txBufferCount = 0u;
+
     customService->conn_handle = ble_evt->evt.gap_evt.conn_handle;
+
+    // all TX buffers are free on new connection, at least one is always available
+    if((sd_ble_tx_packet_count_get(customService->conn_handle, &txBufferCount) != NRF_SUCCESS) ||
+            (txBufferCount == 0u)) {
+        txBufferCount = 1u;
+    }
+
+    customService->tx_completed = customService->tx_queued;
+    customService->tx_buffer_count = txBufferCount;
+    // bytes left from previous connection would continue a record peer never saw start of
+    customService->stream_sequence = 0u;
+    customService->stream_length = 0u;
+    customService->stream_record_offset = 0u;
+    customService->control_point_indication_enabled = false;
+    customService->control_point_busy = false;
+
     evt.evt_type = BLE_ECGS_EVT_CONNECTED;
 
     customService->evt_handler(customService, &evt);
@@ -415,11 +794,31 @@ static void BLE_ECGS_onDisconnect(BLE_ECGS_custom_S *customService, const ble_ev
     BLE_ECGS_evt_S evt;
 
     customService->conn_handle = BLE_CONN_HANDLE_INVALID;
+    customService->tx_buffer_count = 0u;
+    customService->control_point_busy = false;
     evt.evt_type = BLE_ECGS_EVT_DISCONNECTED;
 
     customService->evt_handler(customService, &evt);
 }
 
+/***********************************************************************************************//**
+ * @brief Function for handling the BLE TX Complete event.
+ * @details Credits are already returned, application is notified so it can queue more stream data.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom service structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BLE_ECGS_onTxComplete(BLE_ECGS_custom_S *customService) {
+
+    BLE_ECGS_evt_S evt;
+
+    evt.evt_type = BLE_ECGS_EVT_TX_READY;
+
+    customService->evt_handler(customService, &evt);
+}
+
 /***********************************************************************************************//**
  * @brief Function for handling the BLE Write event.
  ***************************************************************************************************
@@ -433,42 +832,243 @@ static void BLE_ECGS_onWrite(BLE_ECGS_custom_S *customService, ble_evt_t *ble_ev
 
     ble_gatts_evt_write_t *p_evt_write = &ble_evt->evt.gatts_evt.params.write;
 
-    // if it has been written to MPU CCCD characteristic handle
-    if(p_evt_write->handle == customService->mpu_handles.cccd_handle){
+    // if it has been written to stream CCCD characteristic handle
+    if(p_evt_write->handle == customService->stream_handles.cccd_handle) {
         if(p_evt_write->len == BLE_ECGS_ON_WRITE_NOTIFICATION_BYTE_SIZE) {
             // CCCD written, update notification state
             BLE_ECGS_evt_S evt;
             bool isNotificationEnabled = (p_evt_write->data[0] & BLE_GATT_HVX_NOTIFICATION);
 
             if(isNotificationEnabled == true) {
-                evt.evt_type = BLE_ECGS_EVT_MPU_NOTIFICATION_ENABLED;
+                evt.evt_type = BLE_ECGS_EVT_STREAM_NOTIFICATION_ENABLED;
             } else {
-                evt.evt_type = BLE_ECGS_EVT_MPU_NOTIFICATION_DISABLED;
+                evt.evt_type = BLE_ECGS_EVT_STREAM_NOTIFICATION_DISABLED;
             }
 
             customService->evt_handler(customService, &evt);
         }
     }
-    // if it has been written to ECG CCCD characteristic handle
-    else if(p_evt_write->handle == customService->custom_value_handles.cccd_handle) {
-        if(p_evt_write->len == BLE_ECGS_ON_WRITE_NOTIFICATION_BYTE_SIZE) {
-            // CCCD written, update notification state
+    // if it has been written to MPU configuration characteristic handle
+    else if(p_evt_write->handle == customService->mpu_config_handles.value_handle) {
+        if(p_evt_write->len == BLE_ECGS_MPU_CONFIG_BYTE_SIZE) {
             BLE_ECGS_evt_S evt;
-            bool isNotificationEnabled = (p_evt_write->data[0] & BLE_GATT_HVX_NOTIFICATION);
 
-            if(isNotificationEnabled == true) {
-                evt.evt_type = BLE_ECGS_EVT_ECG_NOTIFICATION_ENABLED;
-            } else {
-                evt.evt_type = BLE_ECGS_EVT_ECG_NOTIFICATION_DISABLED;
-            }
+            evt.evt_type = BLE_ECGS_EVT_MPU_CONFIG_WRITTEN;
+            BLE_ECGS_mpuConfigDecode(&p_evt_write->data[0], &evt.mpuConfig);
 
             customService->evt_handler(customService, &evt);
         }
+    }
+    // if it has been written to control point CCCD characteristic handle
+    else if(p_evt_write->handle == customService->control_point_handles.cccd_handle) {
+        if(p_evt_write->len == BLE_ECGS_ON_WRITE_NOTIFICATION_BYTE_SIZE) {
+            customService->control_point_indication_enabled = ((p_evt_write->data[0] & BLE_GATT_HVX_INDICATION) != 0u);
+        }
     } else {
         ;
     }
 }
 
+/***********************************************************************************************//**
+ * @brief Function for handling the BLE Read/Write authorization request event.
+ * @details Only control point writes are authorized. Accepted request is stored to attribute value
+ *          and handed over to the application.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom service structure.
+ * @param [in]  ble_evt         - Pointer to BLE event received from BLE stack.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BLE_ECGS_onAuthorizeRequest(BLE_ECGS_custom_S *customService, ble_evt_t *ble_evt) {
+
+    ble_gatts_evt_rw_authorize_request_t *p_auth_req = &ble_evt->evt.gatts_evt.params.authorize_request;
+    ble_gatts_evt_write_t *p_evt_write = &p_auth_req->request.write;
+    ble_gatts_rw_authorize_reply_params_t auth_reply;
+    bool isAccepted = false;
+
+    if((p_auth_req->type == BLE_GATTS_AUTHORIZE_TYPE_WRITE) &&
+            (p_evt_write->op == BLE_GATTS_OP_WRITE_REQ) &&
+            (p_evt_write->handle == customService->control_point_handles.value_handle)) {
+
+        memset(&auth_reply, 0, sizeof(auth_reply));
+        auth_reply.type = BLE_GATTS_AUTHORIZE_TYPE_WRITE;
+
+        // request that could not be responded to is rejected in write response already
+        if(customService->control_point_indication_enabled == false) {
+            auth_reply.params.write.gatt_status = BLE_GATT_STATUS_ATTERR_CPS_CCCD_CONFIG_ERROR;
+        } else if(customService->control_point_busy == true) {
+            auth_reply.params.write.gatt_status = BLE_GATT_STATUS_ATTERR_CPS_PROC_ALR_IN_PROG;
+        } else if(p_evt_write->len == 0u) {
+            auth_reply.params.write.gatt_status = BLE_GATT_STATUS_ATTERR_INVALID_ATT_VAL_LENGTH;
+        } else {
+            auth_reply.params.write.gatt_status = BLE_GATT_STATUS_SUCCESS;
+            auth_reply.params.write.update = 1;
+            auth_reply.params.write.offset = 0u;
+            auth_reply.params.write.len = p_evt_write->len;
+            auth_reply.params.write.p_data = &p_evt_write->data[0];
+
+            customService->control_point_busy = true;
+            isAccepted = true;
+        }
+
+        (void) sd_ble_gatts_rw_authorize_reply(customService->conn_handle, &auth_reply);
+
+        if(isAccepted == true) {
+            BLE_ECGS_onControlPointRequest(customService, &p_evt_write->data[0], p_evt_write->len);
+        }
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function checks control point request against opcode table and hands it to application.
+ * @details Unknown opcode and wrong parameter size are responded to right here.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom service structure.
+ * @param [in]  data            - Pointer to request, opcode followed by parameters.
+ * @param [in]  len             - Request size, at least 1.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BLE_ECGS_onControlPointRequest(BLE_ECGS_custom_S *customService, const uint8_t *data, uint16_t len) {
+
+    BLE_ECGS_evt_S evt;
+    uint8_t opcode = data[0];
+    uint8_t paramSize = (uint8_t) (len - 1u);
+
+    if((opcode == 0u) || (opcode >= BLE_ECGS_CP_OP_COUNT)) {
+        (void) BLE_ECGS_controlPointRespond(customService, opcode, BLE_ECGS_CP_RESULT_NOT_SUPPORTED, NULL, 0u);
+    } else if(paramSize != ecgsCpParamSize[opcode]) {
+        (void) BLE_ECGS_controlPointRespond(customService, opcode, BLE_ECGS_CP_RESULT_INVALID_PARAM, NULL, 0u);
+    } else {
+        memset(&evt, 0, sizeof(evt));
+        evt.evt_type = BLE_ECGS_EVT_CONTROL_POINT_REQUEST;
+        evt.controlPoint.opcode = opcode;
+        evt.controlPoint.paramSize = paramSize;
+        memcpy(&evt.controlPoint.params[0], &data[1], paramSize);
+
+        if(opcode == BLE_ECGS_CP_OP_SET_MPU_CONFIG) {
+            BLE_ECGS_mpuConfigDecode(&evt.controlPoint.params[0], &evt.mpuConfig);
+        }
+
+        customService->evt_handler(customService, &evt);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function decodes MPU configuration, as written to MPU configuration characteristic.
+ ***************************************************************************************************
+ * @param [in]  data            - Pointer to BLE_ECGS_MPU_CONFIG_BYTE_SIZE bytes of configuration.
+ * @param [out] mpuConfig       - Pointer to decoded MPU configuration.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BLE_ECGS_mpuConfigDecode(const uint8_t *data, BLE_ECGS_mpuConfig_S *mpuConfig) {
+
+    mpuConfig->sampleRateHz = uint16_decode(&data[0]);
+    mpuConfig->dlpf = data[2];
+    mpuConfig->gyroRange = data[3];
+    mpuConfig->accRange = data[4];
+}
+
+/***********************************************************************************************//**
+ * @brief Function sends notification and takes TX credit for it.
+ * @details On BLE_ERROR_NO_TX_PACKETS all SoftDevice TX buffers are in flight, so credit count is
+ *          resynchronized to it. Completed count is read before notification is queued, so
+ *          BLE_EVT_TX_COMPLETE received in the meantime is not lost.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom custom service structure.
+ * @param [in]  valueHandle     - Handle of characteristic value to be notified.
+ * @param [in]  data            - Pointer to data to be sent.
+ * @param [in]  len             - Number of bytes to be sent.
+ * @return NRF error code.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint32_t BLE_ECGS_notify(BLE_ECGS_custom_S *customService,
+        uint16_t valueHandle,
+        uint8_t *data,
+        uint16_t len) {
+
+    uint32_t err_code = NRF_ERROR_INVALID_STATE;
+    uint8_t completed = customService->tx_completed;
+    ble_gatts_hvx_params_t hvx_params;
+
+    if(customService->conn_handle != BLE_CONN_HANDLE_INVALID) {
+
+        hvx_params.handle = valueHandle;
+        hvx_params.type   = BLE_GATT_HVX_NOTIFICATION;
+        hvx_params.offset = 0u;
+        hvx_params.p_len  = &len;
+        hvx_params.p_data = data;
+
+        err_code = sd_ble_gatts_hvx(customService->conn_handle, &hvx_params);
+
+        if(err_code == NRF_SUCCESS) {
+            customService->tx_queued++;
+        } else if(err_code == BLE_ERROR_NO_TX_PACKETS) {
+            customService->tx_queued = completed + customService->tx_buffer_count;
+        }
+    }
+
+    return err_code;
+}
+
+/***********************************************************************************************//**
+ * @brief Function sends first stream bytes as one notification.
+ * @details Sequence number advances for every notification which is not sent again, so receiver can
+ *          tell dropped stream bytes from continuous stream. After a gap receiver resumes parsing at
+ *          first record starting in notification.
+ *
+ *          Notification header:
+ *          - byte 0: version (bits 7..6), offset of first record starting in payload (bits 5..0),
+ *            BLE_ECGS_STREAM_NO_RECORD if payload only continues earlier record.
+ *          - byte 1: sequence number.
+ ***************************************************************************************************
+ * @param [in]  customService   - Pointer to custom custom service structure.
+ * @param [in]  size            - Number of stream bytes to send, up to BLE_ECGS_STREAM_PAYLOAD_SIZE.
+ * @return NRF error code.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint32_t BLE_ECGS_streamSend(BLE_ECGS_custom_S *customService, uint8_t size) {
+
+    uint32_t err_code = NRF_SUCCESS;
+    uint8_t packet[BLE_ECGS_STREAM_PACKET_SIZE];
+    uint8_t recordOffset = customService->stream_record_offset;
+
+    packet[0] = (uint8_t) ((BLE_ECGS_STREAM_VERSION << BLE_ECGS_STREAM_VERSION_SHIFT) |
+            ((recordOffset < size) ? recordOffset : BLE_ECGS_STREAM_NO_RECORD));
+    packet[1] = customService->stream_sequence;
+    memcpy(&packet[BLE_ECGS_STREAM_HEADER_SIZE], &customService->stream_buffer[0], size);
+
+    err_code = BLE_ECGS_notify(customService,
+            customService->stream_handles.value_handle,
+            &packet[0],
+            BLE_ECGS_STREAM_HEADER_SIZE + size);
+
+    // bytes that were not sent stay in buffer, NRF_ERROR_INVALID_STATE means notifications are off
+    if((err_code != BLE_ERROR_NO_TX_PACKETS) && (err_code != NRF_ERROR_INVALID_STATE)) {
+        // records are queued whole, so length of every record starting in sent bytes is in buffer
+        while(recordOffset < size) {
+            recordOffset += BLE_ECGS_RECORD_TL_SIZE + customService->stream_buffer[recordOffset + 1u];
+        }
+
+        customService->stream_record_offset = recordOffset - size;
+        customService->stream_length -= size;
+        memmove(&customService->stream_buffer[0],
+                &customService->stream_buffer[size],
+                customService->stream_length);
+        customService->stream_sequence++;
+    }
+
+    return err_code;
+}
+
 /***************************************************************************************************
  *                          END OF FILE
  **************************************************************************************************/
@@ -37,8 +37,62 @@
 
 #define ECG_SERVICE_UUID                (0x1400)    //!< ECG service UUID
 
-#define ECG_VALUE_CHAR_UUID             (0x1401)    //!< ECG value characteristic UUID
-#define MPU_VALUE_CHAR_UUID             (0x1402)    //!< MPU9150 value characteristic UUID
+#define MPU_CONFIG_CHAR_UUID            (0x1403)    //!< MPU9150 configuration characteristic UUID
+#define LEAD_OFF_CHAR_UUID              (0x1404)    //!< ADS1192 lead-off status characteristic UUID
+#define STREAM_CHAR_UUID                (0x1405)    //!< Sensor data stream characteristic UUID
+#define CONTROL_POINT_CHAR_UUID         (0x1406)    //!< Control point characteristic UUID
+
+//! MPU9150 configuration characteristic size - sample rate (uint16, LSB first), DLPF, gyroscope and accelerometer range
+#define BLE_ECGS_MPU_CONFIG_BYTE_SIZE   (5u)
+//! Lead-off status characteristic size - BSP_ECG_ADS1192_LOFF_x bits
+#define BLE_ECGS_LEAD_OFF_BYTE_SIZE     (1u)
+
+//! Max size of stream notification, default ATT MTU
+#define BLE_ECGS_STREAM_PACKET_SIZE     (20u)
+//! Size of stream notification header - version and first record offset, sequence
+#define BLE_ECGS_STREAM_HEADER_SIZE     (2u)
+//! Number of stream bytes carried by one notification
+#define BLE_ECGS_STREAM_PAYLOAD_SIZE    (BLE_ECGS_STREAM_PACKET_SIZE - BLE_ECGS_STREAM_HEADER_SIZE)
+//! Number of stream bytes waiting for notification, holds at least one record of max size
+#define BLE_ECGS_STREAM_BUFFER_SIZE     (64u)
+#define BLE_ECGS_STREAM_VERSION         (1u)        //!< Stream format version
+#define BLE_ECGS_STREAM_VERSION_SHIFT   (6u)        //!< Position of version in notification byte 0
+#define BLE_ECGS_STREAM_OFFSET_MASK     (0x3Fu)     //!< First record offset mask in notification byte 0
+#define BLE_ECGS_STREAM_NO_RECORD       (0x3Fu)     //!< First record offset if no record starts in notification
+
+//! Size of record type and length fields
+#define BLE_ECGS_RECORD_TL_SIZE         (2u)
+//! Size of record header - type and flags, length, sample count, timestamp
+#define BLE_ECGS_RECORD_HEADER_SIZE     (5u)
+//! Max size of record payload, record may span more notifications
+#define BLE_ECGS_RECORD_MAX_PAYLOAD     (32u)
+#define BLE_ECGS_RECORD_TYPE_SHIFT      (4u)        //!< Position of record type in record byte 0
+#define BLE_ECGS_RECORD_FLAGS_MASK      (0x0Fu)     //!< Flags mask in record byte 0
+
+#if ((BLE_ECGS_RECORD_HEADER_SIZE + BLE_ECGS_RECORD_MAX_PAYLOAD + BLE_ECGS_STREAM_PAYLOAD_SIZE) > \
+        BLE_ECGS_STREAM_BUFFER_SIZE)
+#error "Stream buffer has to hold record of max size on top of partially sent notification"
+#endif
+
+#define BLE_ECGS_FLAG_LEAD_OFF          (0x01u)     //!< At least one ADS1192 electrode is off
+#define BLE_ECGS_FLAG_CODEC             (0x02u)     //!< Payload is compressed with ECG codec
+#define BLE_ECGS_FLAG_KEYFRAME          (0x04u)     //!< Compressed payload is keyframe
+
+//! Mask of all stream record types, one bit per type (1 << BLE_ECGS_RECORD_x)
+#define BLE_ECGS_RECORD_ALL_MASK        ((1u << BLE_ECGS_RECORD_COUNT) - 1u)
+
+//! Max size of control point request and response, default ATT MTU
+#define BLE_ECGS_CP_MAX_SIZE            (20u)
+//! Max size of control point request parameters, following opcode
+#define BLE_ECGS_CP_MAX_PARAM_SIZE      (BLE_ECGS_CP_MAX_SIZE - 1u)
+//! Size of control point response header - response opcode, request opcode, result
+#define BLE_ECGS_CP_RESPONSE_HEADER_SIZE (3u)
+//! Max size of control point response data, following response header
+#define BLE_ECGS_CP_MAX_RESPONSE_DATA   (BLE_ECGS_CP_MAX_SIZE - BLE_ECGS_CP_RESPONSE_HEADER_SIZE)
+#define BLE_ECGS_CP_RESPONSE_OPCODE     (0x80u)     //!< Opcode of control point response
+#define BLE_ECGS_CP_VERSION             (1u)        //!< Control point protocol version, reported in capabilities
+//! Size of capabilities response data, see BLE_ECGS_CP_OP_GET_CAPABILITIES
+#define BLE_ECGS_CP_CAPABILITIES_SIZE   (11u)
 
 /***************************************************************************************************
  *                              ENUMERATIONS
@@ -54,24 +108,101 @@ typedef enum BLE_ECGS_err_ENUM {
     BLE_ECGS_err_COUNT                      //!< BLE Custom service total error count.
 } BLE_ECGS_err_E;
 
+//! Enum for types of records carried by sensor data stream, up to 16 types
+typedef enum BLE_ECGS_recordType_ENUM {
+    BLE_ECGS_RECORD_ECG = 0u,               //!< ADS1192 samples.
+    BLE_ECGS_RECORD_MPU,                    //!< MPU9150 samples or orientation.
+    BLE_ECGS_RECORD_LEAD_OFF,               //!< ADS1192 lead-off status change, BSP_ECG_ADS1192_LOFF_x bits.
+
+    BLE_ECGS_RECORD_COUNT                   //!< Total number of record types.
+} BLE_ECGS_recordType_E;
+
 //! Enum for types of events service can generate.
 typedef enum BLE_ECGS_evtType_ENUM {
     BLE_ECGS_EVT_DISCONNECTED,              //!< Custom service disconnected event.
     BLE_ECGS_EVT_CONNECTED,                 //!< Custom service connected event.
-    BLE_ECGS_EVT_ECG_NOTIFICATION_ENABLED,  //!< ECG data characteristic notification enabled event.
-    BLE_ECGS_EVT_ECG_NOTIFICATION_DISABLED, //!< ECG data characteristic notification disabled event.
-    BLE_ECGS_EVT_MPU_NOTIFICATION_ENABLED,  //!< MPU data characteristic notification enabled event.
-    BLE_ECGS_EVT_MPU_NOTIFICATION_DISABLED  //!< MPU data characteristic notification disabled event.
+    BLE_ECGS_EVT_STREAM_NOTIFICATION_ENABLED,  //!< Stream characteristic notification enabled event.
+    BLE_ECGS_EVT_STREAM_NOTIFICATION_DISABLED, //!< Stream characteristic notification disabled event.
+    BLE_ECGS_EVT_MPU_CONFIG_WRITTEN,        //!< MPU configuration characteristic written by peer event.
+    BLE_ECGS_EVT_CONTROL_POINT_REQUEST,     //!< Control point request written by peer event, has to be responded to.
+    BLE_ECGS_EVT_TX_READY                   //!< SoftDevice TX buffers freed, more notifications can be sent.
 } BLE_ECGS_evtType_E;
 
+/**
+ * Enum for control point request opcodes, multi-byte parameters are LSB first. Every request is
+ * responded to with indication - BLE_ECGS_CP_RESPONSE_OPCODE, request opcode, BLE_ECGS_cpResult_E
+ * and response data. Next request is accepted once response is confirmed by peer.
+ */
+typedef enum BLE_ECGS_cpOpcode_ENUM {
+    BLE_ECGS_CP_OP_START_STREAMS    = 0x01u,    //!< Enable stream record types - record type mask (1 << BLE_ECGS_RECORD_x).
+    BLE_ECGS_CP_OP_STOP_STREAMS     = 0x02u,    //!< Disable stream record types - record type mask (1 << BLE_ECGS_RECORD_x).
+    BLE_ECGS_CP_OP_SET_ECG_CONFIG   = 0x03u,    //!< Set ADS1192 conversion rate (BSP_ECG_ADS1192_convRate_E) and PGA gain (BSP_ECG_ADS1192_pga_E).
+    BLE_ECGS_CP_OP_SET_MPU_CONFIG   = 0x04u,    //!< Set MPU9150 configuration - same layout as MPU configuration characteristic.
+    BLE_ECGS_CP_OP_SELECT_CODEC     = 0x05u,    //!< Select ECG record encoding (BLE_ECGS_codec_E).
+    BLE_ECGS_CP_OP_SET_CONN_PARAMS  = 0x06u,    //!< Request min and max connection interval (1.25 ms units), slave latency and supervision timeout (10 ms units), uint16 each.
+    /**
+     * Query capabilities and current configuration, no parameters. Response data:
+     * - byte 0: BLE_ECGS_CP_VERSION.
+     * - byte 1..2: supported and enabled stream record types masks.
+     * - byte 3: number of ADS1192 channels in ECG record.
+     * - byte 4: supported ADS1192 conversion rates mask (1 << BSP_ECG_ADS1192_convRate_E).
+     * - byte 5..6: ADS1192 conversion rate and PGA gain in use.
+     * - byte 7..8: ECG record sample rate in Hz.
+     * - byte 9..10: supported ECG record encodings mask (1 << BLE_ECGS_codec_E) and encoding in use.
+     */
+    BLE_ECGS_CP_OP_GET_CAPABILITIES = 0x07u,
+
+    BLE_ECGS_CP_OP_COUNT                        //!< Opcodes are below this value.
+} BLE_ECGS_cpOpcode_E;
+
+//! Enum for control point response result codes
+typedef enum BLE_ECGS_cpResult_ENUM {
+    BLE_ECGS_CP_RESULT_SUCCESS          = 0x01u,    //!< Request applied.
+    BLE_ECGS_CP_RESULT_NOT_SUPPORTED    = 0x02u,    //!< Opcode or requested option not supported by this firmware.
+    BLE_ECGS_CP_RESULT_INVALID_PARAM    = 0x03u,    //!< Parameter size or value out of range.
+    BLE_ECGS_CP_RESULT_FAILED           = 0x04u     //!< Request could not be applied right now.
+} BLE_ECGS_cpResult_E;
+
+//! Enum for encodings of ECG record payload
+typedef enum BLE_ECGS_codec_ENUM {
+    BLE_ECGS_CODEC_RAW = 0u,                //!< Uncompressed channel values.
+    BLE_ECGS_CODEC_ECG,                     //!< Compressed with ECG codec, BLE_ECGS_FLAG_CODEC is set.
+
+    BLE_ECGS_CODEC_COUNT                    //!< Total number of encodings.
+} BLE_ECGS_codec_E;
+
 /***************************************************************************************************
  *                              DATA STRUCTURES
  **************************************************************************************************/
 typedef struct BLE_ECGS_custom_STRUCT BLE_ECGS_custom_S;
 
+//! MPU9150 configuration, as carried by MPU configuration characteristic
+typedef struct BLE_ECGS_mpuConfig_STRUCT {
+    uint16_t sampleRateHz;              //!< Sample rate in Hz
+    uint8_t dlpf;                       //!< Digital low pass filter setting (BSP_MPU9150_dlpf_E)
+    uint8_t gyroRange;                  //!< Gyroscope full-scale range (BSP_MPU9150_gyroFsRange_E)
+    uint8_t accRange;                   //!< Accelerometer full-scale range (BSP_MPU9150_accFsRange_E)
+} BLE_ECGS_mpuConfig_S;
+
+//! Control point request, as written by peer
+typedef struct BLE_ECGS_cpRequest_STRUCT {
+    uint8_t opcode;                     //!< Request opcode (BLE_ECGS_cpOpcode_E)
+    uint8_t paramSize;                  //!< Number of parameter bytes
+    uint8_t params[BLE_ECGS_CP_MAX_PARAM_SIZE]; //!< Parameters, size checked against opcode table
+} BLE_ECGS_cpRequest_S;
+
+//! Stream record header, record type and length are filled by the service
+typedef struct BLE_ECGS_recordHeader_STRUCT {
+    uint8_t flags;                      //!< BLE_ECGS_FLAG_x bits
+    uint8_t sampleCount;                //!< Number of samples in record
+    uint16_t timestamp;                 //!< TIMER1 value of first sample in record
+} BLE_ECGS_recordHeader_S;
+
 //! Custom service event structure
 typedef struct BLE_ECGS_evt_STRUCT {
     BLE_ECGS_evtType_E evt_type;        //!< Type of event
+    BLE_ECGS_mpuConfig_S mpuConfig;     //!< Requested MPU configuration, valid on BLE_ECGS_EVT_MPU_CONFIG_WRITTEN and BLE_ECGS_CP_OP_SET_MPU_CONFIG request
+    BLE_ECGS_cpRequest_S controlPoint;  //!< Control point request, valid on BLE_ECGS_EVT_CONTROL_POINT_REQUEST
 } BLE_ECGS_evt_S;
 
 //! Custom Service event handler type.
@@ -80,17 +211,30 @@ typedef void (*BLE_ECGS_evtHandler_T) (BLE_ECGS_custom_S *customService, BLE_ECG
 //! Custom Service initialization structure, contains all options and data needed for initialization of the service.
 typedef struct BLE_ECGS_customInit_STRUCT {
     BLE_ECGS_evtHandler_T         evt_handler;                  //!< Event handler to be called for handling events in the Custom Service.
-    ble_srv_cccd_security_mode_t  custom_value_char_attr_md;    //!< Initial security level for Custom characteristics attribute
-    ble_srv_cccd_security_mode_t  mpu_data_char_attr_md;        //!< Initial security level for MPU data characteristics attribute
+    ble_srv_cccd_security_mode_t  stream_char_attr_md;          //!< Initial security level for stream characteristic attribute
+    ble_srv_security_mode_t       mpu_config_char_attr_md;      //!< Initial security level for MPU configuration characteristic attribute
+    ble_srv_security_mode_t       lead_off_char_attr_md;        //!< Initial security level for lead-off status characteristic attribute
+    ble_srv_cccd_security_mode_t  control_point_char_attr_md;   //!< Initial security level for control point characteristic attribute
 } BLE_ECGS_customInit_S;
 
 //! Custom Service structure, contains various status information for the service.
 typedef struct BLE_ECGS_custom_STRUCT {
     BLE_ECGS_evtHandler_T         evt_handler;                  //!< Event handler to be called for handling events in the Custom Service.
     uint16_t                      service_handle;               //!< Handle of Custom Service (as provided by the BLE stack).
-    ble_gatts_char_handles_t      custom_value_handles;         //!< Handles related to the Custom Value characteristic.
-    ble_gatts_char_handles_t      mpu_handles;                  //!< Handles related to the MPU9150 characteristic.
+    ble_gatts_char_handles_t      stream_handles;               //!< Handles related to the sensor data stream characteristic.
+    ble_gatts_char_handles_t      mpu_config_handles;           //!< Handles related to the MPU9150 configuration characteristic.
+    ble_gatts_char_handles_t      lead_off_handles;             //!< Handles related to the ADS1192 lead-off status characteristic.
+    ble_gatts_char_handles_t      control_point_handles;        //!< Handles related to the control point characteristic.
+    bool                          control_point_indication_enabled; //!< Has peer enabled control point indications, written from BLE event handler only.
+    volatile bool                 control_point_busy;           //!< Is control point request being processed or its response not confirmed yet.
     uint16_t                      conn_handle;                  //!< Handle of the current connection (as provided by the BLE stack, is BLE_CONN_HANDLE_INVALID if not in a connection).
+    uint8_t                       tx_buffer_count;              //!< Number of SoftDevice TX buffers available to application on current connection, 0 if not in a connection.
+    uint8_t                       tx_queued;                    //!< Running count of notifications queued to SoftDevice, written from main context only.
+    volatile uint8_t              tx_completed;                 //!< Running count of notifications transmitted, written from BLE event handler only.
+    uint8_t                       stream_sequence;              //!< Sequence number of next stream notification.
+    uint8_t                       stream_length;                //!< Number of stream bytes waiting for notification.
+    uint8_t                       stream_record_offset;         //!< Offset of first record starting in waiting bytes, stream_length if there is none.
+    uint8_t                       stream_buffer[BLE_ECGS_STREAM_BUFFER_SIZE]; //!< Stream bytes waiting for notification.
     uint8_t                       uuid_type;                    //!< Type of UUID
 } BLE_ECGS_custom_S;
 
@@ -99,8 +243,20 @@ typedef struct BLE_ECGS_custom_STRUCT {
  **************************************************************************************************/
 void BLE_ECGS_init(BLE_ECGS_custom_S *customService, const BLE_ECGS_customInit_S *customInit, BLE_ECGS_err_E *err);
 void BLE_ECGS_onBleEvt(ble_evt_t *ble_evt, void *context);
-uint32_t BLE_ECGS_ecgDataUpdate(BLE_ECGS_custom_S *customService, uint8_t *ecgData);
-uint32_t BLE_ECGS_mpuDataUpdate(BLE_ECGS_custom_S *customService, uint8_t *mpuData);
+uint32_t BLE_ECGS_recordWrite(BLE_ECGS_custom_S *customService,
+        BLE_ECGS_recordType_E type,
+        const BLE_ECGS_recordHeader_S *header,
+        const uint8_t *data,
+        uint8_t size);
+uint32_t BLE_ECGS_streamFlush(BLE_ECGS_custom_S *customService);
+uint32_t BLE_ECGS_mpuConfigUpdate(BLE_ECGS_custom_S *customService, const BLE_ECGS_mpuConfig_S *mpuConfig);
+uint32_t BLE_ECGS_leadOffUpdate(BLE_ECGS_custom_S *customService, uint8_t leadOff);
+uint8_t BLE_ECGS_txCreditsGet(const BLE_ECGS_custom_S *customService);
+uint32_t BLE_ECGS_controlPointRespond(BLE_ECGS_custom_S *customService,
+        uint8_t opcode,
+        BLE_ECGS_cpResult_E result,
+        const uint8_t *data,
+        uint8_t size);
 
 #endif // #ifndef BLE_ECGS_H_
 /***************************************************************************************************
@@ -48,9 +48,7 @@
 ble_bas_t m_bas;                                        //!< Structure used to identify the battery service.
 
 volatile uint8_t muhaConnected = false;                          //!< Flag which shows status of BLE connection of MUHA board.
-volatile uint8_t muhaEcgNotificationEnabled = false;             //!< Flag which shows if the device connected to MUHA board has BLE ECG notification enabled.
-volatile uint8_t muhaMpuNotificationEnabled = false;             //!< Flag which shows if the device connected to MUHA board has BLE MPU notification enabled.
-volatile uint8_t muhaBleTxBufferAvailable   = true;              //!< Flag which shows if there is BLE TX buffer available.
+volatile uint8_t muhaStreamNotificationEnabled = false;          //!< Flag which shows if the device connected to MUHA board has BLE sensor data stream notification enabled.
 
 /***************************************************************************************************
  *                          PRIVATE FUNCTION DECLARATIONS
@@ -140,6 +138,55 @@ void BLE_MUHA_bleEventCallback(ble_evt_t *bleEvent) {
     }
 }
 
+/***********************************************************************************************//**
+ * @brief Function changes preferred connection parameters and requests them on current connection.
+ * @details Parameters are checked against Core Specification limits, supervision timeout has to be
+ *          longer than (1 + slave latency) * max connection interval * 2. Central decides on actual
+ *          parameters, so success only means the update was requested.
+ ***************************************************************************************************
+ * @param [in]  *params - pointer to requested connection parameters.
+ * @param [out] *err    - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BLE_MUHA_connParamsUpdate(const ble_gap_conn_params_t *params, ERR_E *err) {
+
+    ERR_E localErr = ERR_NONE;
+    uint32_t nrfErrCode = NRF_SUCCESS;
+
+    if((params == NULL) ||
+            (params->min_conn_interval < BLE_GAP_CP_MIN_CONN_INTVL_MIN) ||
+            (params->max_conn_interval < params->min_conn_interval) ||
+            (params->max_conn_interval > BLE_GAP_CP_MAX_CONN_INTVL_MAX) ||
+            (params->slave_latency > BLE_GAP_CP_SLAVE_LATENCY_MAX) ||
+            (params->conn_sup_timeout < BLE_GAP_CP_CONN_SUP_TIMEOUT_MIN) ||
+            (params->conn_sup_timeout > BLE_GAP_CP_CONN_SUP_TIMEOUT_MAX) ||
+            // timeout in 10 ms units, interval in 1.25 ms units
+            (((uint32_t) params->conn_sup_timeout * 4u) <=
+                    ((1u + params->slave_latency) * (uint32_t) params->max_conn_interval))) {
+        localErr = ERR_BLE_CONN_PARAMS_INVALID;
+    } else {
+        nrfErrCode = sd_ble_gap_ppcp_set(params);
+
+        if(nrfErrCode == NRF_SUCCESS) {
+            gapConnectionParams = *params;
+
+            if(customService.conn_handle != BLE_CONN_HANDLE_INVALID) {
+                nrfErrCode = sd_ble_gap_conn_param_update(customService.conn_handle, params);
+            }
+        }
+
+        if(nrfErrCode != NRF_SUCCESS) {
+            localErr = ERR_BLE_CONN_PARAMS_UPDATE_FAIL;
+        }
+    }
+
+    if(err != NULL) {
+        *err = localErr;
+    }
+}
+
 /***************************************************************************************************
  *                          PRIVATE FUNCTION DEFINITIONS
  **************************************************************************************************/
@@ -264,13 +311,19 @@ static void BLE_MUHA_servicesInit(ERR_E *err) {
     memset(&ecgs_init, 0, sizeof(ecgs_init));
 
     ecgs_init.evt_handler = BLE_MUHA_onEcgsEvent;
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.custom_value_char_attr_md.read_perm);
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.custom_value_char_attr_md.write_perm);
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.custom_value_char_attr_md.cccd_write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.stream_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.stream_char_attr_md.write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.stream_char_attr_md.cccd_write_perm);
+
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.mpu_config_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.mpu_config_char_attr_md.write_perm);
 
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.mpu_data_char_attr_md.read_perm);
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.mpu_data_char_attr_md.write_perm);
-    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.mpu_data_char_attr_md.cccd_write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.lead_off_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_NO_ACCESS(&ecgs_init.lead_off_char_attr_md.write_perm);
+
+    BLE_GAP_CONN_SEC_MODE_SET_NO_ACCESS(&ecgs_init.control_point_char_attr_md.read_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.control_point_char_attr_md.write_perm);
+    BLE_GAP_CONN_SEC_MODE_SET_OPEN(&ecgs_init.control_point_char_attr_md.cccd_write_perm);
 
     if(localErr == ERR_NONE) {
         BLE_ECGS_init(&customService, &ecgs_init, &customServiceErr);
@@ -345,20 +398,24 @@ static void BLE_MUHA_advertisingInit(ERR_E *err) {
 static void BLE_MUHA_onEcgsEvent(BLE_ECGS_custom_S *customService, BLE_ECGS_evt_S *event) {
 
     switch(event->evt_type) {
-        case BLE_ECGS_EVT_ECG_NOTIFICATION_ENABLED:
-            muhaEcgNotificationEnabled = true;
+        case BLE_ECGS_EVT_STREAM_NOTIFICATION_ENABLED:
+            muhaStreamNotificationEnabled = true;
+            break;
+
+        case BLE_ECGS_EVT_STREAM_NOTIFICATION_DISABLED:
+            muhaStreamNotificationEnabled = false;
             break;
 
-        case BLE_ECGS_EVT_ECG_NOTIFICATION_DISABLED:
-            muhaEcgNotificationEnabled = false;
+        case BLE_ECGS_EVT_MPU_CONFIG_WRITTEN:
+            NRF51_MUHA_requestMpuConfig(&event->mpuConfig);
             break;
 
-        case BLE_ECGS_EVT_MPU_NOTIFICATION_ENABLED:
-            muhaMpuNotificationEnabled = true;
+        case BLE_ECGS_EVT_CONTROL_POINT_REQUEST:
+            NRF51_MUHA_requestControl(&event->controlPoint, &event->mpuConfig);
             break;
 
-        case BLE_ECGS_EVT_MPU_NOTIFICATION_DISABLED:
-            muhaMpuNotificationEnabled = false;
+        case BLE_ECGS_EVT_TX_READY:
+            NRF51_MUHA_requestBleTx();
             break;
 
         case BLE_ECGS_EVT_CONNECTED:
@@ -31,9 +31,7 @@
  *                              DATA STRUCTURES
  **************************************************************************************************/
 extern volatile uint8_t muhaConnected;
-extern volatile uint8_t muhaMpuNotificationEnabled;
-extern volatile uint8_t muhaEcgNotificationEnabled;
-extern volatile uint8_t muhaBleTxBufferAvailable;
+extern volatile uint8_t muhaStreamNotificationEnabled;
 
 /***************************************************************************************************
  *                         PUBLIC FUNCTION DECLARATIONS
@@ -41,6 +39,7 @@ extern volatile uint8_t muhaBleTxBufferAvailable;
 void BLE_MUHA_init(ERR_E *error);
 void BLE_MUHA_advertisingStart(ERR_E *err);
 void BLE_MUHA_bleEventCallback(ble_evt_t *bleEvent);
+void BLE_MUHA_connParamsUpdate(const ble_gap_conn_params_t *params, ERR_E *err);
 
 #endif // #ifndef BLE_MUHA_H_
 /***************************************************************************************************
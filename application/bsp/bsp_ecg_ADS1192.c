@@ -59,14 +59,10 @@
 // ECG ADS1192 SPI constants
 #define BSP_ECG_ADS1192_SPI_READ_CMD            (0x20u) //!< SPI read command
 #define BSP_ECG_ADS1192_SPI_WRITE_CMD           (0x40u) //!< SPI write command
-#define BSP_ECG_ADS1192_SPI_SIZE_READ           (2u)    //!< SPI Read command size (bytes)
-#define BSP_ECG_ADS1192_SPI_SIZE_WRITE          (3u)    //!< SPI Write command size (bytes)
+#define BSP_ECG_ADS1192_SPI_SIZE_OPCODE         (2u)    //!< RREG and WREG opcode size (bytes)
 #define BSP_ECG_ADS1192_SPI_SIZE_SINGLE_BYTE    (1u)    //!< Single SPI byte size
-#define BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME   (6u)    //!< Single SPI read - consists of 6 bytes
-#define BSP_ECG_ADS1192_SPI_MSG_MAX_SIZE        (14u)   //!< Maximum SPI message size
-#define BSP_ECG_ADS1192_SPI_SINGLE_REG          (0x00u) //!< Single register read operation
-#define BSP_ECG_ADS1192_SPI_READ_OFFSET         (1u)    //!< SPI read RX offset
-#define BSP_ECG_ADS1192_SPI_REG_VALUE_INDEX     (2u)    //!< SPI register value index
+#define BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME   (BSP_ECG_ADS1192_FRAME_SIZE)    //!< Single SPI read - consists of 6 bytes
+#define BSP_ECG_ADS1192_SPI_MSG_MAX_SIZE        (BSP_ECG_ADS1192_SPI_SIZE_OPCODE + BSP_ECG_ADS1192_reg_COUNT) //!< Maximum SPI message size
 
 
 // ECG ADS1192 Time constants
@@ -77,12 +73,12 @@
 #define BSP_ECG_ADS1192_INIT_WAIT_TIME_9_FMOD   (72u)   //!< 9 fMOD wait time (us)
 #define BSP_ECG_ADS1192_INIT_OSC_WAIT_TIME_US   (32u)   //!< Internal oscillator wait time (us)
 #define BSP_ECG_ADS1192_INIT_WAIT_TIME_1_MS     (1000u) //!< 1ms wait time
-#define BSP_ECG_ADS1192_INIT_WAIT_TIME_200_MS   (200000u) //!< 200ms wait time
-#define BSP_ECG_ADS1192_WAIT_TIME_OFFSETCAL_MS  (310u)  //!< Offset calibration wait time (ms)
 
 // ECG ADS1192 bit manipulation constants
 #define BSP_ECG_ADS1192_LEAD_OFF_MASK           (0x0Fu) //!< Channel 1 and 2 Lead-off detection
 #define BSP_ECG_ADS1192_BYTE_SHIFT              (8u)    //!< Byte shift value
+#define BSP_ECG_ADS1192_STATUS_LOFF_SHIFT       (7u)    //!< Position of LOFF_STAT[4:0] in frame status word
+#define BSP_ECG_ADS1192_STATUS_LOFF_MASK        (0x1Fu) //!< LOFF_STAT[4:0] mask, after shift
 
 // ECG ADS1192 temperature constants
 #define BSP_ECG_ADS1192_TEMP_CONST_1            (168)   //!< Temperature constant 1
@@ -142,35 +138,59 @@ static const uint8_t ecgADS1192RegAddr[BSP_ECG_ADS1192_reg_COUNT] = {
  *                          PRIVATE FUNCTION DECLARATIONS
  **************************************************************************************************/
 static __INLINE void BSP_ECG_ADS1192_convertSignalToSignedVal(const uint8_t *inData,
-        int16_t *outData);
+        BSP_ECG_ADS1192_frame_S *outFrame);
 static void BSP_ECG_ADS1192_sendSpiCommand(BSP_ECG_ADS1192_device_S *inDevice,
         const uint8_t inSpiCmd,
         BSP_ECG_ADS1192_err_E *outErr);
-static void BSP_ECG_ADS1192_writeSingleReg(BSP_ECG_ADS1192_device_S *inDevice,
+static void BSP_ECG_ADS1192_writeRegs(BSP_ECG_ADS1192_device_S *inDevice,
         const BSP_ECG_ADS1192_reg_E inStartReg,
+        const uint8_t inCount,
         const uint8_t *inData,
         BSP_ECG_ADS1192_err_E *outErr);
-static void BSP_ECG_ADS1192_enablePgaCalibration(BSP_ECG_ADS1192_device_S *inDevice,
+static void BSP_ECG_ADS1192_readRegs(BSP_ECG_ADS1192_device_S *inDevice,
+        const BSP_ECG_ADS1192_reg_E inStartReg,
+        const uint8_t inCount,
+        uint8_t *outData,
         BSP_ECG_ADS1192_err_E *outErr);
-static void BSP_ECG_ADS1192_setConversionRate(BSP_ECG_ADS1192_device_S *inDevice,
-        BSP_ECG_ADS1192_convRate_E inSps,
+static __INLINE void BSP_ECG_ADS1192_setReg(BSP_ECG_ADS1192_device_S *inDevice,
+        const BSP_ECG_ADS1192_reg_E inReg,
+        const uint8_t inValue);
+static void BSP_ECG_ADS1192_flushRegs(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr);
+static void BSP_ECG_ADS1192_enablePgaCalibration(BSP_ECG_ADS1192_device_S *inDevice);
+static void BSP_ECG_ADS1192_setConversionRate(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_convRate_E inSps);
 static void BSP_ECG_ADS1192_setNormalElectrodeRead(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr);
 static void BSP_ECG_ADS1192_initReset(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr);
 #if (DEBUG == true)
+static void BSP_ECG_ADS1192_startTemperature(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr);
 static void BSP_ECG_ADS1192_updateTemperature(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr);
-static uint8_t BSP_ECG_ADS1192_readSingleReg(BSP_ECG_ADS1192_device_S *inDevice,
-        const BSP_ECG_ADS1192_reg_E inReg,
+static void BSP_ECG_ADS1192_startSupplyMeasurement(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr);
 static void BSP_ECG_ADS1192_readSupplyMeasurement(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr);
+static void BSP_ECG_ADS1192_startTestSignal(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr);
 static void BSP_ECG_ADS1192_readTestSignal(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr);
+static void BSP_ECG_ADS1192_startLeadOffDetection(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr);
 static void BSP_ECG_ADS1192_detectLeadOff(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr);
+static void BSP_ECG_ADS1192_startRldOffDetection(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr);
 static void BSP_ECG_ADS1192_detectRldOff(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr);
 #endif // #if (DEBUG == true)
@@ -180,6 +200,7 @@ static void BSP_ECG_ADS1192_detectRldOff(BSP_ECG_ADS1192_device_S *inDevice,
  **************************************************************************************************/
 /***********************************************************************************************//**
  * @brief Function initializes ECG ADS1192 component.
+ * @details Blocking variant, runs all initialization steps with busy waits in between.
  ***************************************************************************************************
  * @param [in]  *inDevice - pointer to device structure for ECG driver.
  * @param [in]  *inConfig - configuration structure for ECG driver.
@@ -193,16 +214,92 @@ void BSP_ECG_ADS1192_init(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    uint32_t waitMs = 0u;
+
+    BSP_ECG_ADS1192_initStart(inDevice, inConfig, &waitMs, &ecgErr);
+
+    while((ecgErr == BSP_ECG_ADS1192_err_NONE) && (inDevice->isInitialized == false)) {
+        nrf_delay_ms(waitMs);
+        BSP_ECG_ADS1192_initStep(inDevice, &waitMs, &ecgErr);
+    }
+
+    if(outErr != NULL) {
+        *outErr = ecgErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function starts non-blocking initialization of ECG ADS1192 component.
+ * @details Initialization continues with BSP_ECG_ADS1192_initStep, which has to be called after
+ *          returned wait time elapses. Waits are left to the caller, so they can overlap with
+ *          initialization of other components.
+ ***************************************************************************************************
+ * @param [in]  *inDevice  - pointer to device structure for ECG driver.
+ * @param [in]  *inConfig  - configuration structure for ECG driver.
+ * @param [out] *outWaitMs - time to wait before next initialization step (ms).
+ * @param [out] *outErr    - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_ECG_ADS1192_initStart(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_config_S *inConfig,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    uint32_t waitMs = 0u;
 
     if((inDevice != NULL) && (inConfig != NULL)) {
         inDevice->config = inConfig;
         inDevice->sampleIndex = 0u;
+        inDevice->regDirty = 0u;
         inDevice->isInitialized = false;
 
         // internal oscillator start-up time
         nrf_delay_us(BSP_ECG_ADS1192_INIT_OSC_WAIT_TIME_US);
 
-        // reset the device and its registers on start-up
+        // set nRESET pin high, wait according to datasheet power-up sequence
+        nrf_gpio_pin_set(ECG_RST);
+        inDevice->initState = BSP_ECG_ADS1192_initState_POWER_UP;
+        waitMs = BSP_ECG_ADS1192_POWER_UP_TIME_MS;
+    } else {
+        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+    }
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = waitMs;
+    }
+
+    if(outErr != NULL) {
+        *outErr = ecgErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function runs next step of non-blocking ECG ADS1192 initialization.
+ * @details Device is initialized when isInitialized is set, returned wait time is 0 then.
+ *          Diagnostics enabled with DEBUG run in their own steps after reference settles, each
+ *          returning its settle or calibration time as well.
+ ***************************************************************************************************
+ * @param [in]  *inDevice  - pointer to device structure for ECG driver.
+ * @param [out] *outWaitMs - time to wait before next initialization step (ms).
+ * @param [out] *outErr    - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_ECG_ADS1192_initStep(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    uint32_t waitMs = 0u;
+
+    if(inDevice == NULL) {
+        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_POWER_UP) {
+        // reset the device and its registers
         BSP_ECG_ADS1192_initReset(inDevice, &ecgErr);
 
         if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
@@ -215,64 +312,102 @@ void BSP_ECG_ADS1192_init(BSP_ECG_ADS1192_device_S *inDevice,
             nrf_delay_us(BSP_ECG_ADS1192_WAIT_TIME_8_US);
         }
 
+        // load register reset values to shadow with single burst read
         if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            // set internal reference voltage (2.42V)
-            BSP_ECG_ADS1192_config2Reg_U conf2 = { .R = 0x80u };
-            conf2.B.pdbRefBuf = BSP_ECG_ADS1192_INT_REF_BUFF_ENABLE;
-            BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                    BSP_ECG_ADS1192_reg_CONFIG_2,
-                    (uint8_t *) &conf2,
+            BSP_ECG_ADS1192_readRegs(inDevice,
+                    BSP_ECG_ADS1192_reg_ID,
+                    BSP_ECG_ADS1192_reg_COUNT,
+                    NULL,
                     &ecgErr);
-            // wait for reference voltage to settle
-            nrf_delay_us(BSP_ECG_ADS1192_INIT_WAIT_TIME_200_MS);
         }
 
-        // set SPS, continuous conversion
         if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            BSP_ECG_ADS1192_setConversionRate(inDevice, inDevice->config->samplingRate, &ecgErr);
-        }
+            // set internal reference voltage (2.42V)
+            BSP_ECG_ADS1192_config2Reg_U conf2 = { .R = 0x80u };
+            conf2.B.pdbRefBuf = BSP_ECG_ADS1192_INT_REF_BUFF_ENABLE;
+            BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CONFIG_2, conf2.R);
+            // set SPS, continuous conversion
+            BSP_ECG_ADS1192_setConversionRate(inDevice, inDevice->config->samplingRate);
+            // enable calibrating PGA
+            BSP_ECG_ADS1192_enablePgaCalibration(inDevice);
 
-        // enable calibrating PGA
-        if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            BSP_ECG_ADS1192_enablePgaCalibration(inDevice, &ecgErr);
+            BSP_ECG_ADS1192_flushRegs(inDevice, &ecgErr);
         }
 
+        // wait for reference voltage to settle
+        inDevice->initState = BSP_ECG_ADS1192_initState_REFERENCE;
+        waitMs = BSP_ECG_ADS1192_REF_SETTLE_TIME_MS;
 #if (DEBUG == true)
-        // update temperature
-        if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            BSP_ECG_ADS1192_updateTemperature(inDevice, &ecgErr);
-        }
-
-        // read device supply voltage
-        if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            BSP_ECG_ADS1192_readSupplyMeasurement(inDevice, &ecgErr);
-        }
-
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_REFERENCE) {
+        // measure temperature
+        BSP_ECG_ADS1192_startTemperature(inDevice, &waitMs, &ecgErr);
+        inDevice->initState = BSP_ECG_ADS1192_initState_TEMPERATURE;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_TEMPERATURE) {
+        BSP_ECG_ADS1192_updateTemperature(inDevice, &waitMs, &ecgErr);
+        inDevice->initState = BSP_ECG_ADS1192_initState_TEMPERATURE_RESTORE;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_TEMPERATURE_RESTORE) {
+        // measure device supply voltage
+        BSP_ECG_ADS1192_startSupplyMeasurement(inDevice, &waitMs, &ecgErr);
+        inDevice->initState = BSP_ECG_ADS1192_initState_SUPPLY;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_SUPPLY) {
+        BSP_ECG_ADS1192_readSupplyMeasurement(inDevice, &waitMs, &ecgErr);
+        inDevice->initState = BSP_ECG_ADS1192_initState_SUPPLY_RESTORE;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_SUPPLY_RESTORE) {
         // internally generated test signal check
-        if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            BSP_ECG_ADS1192_readTestSignal(inDevice, &ecgErr);
-        }
+        BSP_ECG_ADS1192_startTestSignal(inDevice, &waitMs, &ecgErr);
+        inDevice->initState = BSP_ECG_ADS1192_initState_TEST_SIGNAL;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_TEST_SIGNAL) {
+        // calibrate PGA on test signal
+        BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_OFFSETCAL, &ecgErr);
+        inDevice->initState = BSP_ECG_ADS1192_initState_TEST_SIGNAL_CALIBRATION;
+        waitMs = BSP_ECG_ADS1192_OFFSETCAL_TIME_MS;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_TEST_SIGNAL_CALIBRATION) {
+        BSP_ECG_ADS1192_readTestSignal(inDevice, &ecgErr);
 
         // check if any Lead is off
         if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            BSP_ECG_ADS1192_detectLeadOff(inDevice, &ecgErr);
+            BSP_ECG_ADS1192_startLeadOffDetection(inDevice, &waitMs, &ecgErr);
         }
+        inDevice->initState = BSP_ECG_ADS1192_initState_LEAD_OFF;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_LEAD_OFF) {
+        BSP_ECG_ADS1192_detectLeadOff(inDevice, &ecgErr);
 
         // check if RLD is off
         if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            BSP_ECG_ADS1192_detectRldOff(inDevice, &ecgErr);
+            BSP_ECG_ADS1192_startRldOffDetection(inDevice, &waitMs, &ecgErr);
         }
-#endif // #if (DEBUG == true)
+        inDevice->initState = BSP_ECG_ADS1192_initState_RLD_OFF;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_RLD_OFF) {
+        BSP_ECG_ADS1192_detectRldOff(inDevice, &ecgErr);
 
         if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            BSP_ECG_ADS1192_setNormalElectrodeRead(inDevice, &ecgErr);
+            BSP_ECG_ADS1192_setNormalElectrodeRead(inDevice, &waitMs, &ecgErr);
         }
 
-        if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-            inDevice->isInitialized = true;
-        }
+        // offset calibration is valid only with settled reference
+        inDevice->initState = BSP_ECG_ADS1192_initState_ELECTRODE;
+#else
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_REFERENCE) {
+        BSP_ECG_ADS1192_setNormalElectrodeRead(inDevice, &waitMs, &ecgErr);
+
+        // offset calibration is valid only with settled reference
+        inDevice->initState = BSP_ECG_ADS1192_initState_ELECTRODE;
+#endif // #if (DEBUG == true)
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_ELECTRODE) {
+        // calibrate PGA
+        BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_OFFSETCAL, &ecgErr);
+
+        inDevice->initState = BSP_ECG_ADS1192_initState_CALIBRATION;
+        waitMs = BSP_ECG_ADS1192_OFFSETCAL_TIME_MS;
+    } else if(inDevice->initState == BSP_ECG_ADS1192_initState_CALIBRATION) {
+        inDevice->initState = BSP_ECG_ADS1192_initState_DONE;
+        inDevice->isInitialized = true;
     } else {
-        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+        // nothing left to do
+    }
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = waitMs;
     }
 
     if(outErr != NULL) {
@@ -336,35 +471,129 @@ void BSP_ECG_ADS1192_stopEcgReading(BSP_ECG_ADS1192_device_S *inDevice,
 }
 
 /***********************************************************************************************//**
- * @brief Function for reading data shifted out of ADS1192.
+ * @brief Function changes conversion rate and PGA gain of initialized ADS1192.
+ * @details Reading has to be stopped with BSP_ECG_ADS1192_stopEcgReading before, it is started
+ *          again by the caller after returned wait time elapses. Offset calibration is run only if
+ *          PGA gain changed, since calibration is only valid for gain it was run with. Reference
+ *          buffer stays powered up since initialization, so calibration is not delayed by its
+ *          settling. Device configuration is updated, so it holds settings in use.
+ ***************************************************************************************************
+ * @param [in]  *inDevice  - pointer to device structure for ECG driver.
+ * @param [in]  inSps      - wanted conversion rate (SPS) for device.
+ * @param [in]  inPga      - wanted PGA gain for normal electrode reading.
+ * @param [out] *outWaitMs - time to wait before reading is started (ms).
+ * @param [out] *outErr    - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_ECG_ADS1192_reconfigure(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_convRate_E inSps,
+        BSP_ECG_ADS1192_pga_E inPga,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    uint32_t waitMs = 0u;
+    uint32_t refWaitMs = 0u;
+    bool isPgaChanged = false;
+
+    if(inDevice == NULL) {
+        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+    } else if((inDevice->isInitialized == false) ||
+            (inSps > BSP_ECG_ADS1192_convRate_8000_SPS) ||
+            (inPga > BSP_ECG_ADS1192_pga_12X)) {
+        ecgErr = BSP_ECG_ADS1192_err_INVALID_PARAM;
+    } else {
+        isPgaChanged = (inDevice->config->pgaSetting != inPga);
+        inDevice->config->samplingRate = inSps;
+        inDevice->config->pgaSetting = inPga;
+
+        BSP_ECG_ADS1192_setConversionRate(inDevice, inSps);
+        // rewrites CH1_SET and CH2_SET with new PGA gain, other registers are unchanged
+        BSP_ECG_ADS1192_setNormalElectrodeRead(inDevice, &refWaitMs, &ecgErr);
+
+        if((ecgErr == BSP_ECG_ADS1192_err_NONE) && (isPgaChanged == true)) {
+            BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_OFFSETCAL, &ecgErr);
+            waitMs = BSP_ECG_ADS1192_OFFSETCAL_TIME_MS;
+        }
+
+        if(refWaitMs > waitMs) {
+            waitMs = refWaitMs;
+        }
+    }
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = waitMs;
+    }
+
+    if(outErr != NULL) {
+        *outErr = ecgErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function for reading one data frame shifted out of ADS1192 and decoding it.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
- * @param [in]  inSize       - length (in bytes) of data to be read.
- * @param [out] *outData     - pointer to output buffer with converted signed 16 bits values.
+ * @param [out] *outFrame    - pointer to output decoded frame.
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
  * @date    01.11.2020
  **************************************************************************************************/
 void BSP_ECG_ADS1192_readData(BSP_ECG_ADS1192_device_S *inDevice,
-        const uint16_t inSize,
-        int16_t *outData,
+        BSP_ECG_ADS1192_frame_S *outFrame,
+        BSP_ECG_ADS1192_err_E *outErr) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    BSP_ECG_ADS1192_rawFrame_S rawFrame = { .data = { 0u } };
+
+    if(outFrame != NULL) {
+        BSP_ECG_ADS1192_readFrame(inDevice, &rawFrame, &ecgErr);
+    } else {
+        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+    }
+
+    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
+        BSP_ECG_ADS1192_convertSignalToSignedVal(&rawFrame.data[0], outFrame);
+    }
+
+    if(outErr != NULL) {
+        *outErr = ecgErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function for reading one data frame shifted out of ADS1192, without conversion.
+ * @details Meant to be called from DRDY interrupt, before the device overwrites its output
+ *          register on the next DRDY. Frame is converted later with BSP_ECG_ADS1192_convertFrame.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [out] *outFrame    - pointer to output raw frame.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_ECG_ADS1192_readFrame(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_rawFrame_S *outFrame,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
     DRV_SPI_err_E spiErr = DRV_SPI_err_NONE;
-    uint8_t rxBuffer[BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME] = { 0u };
 
-    // TODO: might be good to add null check for inDevice and outData
-    DRV_SPI_masterRxBlocking(inDevice->config->spiInstance,
-            inSize,
-            &rxBuffer[0],
-            &spiErr);
+    if((inDevice != NULL) && (outFrame != NULL)) {
+        DRV_SPI_masterRxBlocking(inDevice->config->spiInstance,
+                BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME,
+                &outFrame->data[0],
+                &spiErr);
 
-    if(spiErr != DRV_SPI_err_NONE) {
-        ecgErr = BSP_ECG_ADS1192_err_SPI_READ_WRITE;
+        if(spiErr != DRV_SPI_err_NONE) {
+            ecgErr = BSP_ECG_ADS1192_err_SPI_READ_WRITE;
+        }
     } else {
-        BSP_ECG_ADS1192_convertSignalToSignedVal(&rxBuffer[0], outData);
+        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
     }
 
     if(outErr != NULL) {
@@ -372,27 +601,118 @@ void BSP_ECG_ADS1192_readData(BSP_ECG_ADS1192_device_S *inDevice,
     }
 }
 
+/***********************************************************************************************//**
+ * @brief Function queues non-blocking read of one data frame shifted out of ADS1192.
+ * @details Frame is read from SPI interrupt, doneHandler is called from SPI interrupt when
+ *          the whole frame is received. Only one frame read can be in progress at a time.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [out] *outFrame    - pointer to output raw frame, must stay valid until frame is read.
+ * @param [in]  doneHandler  - function called when frame is read.
+ * @param [in]  *context     - context passed to doneHandler.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_ECG_ADS1192_readFrameAsync(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_rawFrame_S *outFrame,
+        DRV_SPI_IRQHandler doneHandler,
+        void *context,
+        BSP_ECG_ADS1192_err_E *outErr) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    DRV_SPI_err_E spiErr = DRV_SPI_err_NONE;
+
+    if((inDevice != NULL) && (outFrame != NULL)) {
+        // dummy zeros are shifted out while frame is shifted in
+        inDevice->frameTransfer.txData = NULL;
+        inDevice->frameTransfer.rxData = &outFrame->data[0];
+        inDevice->frameTransfer.size = BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME;
+        inDevice->frameTransfer.callbackFunction = doneHandler;
+        inDevice->frameTransfer.context = context;
+
+        DRV_SPI_transfer(inDevice->config->spiInstance, &inDevice->frameTransfer, &spiErr);
+
+        if(spiErr != DRV_SPI_err_NONE) {
+            ecgErr = BSP_ECG_ADS1192_err_SPI_READ_WRITE;
+        }
+    } else {
+        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+    }
+
+    if(outErr != NULL) {
+        *outErr = ecgErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function for decoding raw data frame into status word and signed 16 bits channel values.
+ ***************************************************************************************************
+ * @param [in]  *inFrame     - pointer to raw frame read with BSP_ECG_ADS1192_readFrame.
+ * @param [out] *outFrame    - pointer to output decoded frame.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_ECG_ADS1192_convertFrame(const BSP_ECG_ADS1192_rawFrame_S *inFrame,
+        BSP_ECG_ADS1192_frame_S *outFrame) {
+
+    BSP_ECG_ADS1192_convertSignalToSignedVal(&inFrame->data[0], outFrame);
+}
+
+/***********************************************************************************************//**
+ * @brief Function returns lead-off status carried in status word of decoded frame.
+ * @details Lead-off comparators are sampled with every conversion, so electrode state is known
+ *          per sample without reading LOFF_STAT register. Bits are set only while lead-off
+ *          detection is enabled in device configuration.
+ ***************************************************************************************************
+ * @param [in]  *inFrame     - pointer to decoded frame.
+ * @return lead-off status, combination of BSP_ECG_ADS1192_LOFF_x bits.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint8_t BSP_ECG_ADS1192_getLeadOff(const BSP_ECG_ADS1192_frame_S *inFrame) {
+
+    return (uint8_t) ((inFrame->status >> BSP_ECG_ADS1192_STATUS_LOFF_SHIFT) & BSP_ECG_ADS1192_STATUS_LOFF_MASK);
+}
+
+/***********************************************************************************************//**
+ * @brief Function returns number of samples per second for configured conversion rate.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @return sample rate in samples per second.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint16_t BSP_ECG_ADS1192_getSampleRate(const BSP_ECG_ADS1192_device_S *inDevice) {
+
+    // every conversion rate setting doubles the sample rate
+    return (uint16_t) (BSP_ECG_ADS1192_MIN_SPS << inDevice->config->samplingRate);
+}
+
 /*******************************************************************************
  *                         PRIVATE FUNCTION DEFINITIONS
  **************************************************************************************************/
 /***********************************************************************************************//**
  * @brief Function for converting output signal into usable value.
- * @details Converts 8-bit output signal array into correct 16-bit
- *          twos-complement values (amplitudes).
+ * @details Converts 8-bit output signal array into status word and correct 16-bit
+ *          twos-complement values (amplitudes). Every word is shifted out MSB first.
  ***************************************************************************************************
- * @param [in]  *inData    - pointer to input unsigned byte data array.
- * @param [out] *outData   - pointer to output signed 16 bit data array.
+ * @param [in]  *inData    - pointer to input unsigned byte data array, one whole frame.
+ * @param [out] *outFrame  - pointer to output decoded frame.
  ***************************************************************************************************
  * @author  mario.kodba
  * @date    05.12.2020
  **************************************************************************************************/
 static __INLINE void BSP_ECG_ADS1192_convertSignalToSignedVal(const uint8_t *inData,
-        int16_t *outData) {
-
-    outData[0] = inData[1] | (inData[0] << BSP_ECG_ADS1192_BYTE_SHIFT);
-    outData[1] = inData[2] | (inData[1] << BSP_ECG_ADS1192_BYTE_SHIFT);
-    outData[2] = inData[3] | (inData[2] << BSP_ECG_ADS1192_BYTE_SHIFT);
+        BSP_ECG_ADS1192_frame_S *outFrame) {
 
+    outFrame->status = (uint16_t) ((inData[0] << BSP_ECG_ADS1192_BYTE_SHIFT) | inData[1]);
+    outFrame->ch1 = (int16_t) ((inData[2] << BSP_ECG_ADS1192_BYTE_SHIFT) | inData[3]);
+    outFrame->ch2 = (int16_t) ((inData[4] << BSP_ECG_ADS1192_BYTE_SHIFT) | inData[5]);
 }
 
 /***********************************************************************************************//**
@@ -433,37 +753,45 @@ static void BSP_ECG_ADS1192_sendSpiCommand(BSP_ECG_ADS1192_device_S *inDevice,
 }
 
 /***********************************************************************************************//**
- * @brief Function for writing to single register of ADS1192.
+ * @brief Function for writing to block of consecutive registers of ADS1192.
+ * @details All registers are written in single WREG transaction. Register shadow is not updated,
+ *          use BSP_ECG_ADS1192_setReg and BSP_ECG_ADS1192_flushRegs to keep it in sync.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
- * @param [in]  inReg        - register address.
- * @param [in]  *inData      - pointer to data to be sent.
+ * @param [in]  inStartReg   - first register to write to.
+ * @param [in]  inCount      - number of registers to write to.
+ * @param [in]  *inData      - pointer to data to be sent, one byte per register.
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    21.10.2020
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void BSP_ECG_ADS1192_writeSingleReg(BSP_ECG_ADS1192_device_S *inDevice,
-        const BSP_ECG_ADS1192_reg_E inReg,
+static void BSP_ECG_ADS1192_writeRegs(BSP_ECG_ADS1192_device_S *inDevice,
+        const BSP_ECG_ADS1192_reg_E inStartReg,
+        const uint8_t inCount,
         const uint8_t *inData,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
     DRV_SPI_err_E spiErr = DRV_SPI_err_NONE;
-    uint8_t opcode[BSP_ECG_ADS1192_SPI_SIZE_WRITE] = { 0u };
-    uint8_t regAddr = ecgADS1192RegAddr[inReg];
-    uint8_t txBufferLen = BSP_ECG_ADS1192_SPI_SIZE_WRITE;
+    uint8_t txBuffer[BSP_ECG_ADS1192_SPI_MSG_MAX_SIZE] = { 0u };
 
-    if((inDevice != NULL) && (inData != NULL)) {
-        /* byte format for Read opcode: | 001R RRRR | 000N NNNN | DATA |
-         * RRRR - regAddr, NNNN - number of registers to write to */
-        opcode[0] = BSP_ECG_ADS1192_SPI_WRITE_CMD | regAddr;
-        opcode[1] = BSP_ECG_ADS1192_SPI_SINGLE_REG;
-        opcode[2] = *inData;
+    if((inDevice == NULL) || (inData == NULL)) {
+        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+    } else if((inCount == 0u) || ((inStartReg + inCount) > BSP_ECG_ADS1192_reg_COUNT)) {
+        ecgErr = BSP_ECG_ADS1192_err_INVALID_PARAM;
+    } else {
+        /* byte format for Write opcode: | 010R RRRR | 000N NNNN | DATA ... |
+         * RRRR - regAddr, NNNN - number of registers to write to minus one */
+        txBuffer[0] = BSP_ECG_ADS1192_SPI_WRITE_CMD | ecgADS1192RegAddr[inStartReg];
+        txBuffer[1] = inCount - 1u;
+        for(uint8_t i = 0u; i < inCount; i++) {
+            txBuffer[BSP_ECG_ADS1192_SPI_SIZE_OPCODE + i] = inData[i];
+        }
 
         DRV_SPI_masterTxBlocking(inDevice->config->spiInstance,
-                &opcode[0],
-                txBufferLen,
+                &txBuffer[0],
+                BSP_ECG_ADS1192_SPI_SIZE_OPCODE + inCount,
                 &spiErr);
         // TODO: [mario.kodba 1.12.2020.] check this delay and value, seems to work correctly with it
         nrf_delay_us(BSP_ECG_ADS1192_WAIT_TIME_8_US);
@@ -471,8 +799,6 @@ static void BSP_ECG_ADS1192_writeSingleReg(BSP_ECG_ADS1192_device_S *inDevice,
         if(spiErr != DRV_SPI_err_NONE) {
             ecgErr = BSP_ECG_ADS1192_err_SPI_READ_WRITE;
         }
-    } else {
-        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
     }
 
     if(outErr != NULL) {
@@ -481,26 +807,64 @@ static void BSP_ECG_ADS1192_writeSingleReg(BSP_ECG_ADS1192_device_S *inDevice,
 }
 
 /***********************************************************************************************//**
- * @brief Function enables PGA calibration for ADS1192.
- * @details If offset calibration enabled and OFFSETCAL SPI command is sent,
- *          it takes at least 305ms for device to calibrate properly.
+ * @brief Function for reading block of consecutive registers of ADS1192.
+ * @details All registers are read in single RREG transaction. Values read are stored to register
+ *          shadow, except for registers changed in shadow and not yet written to device.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [in]  inStartReg   - first register to read from.
+ * @param [in]  inCount      - number of registers to read.
+ * @param [out] *outData     - pointer to read register values, can be NULL to update shadow only.
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    12.12.2020
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void BSP_ECG_ADS1192_enablePgaCalibration(BSP_ECG_ADS1192_device_S *inDevice,
+static void BSP_ECG_ADS1192_readRegs(BSP_ECG_ADS1192_device_S *inDevice,
+        const BSP_ECG_ADS1192_reg_E inStartReg,
+        const uint8_t inCount,
+        uint8_t *outData,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    DRV_SPI_err_E spiErr = DRV_SPI_err_NONE;
+    // one spare byte, SPI driver fetches next TX byte before the last one is shifted in
+    uint8_t txBuffer[BSP_ECG_ADS1192_SPI_MSG_MAX_SIZE + 1u] = { 0u };
+    uint8_t rxBuffer[BSP_ECG_ADS1192_SPI_MSG_MAX_SIZE] = { 0u };
+    uint8_t reg = 0u;
 
-    uint8_t calib = 0x80u;
-    BSP_ECG_ADS1192_writeSingleReg(inDevice,
-            BSP_ECG_ADS1192_reg_MISC_2,
-            (uint8_t *) &calib,
-            &ecgErr);
+    if(inDevice == NULL) {
+        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+    } else if((inCount == 0u) || ((inStartReg + inCount) > BSP_ECG_ADS1192_reg_COUNT)) {
+        ecgErr = BSP_ECG_ADS1192_err_INVALID_PARAM;
+    } else {
+        /* byte format for Read opcode: | 001R RRRR | 000N NNNN |
+         * RRRR - regAddr, NNNN - number of registers to read minus one */
+        txBuffer[0] = BSP_ECG_ADS1192_SPI_READ_CMD | ecgADS1192RegAddr[inStartReg];
+        txBuffer[1] = inCount - 1u;
+
+        DRV_SPI_masterTxRxBlocking(inDevice->config->spiInstance,
+                &txBuffer[0],
+                BSP_ECG_ADS1192_SPI_SIZE_OPCODE + inCount,
+                &rxBuffer[0],
+                &spiErr);
+        // TODO: [mario.kodba 1.12.2020.] check this delay and value, seems to work correctly with it
+        nrf_delay_us(BSP_ECG_ADS1192_WAIT_TIME_8_US);
+
+        if(spiErr != DRV_SPI_err_NONE) {
+            ecgErr = BSP_ECG_ADS1192_err_SPI_READ_WRITE;
+        } else {
+            for(uint8_t i = 0u; i < inCount; i++) {
+                reg = inStartReg + i;
+                if((inDevice->regDirty & (1u << reg)) == 0u) {
+                    inDevice->regShadow[reg] = rxBuffer[BSP_ECG_ADS1192_SPI_SIZE_OPCODE + i];
+                }
+                if(outData != NULL) {
+                    outData[i] = rxBuffer[BSP_ECG_ADS1192_SPI_SIZE_OPCODE + i];
+                }
+            }
+        }
+    }
 
     if(outErr != NULL) {
         *outErr = ecgErr;
@@ -508,77 +872,157 @@ static void BSP_ECG_ADS1192_enablePgaCalibration(BSP_ECG_ADS1192_device_S *inDev
 }
 
 /***********************************************************************************************//**
- * @brief Function sets conversion (SPS) rate for ADS1192.
+ * @brief Function changes register value in register shadow only.
+ * @details Register is marked for writing if value differs from shadow. Changed registers are
+ *          written to device with BSP_ECG_ADS1192_flushRegs.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [in]  inReg        - register to change.
+ * @param [in]  inValue      - new register value.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static __INLINE void BSP_ECG_ADS1192_setReg(BSP_ECG_ADS1192_device_S *inDevice,
+        const BSP_ECG_ADS1192_reg_E inReg,
+        const uint8_t inValue) {
+
+    if(inDevice->regShadow[inReg] != inValue) {
+        inDevice->regShadow[inReg] = inValue;
+        inDevice->regDirty |= (uint16_t) (1u << inReg);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function writes registers changed in register shadow to device.
+ * @details Block from first to last changed register is written in single WREG transaction,
+ *          unchanged registers in between are rewritten with their shadow values.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
- * @param [in]  inSps        - wanted conversion rate (SPS) for device.
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    12.12.2020
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void BSP_ECG_ADS1192_setConversionRate(BSP_ECG_ADS1192_device_S *inDevice,
-        BSP_ECG_ADS1192_convRate_E inSps,
+static void BSP_ECG_ADS1192_flushRegs(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    uint8_t firstReg = 0u;
+    uint8_t lastReg = BSP_ECG_ADS1192_reg_COUNT - 1u;
 
-    BSP_ECG_ADS1192_config1Reg_U conf1Reg = { .R = 0u };
-    conf1Reg.B.dr = (uint8_t) inSps;
-    BSP_ECG_ADS1192_writeSingleReg(inDevice,
-            BSP_ECG_ADS1192_reg_CONFIG_1,
-            (uint8_t *) &conf1Reg,
-            &ecgErr);
+    if(inDevice == NULL) {
+        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+    } else if(inDevice->regDirty != 0u) {
+        while((inDevice->regDirty & (1u << firstReg)) == 0u) {
+            firstReg++;
+        }
+        while((inDevice->regDirty & (1u << lastReg)) == 0u) {
+            lastReg--;
+        }
+
+        BSP_ECG_ADS1192_writeRegs(inDevice,
+                (BSP_ECG_ADS1192_reg_E) firstReg,
+                (lastReg - firstReg) + 1u,
+                &inDevice->regShadow[firstReg],
+                &ecgErr);
+
+        if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
+            inDevice->regDirty = 0u;
+        }
+    }
 
     if(outErr != NULL) {
         *outErr = ecgErr;
     }
 }
 
+/***********************************************************************************************//**
+ * @brief Function enables PGA calibration for ADS1192.
+ * @details If offset calibration enabled and OFFSETCAL SPI command is sent,
+ *          it takes at least 305ms for device to calibrate properly. Register is changed in
+ *          shadow only, it is written on next BSP_ECG_ADS1192_flushRegs.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    12.12.2020
+ **************************************************************************************************/
+static void BSP_ECG_ADS1192_enablePgaCalibration(BSP_ECG_ADS1192_device_S *inDevice) {
+
+    uint8_t calib = 0x80u;
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_MISC_2, calib);
+}
+
+/***********************************************************************************************//**
+ * @brief Function sets conversion (SPS) rate for ADS1192.
+ * @details Register is changed in shadow only, it is written on next BSP_ECG_ADS1192_flushRegs.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [in]  inSps        - wanted conversion rate (SPS) for device.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    12.12.2020
+ **************************************************************************************************/
+static void BSP_ECG_ADS1192_setConversionRate(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_convRate_E inSps) {
+
+    BSP_ECG_ADS1192_config1Reg_U conf1Reg = { .R = 0u };
+    conf1Reg.B.dr = (uint8_t) inSps;
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CONFIG_1, conf1Reg.R);
+}
+
 /***********************************************************************************************//**
  * @brief Registers setup for normal electrode input.
+ * @details Offset calibration is left to the caller. If enabled in device configuration, lead-off
+ *          comparators are set up for both channels, so lead-off status is part of every frame.
+ *          Reference settling time is returned if reference buffer was powered up here, so the
+ *          caller can wait for it without blocking.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [out] *outWaitMs   - time to wait for reference to settle (ms).
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
  * @date    13.12.2020
  **************************************************************************************************/
 static void BSP_ECG_ADS1192_setNormalElectrodeRead(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
     BSP_ECG_ADS1192_config2Reg_U conf2Reg = { .R = 0x80u };
+    BSP_ECG_ADS1192_config2Reg_U oldConf2Reg = { .R = inDevice->regShadow[BSP_ECG_ADS1192_reg_CONFIG_2] };
     BSP_ECG_ADS1192_chXsetReg_U chReg = { .R = 0u };
+    uint8_t loffSensReg = 0u;
+    bool isRefChanged = false;
 
     // set CONFIG 2 register for normal signal
     conf2Reg.B.pdbRefBuf = BSP_ECG_ADS1192_INT_REF_BUFF_ENABLE;
-    BSP_ECG_ADS1192_writeSingleReg(inDevice,
-            BSP_ECG_ADS1192_reg_CONFIG_2,
-            (uint8_t *) &conf2Reg,
-            &ecgErr);
-    //TODO: [mario.kodba 05-12-2020] check if this is needed
-    // wait for reference voltage to settle
-    nrf_delay_us(BSP_ECG_ADS1192_INIT_WAIT_TIME_200_MS);
+
+    if(inDevice->config->leadOffDetection == true) {
+        // lead-off comparators on P+ and N- inputs of both channels
+        conf2Reg.B.pdbLoffComp = BSP_ECG_ADS1192_LEAD_OFF_COMP_ENABLE;
+        loffSensReg = BSP_ECG_ADS1192_LEAD_OFF_BOTH_CHANNELS;
+        BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_LOFF, BSP_ECG_ADS1192_LEAD_OFF_THRESHOLD);
+    }
+
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CONFIG_2, conf2Reg.R);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_LOFF_SENS, loffSensReg);
+    // only reference buffer power-up needs settling time
+    isRefChanged = (oldConf2Reg.B.pdbRefBuf != conf2Reg.B.pdbRefBuf);
 
     // PGA setting defined in device configuration
     chReg.B.pga = (uint8_t) inDevice->config->pgaSetting;
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH1_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
-    }
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH2_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
-    }
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH1_SET, chReg.R);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH2_SET, chReg.R);
 
-    // calibrate PGA
-    BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_OFFSETCAL, &ecgErr);
-    nrf_delay_ms(BSP_ECG_ADS1192_WAIT_TIME_OFFSETCAL_MS);
+    BSP_ECG_ADS1192_flushRegs(inDevice, &ecgErr);
+
+    // reference voltage has to settle after buffer power-up, only if CONFIG 2 was actually changed
+    if(outWaitMs != NULL) {
+        *outWaitMs = (isRefChanged == true) ? BSP_ECG_ADS1192_REF_SETTLE_TIME_MS : 0u;
+    }
 
     if(outErr != NULL) {
         *outErr = ecgErr;
@@ -587,6 +1031,7 @@ static void BSP_ECG_ADS1192_setNormalElectrodeRead(BSP_ECG_ADS1192_device_S *inD
 
 /***********************************************************************************************//**
  * @brief Sends reset impulse on device initialization and resets registers.
+ * @details nRESET pin has to be held high for device power-up time before this is called.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
  * @param [out] *outErr      - error parameter.
@@ -599,11 +1044,6 @@ static void BSP_ECG_ADS1192_initReset(BSP_ECG_ADS1192_device_S *inDevice,
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
 
-    // set nRESET pin high
-    nrf_gpio_pin_set(ECG_RST);
-    // wait 200ms, according to datasheet power-up sequence
-    nrf_delay_us(BSP_ECG_ADS1192_INIT_WAIT_TIME_200_MS);
-
     /* hold nRESET low for 1 period of fMOD frequency,
      * according to datasheet, fMOD = 128kHz -> tMOD = 8us */
     nrf_gpio_pin_clear(ECG_RST);
@@ -627,19 +1067,20 @@ static void BSP_ECG_ADS1192_initReset(BSP_ECG_ADS1192_device_S *inDevice,
 
 #if (DEBUG == true)
 /***********************************************************************************************//**
- * @brief Sets device MUX to read PCB temperature from device sensor.
+ * @brief Sets device MUX to read PCB temperature from device sensor and starts offset calibration.
  ***************************************************************************************************
  * @param [in]  *inDevice    - device structure for ECG driver.
+ * @param [out] *outWaitMs   - time to wait for offset calibration (ms).
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
  * @date    13.11.2020
  **************************************************************************************************/
-static void BSP_ECG_ADS1192_updateTemperature(BSP_ECG_ADS1192_device_S *inDevice,
+static void BSP_ECG_ADS1192_startTemperature(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
-    uint8_t outBuffer[BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME] = { 0u };
 
     // set channel 2 for temperature measurement
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
@@ -647,15 +1088,39 @@ static void BSP_ECG_ADS1192_updateTemperature(BSP_ECG_ADS1192_device_S *inDevice
         // set PGA to 1x
         chReg.B.pga = (uint8_t) BSP_ECG_ADS1192_pga_1X;
         chReg.B.mux = (uint8_t) BSP_ECG_ADS1192_mux_TEMP_SENS;
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH2_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
+        BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH2_SET, chReg.R);
+        BSP_ECG_ADS1192_flushRegs(inDevice, &ecgErr);
     }
 
     // calibrate PGA
     BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_OFFSETCAL, &ecgErr);
-    nrf_delay_ms(BSP_ECG_ADS1192_WAIT_TIME_OFFSETCAL_MS);
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = BSP_ECG_ADS1192_OFFSETCAL_TIME_MS;
+    }
+
+    if(outErr != NULL) {
+        *outErr = ecgErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Reads PCB temperature from device sensor and sets channel 2 back to default settings.
+ * @details Called once offset calibration started by BSP_ECG_ADS1192_startTemperature is done.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - device structure for ECG driver.
+ * @param [out] *outWaitMs   - time to wait for offset calibration (ms).
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_ECG_ADS1192_updateTemperature(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    BSP_ECG_ADS1192_frame_S frame = { 0 };
 
     // issue read command
     BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_RDATA, &ecgErr);
@@ -663,32 +1128,27 @@ static void BSP_ECG_ADS1192_updateTemperature(BSP_ECG_ADS1192_device_S *inDevice
     /* read data shifted out from device:
        16 status bits + 2 channels x 16 bits */
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_readData(inDevice,
-                BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME,
-                &outBuffer[0],
-                &ecgErr);
+        BSP_ECG_ADS1192_readData(inDevice, &frame, &ecgErr);
     }
     nrf_delay_us(BSP_ECG_ADS1192_INIT_WAIT_TIME_4_TCLK);
 
-    // get read temperature bytes from ADC
-    int16_t readVal = outBuffer[4] << BSP_ECG_ADS1192_TEMP_BIT_MASK;
-    readVal = readVal | outBuffer[5];
-    // set device temperature
-    inDevice->temperature = (((readVal - BSP_ECG_ADS1192_TEMP_CONST_1) / BSP_ECG_ADS1192_TEMP_CONST_2)
+    // set device temperature, measured on channel 2
+    inDevice->temperature = (((frame.ch2 - BSP_ECG_ADS1192_TEMP_CONST_1) / BSP_ECG_ADS1192_TEMP_CONST_2)
             + BSP_ECG_ADS1192_TEMP_CONST_3);
 
     // set channel 2 back to default settings
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
         BSP_ECG_ADS1192_chXsetReg_U chReg = { .R = 0u };
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH2_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
+        BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH2_SET, chReg.R);
+        BSP_ECG_ADS1192_flushRegs(inDevice, &ecgErr);
     }
 
     // calibrate PGA
     BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_OFFSETCAL, &ecgErr);
-    nrf_delay_ms(BSP_ECG_ADS1192_WAIT_TIME_OFFSETCAL_MS);
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = BSP_ECG_ADS1192_OFFSETCAL_TIME_MS;
+    }
 
     if(outErr != NULL) {
         *outErr = ecgErr;
@@ -696,110 +1156,64 @@ static void BSP_ECG_ADS1192_updateTemperature(BSP_ECG_ADS1192_device_S *inDevice
 }
 
 /***********************************************************************************************//**
- * @brief Function for reading from single register of ADS1192.
+ * @brief Function configures registers to output test signal.
+ * @details Sets output of both channels to signal with amplitude
+ *          +-(VREFP - VREFN) / 2420. In this case, VREFP = 2.42V, VREFN = 0V.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
- * @param [in]  inReg        - register address to read from.
+ * @param [out] *outWaitMs   - time to wait for reference voltage to settle (ms).
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    21.10.2020
+ * @date    13.11.2020
  **************************************************************************************************/
-static uint8_t BSP_ECG_ADS1192_readSingleReg(BSP_ECG_ADS1192_device_S *inDevice,
-        const BSP_ECG_ADS1192_reg_E inReg,
+static void BSP_ECG_ADS1192_startTestSignal(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
-    DRV_SPI_err_E spiErr = DRV_SPI_err_NONE;
-    uint8_t opcode[BSP_ECG_ADS1192_SPI_SIZE_READ] = { 0u };
-    uint8_t outData[BSP_ECG_ADS1192_SPI_SIZE_READ + BSP_ECG_ADS1192_SPI_READ_OFFSET];
-    uint8_t rxTxBufferSize = BSP_ECG_ADS1192_SPI_SIZE_READ + BSP_ECG_ADS1192_SPI_READ_OFFSET;
-    uint8_t regAddr = ecgADS1192RegAddr[inReg];
-    uint8_t retVal = 0xFFu;
 
-    if(inDevice != NULL) {
-        /* byte format for Read opcode: | 001R RRRR | 000N NNNN |
-         * RRRR - regAddr, NNNN - number of registers to read */
-        opcode[0] = BSP_ECG_ADS1192_SPI_READ_CMD | regAddr;
-        opcode[1] = BSP_ECG_ADS1192_SPI_SINGLE_REG;
+    // set CONFIG 2 register for test signal
+    BSP_ECG_ADS1192_config2Reg_U conf2Reg = { .R = 0x80u };
+    conf2Reg.B.pdbRefBuf = BSP_ECG_ADS1192_INT_REF_BUFF_ENABLE;
+    conf2Reg.B.intTest = BSP_ECG_ADS1192_TEST_SIGNAL_ENABLE;
+    conf2Reg.B.testFreq = BSP_ECG_ADS1192_TEST_SIGNAL_1HZ;
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CONFIG_2, conf2Reg.R);
 
-        // start SPI transfer
-        DRV_SPI_masterTxRxBlocking(inDevice->config->spiInstance,
-                &opcode[0],
-                rxTxBufferSize,
-                &outData[0],
-                &spiErr);
-        // TODO: [mario.kodba 1.12.2020.] check this delay and value, seems to work correctly with it
-        nrf_delay_us(BSP_ECG_ADS1192_WAIT_TIME_8_US);
+    BSP_ECG_ADS1192_chXsetReg_U chReg = { .R = 0u };
+    chReg.B.mux = (uint8_t) BSP_ECG_ADS1192_mux_TEST_SIGNAL;
+    chReg.B.pga = (uint8_t) BSP_ECG_ADS1192_pga_6X;
+    // set both channels to output test signal with PGA = 6x
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH1_SET, chReg.R);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH2_SET, chReg.R);
 
-        if(spiErr != DRV_SPI_err_NONE) {
-            ecgErr = BSP_ECG_ADS1192_err_SPI_READ_WRITE;
-        } else {
-            // return register value
-            retVal = outData[BSP_ECG_ADS1192_SPI_REG_VALUE_INDEX];
-        }
-    } else {
-        ecgErr = BSP_ECG_ADS1192_err_NULL_PARAM;
+    BSP_ECG_ADS1192_flushRegs(inDevice, &ecgErr);
+
+    // wait for reference voltage to settle
+    if(outWaitMs != NULL) {
+        *outWaitMs = BSP_ECG_ADS1192_REF_SETTLE_TIME_MS;
     }
 
     if(outErr != NULL) {
         *outErr = ecgErr;
     }
-
-    return retVal;
-
 }
 
 /***********************************************************************************************//**
- * @brief Function configures registers to output test signal.
- * @details Sets output of both channels to signal with amplitude
- *          +-(VREFP - VREFN) / 2420. In this case, VREFP = 2.42V, VREFN = 0V.
+ * @brief Function outputs test signal configured by BSP_ECG_ADS1192_startTestSignal.
+ * @details Called once reference voltage has settled and PGA is calibrated on test signal.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    13.11.2020
+ * @date    17.10.2026.
  **************************************************************************************************/
 static void BSP_ECG_ADS1192_readTestSignal(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
 
-    // set CONFIG 2 register for test signal
-    BSP_ECG_ADS1192_config2Reg_U conf2Reg = { .R = 0x80u };
-    conf2Reg.B.pdbRefBuf = BSP_ECG_ADS1192_INT_REF_BUFF_ENABLE;
-    conf2Reg.B.intTest = BSP_ECG_ADS1192_TEST_SIGNAL_ENABLE;
-    conf2Reg.B.testFreq = BSP_ECG_ADS1192_TEST_SIGNAL_1HZ;
-    BSP_ECG_ADS1192_writeSingleReg(inDevice,
-            BSP_ECG_ADS1192_reg_CONFIG_2,
-            (uint8_t *) &conf2Reg,
-            &ecgErr);
-    //TODO: [mario.kodba 05-12-2020] check if this is needed
-    // wait for reference voltage to settle
-    nrf_delay_us(BSP_ECG_ADS1192_INIT_WAIT_TIME_200_MS);
-
-    BSP_ECG_ADS1192_chXsetReg_U chReg = { .R = 0u };
-    chReg.B.mux = (uint8_t) BSP_ECG_ADS1192_mux_TEST_SIGNAL;
-    chReg.B.pga = (uint8_t) BSP_ECG_ADS1192_pga_6X;
-    // set both channels to output test signal with PGA = 6x
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH1_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
-    }
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH2_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
-    }
-
-    // calibrate PGA
-    BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_OFFSETCAL, &ecgErr);
-    nrf_delay_ms(BSP_ECG_ADS1192_WAIT_TIME_OFFSETCAL_MS);
-
     // issue read continuous command
     BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_RDATAC, &ecgErr);
 
@@ -831,40 +1245,58 @@ static void BSP_ECG_ADS1192_readTestSignal(BSP_ECG_ADS1192_device_S *inDevice,
  * @brief Sets configuration to output supply voltage values on output.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [out] *outWaitMs   - time to wait for offset calibration (ms).
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
  * @date    03.12.2020
  **************************************************************************************************/
-static void BSP_ECG_ADS1192_readSupplyMeasurement(BSP_ECG_ADS1192_device_S *inDevice,
+static void BSP_ECG_ADS1192_startSupplyMeasurement(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
-    uint8_t outBuffer[BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME] = { 0 };
-    int16_t supplyMeasurements[BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME/2] = { 0 };
 
     BSP_ECG_ADS1192_chXsetReg_U chReg = { .R = 0u };
     chReg.B.mux = BSP_ECG_ADS1192_mux_SUPPLY_MEAS;
     chReg.B.pga = BSP_ECG_ADS1192_pga_1X;
     // set both channels to output test signal with PGA = 1
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH1_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
-    }
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH2_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
-    }
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH1_SET, chReg.R);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH2_SET, chReg.R);
+    BSP_ECG_ADS1192_flushRegs(inDevice, &ecgErr);
 
     // calibrate PGA
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
         BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_OFFSETCAL, &ecgErr);
     }
-    nrf_delay_ms(BSP_ECG_ADS1192_WAIT_TIME_OFFSETCAL_MS);
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = BSP_ECG_ADS1192_OFFSETCAL_TIME_MS;
+    }
+
+    if(outErr != NULL) {
+        *outErr = ecgErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Reads supply voltage values and sets channels back to default settings.
+ * @details Called once offset calibration started by BSP_ECG_ADS1192_startSupplyMeasurement is done.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [out] *outWaitMs   - time to wait for offset calibration (ms).
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_ECG_ADS1192_readSupplyMeasurement(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    BSP_ECG_ADS1192_frame_S frame = { 0 };
+    BSP_ECG_ADS1192_chXsetReg_U chReg = { .R = 0u };
 
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
         // issue read continuous command
@@ -874,46 +1306,29 @@ static void BSP_ECG_ADS1192_readSupplyMeasurement(BSP_ECG_ADS1192_device_S *inDe
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
         // read data shifted out from device
         // 16 status bits + 2 channels x 16 bits
-        BSP_ECG_ADS1192_readData(inDevice,
-                BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME,
-                &outBuffer[0],
-                &ecgErr);
+        BSP_ECG_ADS1192_readData(inDevice, &frame, &ecgErr);
     }
 
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        // convert SPI data to proper format
-        BSP_ECG_ADS1192_convertSignalToSignedVal(&outBuffer[0],
-                BSP_ECG_ADS1192_SPI_SIZE_SINGLE_FRAME,
-                &supplyMeasurements[0]);
-    }
-
-    // save device supply
+    // save device supply, channel 1 measures (AVDD - AVSS) / 2 and channel 2 DVDD / 4
     inDevice->analogVddSupply =
-            ((float) supplyMeasurements[1] / BSP_ECG_ADS1192_ADC_MAX_VALUE ) * BSP_ECG_ADS1192_ADC_REF_VOLTAGE * 2u;
+            ((float) frame.ch1 / BSP_ECG_ADS1192_ADC_MAX_VALUE ) * BSP_ECG_ADS1192_ADC_REF_VOLTAGE * 2u;
 
     inDevice->digitalVddSupply =
-            ((float) supplyMeasurements[2] / BSP_ECG_ADS1192_ADC_MAX_VALUE ) * BSP_ECG_ADS1192_ADC_REF_VOLTAGE * 4u;
+            ((float) frame.ch2 / BSP_ECG_ADS1192_ADC_MAX_VALUE ) * BSP_ECG_ADS1192_ADC_REF_VOLTAGE * 4u;
 
     // set channels back to default settings
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_chXsetReg_U chReg = { .R = 0u };
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH2_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
-    }
-
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_chXsetReg_U chReg = { .R = 0u };
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CH1_SET,
-                (uint8_t *) &chReg,
-                &ecgErr);
+        BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH1_SET, chReg.R);
+        BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CH2_SET, chReg.R);
+        BSP_ECG_ADS1192_flushRegs(inDevice, &ecgErr);
     }
 
     // calibrate PGA
     BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_OFFSETCAL, &ecgErr);
-    nrf_delay_ms(BSP_ECG_ADS1192_WAIT_TIME_OFFSETCAL_MS);
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = BSP_ECG_ADS1192_OFFSETCAL_TIME_MS;
+    }
 
     if(outErr != NULL) {
         *outErr = ecgErr;
@@ -921,64 +1336,78 @@ static void BSP_ECG_ADS1192_readSupplyMeasurement(BSP_ECG_ADS1192_device_S *inDe
 }
 
 /***********************************************************************************************//**
- * @brief Detects if any of the electrodes is disconnected.
+ * @brief Configures device for detection of disconnected electrodes.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [out] *outWaitMs   - time to wait for reference voltage to settle (ms).
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
  * @date    29.11.2020
  **************************************************************************************************/
-static void BSP_ECG_ADS1192_detectLeadOff(BSP_ECG_ADS1192_device_S *inDevice,
+static void BSP_ECG_ADS1192_startLeadOffDetection(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
-    uint8_t regVal;
 
     // set Lead-off comparator threshold
     uint8_t loffReg = BSP_ECG_ADS1192_LEAD_OFF_THRESHOLD;
-    BSP_ECG_ADS1192_writeSingleReg(inDevice,
-            BSP_ECG_ADS1192_reg_LOFF,
-            &loffReg,
-            &ecgErr);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_LOFF, loffReg);
 
     // configure Configuration 2 register for lead-off detection
     BSP_ECG_ADS1192_config2Reg_U conf2Reg = { .R = 0x80u };
     conf2Reg.B.pdbLoffComp = BSP_ECG_ADS1192_LEAD_OFF_COMP_ENABLE;
     conf2Reg.B.pdbRefBuf = BSP_ECG_ADS1192_INT_REF_BUFF_ENABLE;
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CONFIG_2,
-                (uint8_t *) &conf2Reg,
-                &ecgErr);
-    }
-    // wait for reference voltage to settle
-    nrf_delay_us(BSP_ECG_ADS1192_INIT_WAIT_TIME_200_MS);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CONFIG_2, conf2Reg.R);
 
     // configure LOFF_SENS register - both channels P+ and N- for lead-off detection
     uint8_t loffSensReg = BSP_ECG_ADS1192_LEAD_OFF_BOTH_CHANNELS;
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_LOFF_SENS,
-                &loffSensReg,
-                &ecgErr);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_LOFF_SENS, loffSensReg);
+
+    // all registers are written in single burst
+    BSP_ECG_ADS1192_flushRegs(inDevice, &ecgErr);
+
+    // wait for reference voltage to settle
+    if(outWaitMs != NULL) {
+        *outWaitMs = BSP_ECG_ADS1192_REF_SETTLE_TIME_MS;
     }
 
+    if(outErr != NULL) {
+        *outErr = ecgErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Detects if any of the electrodes is disconnected.
+ * @details Lead-off status is taken from status word of a single frame read by command.
+ *          Called once reference voltage set by BSP_ECG_ADS1192_startLeadOffDetection has settled.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_ECG_ADS1192_detectLeadOff(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_err_E *outErr) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    BSP_ECG_ADS1192_frame_S frame = { 0 };
+
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
         // issue read command
         BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_RDATA, &ecgErr);
     }
 
-    // read Lead-off Status register
+    // read frame, status word carries lead-off status
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        regVal = BSP_ECG_ADS1192_readSingleReg(inDevice,
-                         BSP_ECG_ADS1192_reg_LOFF_STAT,
-                         &ecgErr);
+        BSP_ECG_ADS1192_readData(inDevice, &frame, &ecgErr);
     }
 
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
         // check if any LEAD_OFF bit is set
-        if((regVal & BSP_ECG_ADS1192_LEAD_OFF_MASK) != false) {
+        if((BSP_ECG_ADS1192_getLeadOff(&frame) & BSP_ECG_ADS1192_LEAD_OFF_MASK) != 0u) {
             ecgErr = BSP_ECG_ADS1192_err_LEAD_OFF;
         }
     }
@@ -989,48 +1418,63 @@ static void BSP_ECG_ADS1192_detectLeadOff(BSP_ECG_ADS1192_device_S *inDevice,
 }
 
 /***********************************************************************************************//**
- * @brief Function detects if Right Leg Drive (RLD) electrode is disconnected.
+ * @brief Configures device for detection of disconnected Right Leg Drive (RLD) electrode.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [out] *outWaitMs   - time to wait for reference voltage to settle (ms).
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
  * @date    03.12.2020
  **************************************************************************************************/
-static void BSP_ECG_ADS1192_detectRldOff(BSP_ECG_ADS1192_device_S *inDevice,
+static void BSP_ECG_ADS1192_startRldOffDetection(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
         BSP_ECG_ADS1192_err_E *outErr) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
 
     // set Lead-off comparator threshold
     uint8_t loffReg = BSP_ECG_ADS1192_LEAD_OFF_THRESHOLD;
-    BSP_ECG_ADS1192_writeSingleReg(inDevice,
-            BSP_ECG_ADS1192_reg_LOFF,
-            &loffReg,
-            &ecgErr);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_LOFF, loffReg);
 
     // configure Configuration 2 register for lead-off detection
     BSP_ECG_ADS1192_config2Reg_U conf2Reg = { .R = 0x80u };
     conf2Reg.B.pdbLoffComp = BSP_ECG_ADS1192_LEAD_OFF_COMP_ENABLE;
     conf2Reg.B.pdbRefBuf = BSP_ECG_ADS1192_INT_REF_BUFF_ENABLE;
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_CONFIG_2,
-                (uint8_t *) &conf2Reg,
-                &ecgErr);
-    }
-    // wait for reference voltage to settle
-    nrf_delay_us(BSP_ECG_ADS1192_INIT_WAIT_TIME_200_MS);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_CONFIG_2, conf2Reg.R);
 
     // configure RLD_SENS register - both channels P+ and N- for RLD-off detection
     uint8_t rldSensReg = BSP_ECG_ADS1192_RLD_OFF_BOTH_CHANNELS;
-    if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        BSP_ECG_ADS1192_writeSingleReg(inDevice,
-                BSP_ECG_ADS1192_reg_RLD_SENS,
-                &rldSensReg,
-                &ecgErr);
+    BSP_ECG_ADS1192_setReg(inDevice, BSP_ECG_ADS1192_reg_RLD_SENS, rldSensReg);
+
+    // all registers are written in single burst
+    BSP_ECG_ADS1192_flushRegs(inDevice, &ecgErr);
+
+    // wait for reference voltage to settle
+    if(outWaitMs != NULL) {
+        *outWaitMs = BSP_ECG_ADS1192_REF_SETTLE_TIME_MS;
     }
 
+    if(outErr != NULL) {
+        *outErr = ecgErr;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function detects if Right Leg Drive (RLD) electrode is disconnected.
+ * @details Called once reference voltage set by BSP_ECG_ADS1192_startRldOffDetection has settled.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_ECG_ADS1192_detectRldOff(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_err_E *outErr) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
         // issue read command
         BSP_ECG_ADS1192_sendSpiCommand(inDevice, BSP_ECG_ADS1192_SPI_RDATA, &ecgErr);
@@ -1039,9 +1483,11 @@ static void BSP_ECG_ADS1192_detectRldOff(BSP_ECG_ADS1192_device_S *inDevice,
     // read Lead-off Status register
     uint8_t regVal;
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
-        regVal = BSP_ECG_ADS1192_readSingleReg(inDevice,
-                         BSP_ECG_ADS1192_reg_LOFF_STAT,
-                         &ecgErr);
+        BSP_ECG_ADS1192_readRegs(inDevice,
+                BSP_ECG_ADS1192_reg_LOFF_STAT,
+                1u,
+                &regVal,
+                &ecgErr);
     }
 
     if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
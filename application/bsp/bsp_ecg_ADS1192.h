@@ -35,6 +35,18 @@
  **************************************************************************************************/
 #define DEBUG false                                     //!< DEBUG enable macro
 #define BSP_ECG_ADS1192_CONNECTION_EVENT_SIZE   (10u)   //!< Number of ADC samples (16-bit) to be stored to buffer
+#define BSP_ECG_ADS1192_FRAME_SIZE              (6u)    //!< Data frame size in bytes (status + 2 channels)
+#define BSP_ECG_ADS1192_MIN_SPS                 (125u)  //!< Sample rate for lowest conversion rate setting
+#define BSP_ECG_ADS1192_POWER_UP_TIME_MS        (200u)  //!< Wait time after power-up before reset pulse
+#define BSP_ECG_ADS1192_REF_SETTLE_TIME_MS      (200u)  //!< Internal reference settling time
+#define BSP_ECG_ADS1192_OFFSETCAL_TIME_MS       (310u)  //!< Offset calibration time
+
+// ECG ADS1192 lead-off status bits, as in LOFF_STAT register and in status word of each frame
+#define BSP_ECG_ADS1192_LOFF_IN1P               (0x01u) //!< Channel 1 positive electrode is off
+#define BSP_ECG_ADS1192_LOFF_IN1N               (0x02u) //!< Channel 1 negative electrode is off
+#define BSP_ECG_ADS1192_LOFF_IN2P               (0x04u) //!< Channel 2 positive electrode is off
+#define BSP_ECG_ADS1192_LOFF_IN2N               (0x08u) //!< Channel 2 negative electrode is off
+#define BSP_ECG_ADS1192_LOFF_RLD                (0x10u) //!< RLD electrode is off
 
 /***************************************************************************************************
  *                              ENUMERATIONS
@@ -46,7 +58,8 @@ typedef enum BSP_ECG_ADS1192_err_ENUM {
     BSP_ECG_ADS1192_err_INIT,                   //!< Error on initialization
     BSP_ECG_ADS1192_err_SPI_READ_WRITE,         //!< SPI operation error
     BSP_ECG_ADS1192_err_LEAD_OFF,               //!< Channel 1 and 2 Lead-off error
-    BSP_ECG_ADS1192_err_RLD_OFF                 //!< RLD off error
+    BSP_ECG_ADS1192_err_RLD_OFF,                //!< RLD off error
+    BSP_ECG_ADS1192_err_INVALID_PARAM           //!< Parameter out of range error
 } BSP_ECG_ADS1192_err_E;
 
 //! ADS1192 register enumeration
@@ -67,6 +80,25 @@ typedef enum BSP_ECG_ADS1192_reg_ENUM {
     BSP_ECG_ADS1192_reg_COUNT
 } BSP_ECG_ADS1192_reg_E;
 
+//! ADS1192 initialization state enumeration, state is named after the wait in progress
+typedef enum BSP_ECG_ADS1192_initState_ENUM {
+    BSP_ECG_ADS1192_initState_POWER_UP    = 0u, //!< Waiting for device power-up
+    BSP_ECG_ADS1192_initState_REFERENCE,        //!< Device configured, waiting for reference to settle
+#if (DEBUG == true)
+    BSP_ECG_ADS1192_initState_TEMPERATURE,      //!< Diagnostics, waiting for calibration on temperature sensor
+    BSP_ECG_ADS1192_initState_TEMPERATURE_RESTORE, //!< Diagnostics, waiting for calibration after temperature read
+    BSP_ECG_ADS1192_initState_SUPPLY,           //!< Diagnostics, waiting for calibration on supply measurement
+    BSP_ECG_ADS1192_initState_SUPPLY_RESTORE,   //!< Diagnostics, waiting for calibration after supply read
+    BSP_ECG_ADS1192_initState_TEST_SIGNAL,      //!< Diagnostics, waiting for reference with test signal set
+    BSP_ECG_ADS1192_initState_TEST_SIGNAL_CALIBRATION, //!< Diagnostics, waiting for calibration on test signal
+    BSP_ECG_ADS1192_initState_LEAD_OFF,         //!< Diagnostics, waiting for reference with lead-off comparators set
+    BSP_ECG_ADS1192_initState_RLD_OFF,          //!< Diagnostics, waiting for reference with RLD-off comparators set
+#endif // #if (DEBUG == true)
+    BSP_ECG_ADS1192_initState_ELECTRODE,        //!< Normal electrode input set, waiting for reference buffer power-up
+    BSP_ECG_ADS1192_initState_CALIBRATION,      //!< Waiting for offset calibration
+    BSP_ECG_ADS1192_initState_DONE              //!< Initialization finished
+} BSP_ECG_ADS1192_initState_E;
+
 //! ADS1192 conversion rate enumeration
 typedef enum BSP_ECG_ADS1192_convRate_ENUM {
     BSP_ECG_ADS1192_convRate_125_SPS  = 0u,     //!< 125 Samples per second conversion
@@ -143,6 +175,18 @@ typedef union BSP_ECG_ADS1192_chXsetReg_UNION {
     } B;                                        //!< Channel X register bits
 } BSP_ECG_ADS1192_chXsetReg_U;
 
+//! ADS1192 data frame as clocked out of the device, in RDATAC mode
+typedef struct BSP_ECG_ADS1192_rawFrame_STRUCT {
+    uint8_t data[BSP_ECG_ADS1192_FRAME_SIZE];   //!< 16 status bits, channel 1 and channel 2 (MSB first)
+} BSP_ECG_ADS1192_rawFrame_S;
+
+//! ADS1192 data frame decoded from raw frame
+typedef struct BSP_ECG_ADS1192_frame_STRUCT {
+    uint16_t status;                            //!< Status word - 1100, LOFF_STAT[4:0], GPIO[1:0], 00000
+    int16_t  ch1;                               //!< Channel 1 value
+    int16_t  ch2;                               //!< Channel 2 value
+} BSP_ECG_ADS1192_frame_S;
+
 //! ECG ADS1192 driver configuration structure
 typedef struct BSP_ECG_ADS1192_config_STRUCT {
     DRV_SPI_instance_S *spiInstance;            //!< SPI master driver instance structure
@@ -150,13 +194,18 @@ typedef struct BSP_ECG_ADS1192_config_STRUCT {
 
     BSP_ECG_ADS1192_convRate_E samplingRate;    //!< Signal sampling rate
     BSP_ECG_ADS1192_pga_E      pgaSetting;      //!< PGA setting for normal electrode reading
+    bool leadOffDetection;                      //!< Enable lead-off comparators for normal electrode reading
 } BSP_ECG_ADS1192_config_S;
 
 //! ECG ADS1192 driver device structure
 typedef struct BSP_ECG_ADS1192_device_STRUCT {
     BSP_ECG_ADS1192_config_S    *config;        //!< Pointer to ECG driver configuration
     int16_t buffer[BSP_ECG_ADS1192_CONNECTION_EVENT_SIZE];  //!< ADC values buffer to be processed
+    DRV_SPI_transfer_S frameTransfer;           //!< SPI transfer descriptor for non-blocking frame read
     uint16_t sampleIndex;                       //!< Current index of sample
+    uint8_t regShadow[BSP_ECG_ADS1192_reg_COUNT];   //!< Copy of device registers, written values included
+    uint16_t regDirty;                          //!< Registers changed in shadow only, one bit per register
+    BSP_ECG_ADS1192_initState_E initState;      //!< Current initialization state
 #if (DEBUG == true)
     int16_t temperature;                        //!< Temperature of device
     float digitalVddSupply;                     //!< Digital VDD supply
@@ -177,14 +226,37 @@ typedef struct BSP_ECG_ADS1192_device_STRUCT {
 void BSP_ECG_ADS1192_init(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_config_S *inConfig,
         BSP_ECG_ADS1192_err_E *outErr);
+void BSP_ECG_ADS1192_initStart(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_config_S *inConfig,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr);
+void BSP_ECG_ADS1192_initStep(BSP_ECG_ADS1192_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr);
 void BSP_ECG_ADS1192_startEcgReading(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr);
 void BSP_ECG_ADS1192_stopEcgReading(BSP_ECG_ADS1192_device_S *inDevice,
         BSP_ECG_ADS1192_err_E *outErr);
+void BSP_ECG_ADS1192_reconfigure(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_convRate_E inSps,
+        BSP_ECG_ADS1192_pga_E inPga,
+        uint32_t *outWaitMs,
+        BSP_ECG_ADS1192_err_E *outErr);
 void BSP_ECG_ADS1192_readData(BSP_ECG_ADS1192_device_S *inDevice,
-        const uint16_t inSize,
-        int16_t *outData,
+        BSP_ECG_ADS1192_frame_S *outFrame,
+        BSP_ECG_ADS1192_err_E *outErr);
+void BSP_ECG_ADS1192_readFrame(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_rawFrame_S *outFrame,
+        BSP_ECG_ADS1192_err_E *outErr);
+void BSP_ECG_ADS1192_readFrameAsync(BSP_ECG_ADS1192_device_S *inDevice,
+        BSP_ECG_ADS1192_rawFrame_S *outFrame,
+        DRV_SPI_IRQHandler doneHandler,
+        void *context,
         BSP_ECG_ADS1192_err_E *outErr);
+void BSP_ECG_ADS1192_convertFrame(const BSP_ECG_ADS1192_rawFrame_S *inFrame,
+        BSP_ECG_ADS1192_frame_S *outFrame);
+uint8_t BSP_ECG_ADS1192_getLeadOff(const BSP_ECG_ADS1192_frame_S *inFrame);
+uint16_t BSP_ECG_ADS1192_getSampleRate(const BSP_ECG_ADS1192_device_S *inDevice);
 
 #endif // #ifndef BSP_ECG_ADS1192_H_
 /***************************************************************************************************
@@ -27,24 +27,33 @@
 #include "bsp_mpu9150.h"
 #include "nrf_delay.h"
 #include "nrf_drv_twi.h"
-#include "twi_master.h"
+#include "app_timer.h"
+#include "app_util_platform.h"
 
 /***************************************************************************************************
  *                              DEFINES
  **************************************************************************************************/
-#define BSP_MPU9150_READ_DATA_SIZE_IN_BYTES     (14u)           //!< Number of bytes to be read on single TWI transfer
+#define BSP_MPU9150_READ_DATA_SIZE_IN_BYTES     (BSP_MPU9150_FRAME_SIZE) //!< Number of bytes to be read on single TWI transfer
 #define BSP_MPU9150_ACC_DATA_TWI_OFFSET         (0u)            //!< Index (offset) of accelerometer data in TWI reading
 #define BSP_MPU9150_TEMP_DATA_TWI_OFFSET        (6u)            //!< Index (offset) of temperature data in TWI reading
 #define BSP_MPU9150_GYRO_DATA_TWI_OFFSET        (8u)            //!< Index (offset) of gyroscope data in TWI reading
+#define BSP_MPU9150_MAG_DATA_TWI_OFFSET         (14u)           //!< Index (offset) of magnetometer data (EXT_SENS_DATA_00) in TWI reading
 
 #define BSP_MPU9150_WRITE_BYTE                  (0b11010000u)   //!< MPU-9150 I2C write byte
 #define BSP_MPU9150_READ_BYTE                   (0b11010001u)   //!< MPU-9150 I2C read byte
 
-#define BSP_MPU9150_TWI_TIMEOUT                 (10000u)        //!< I2C transfer timeout value
-#define BSP_MPU9150_SINGLE_REG_MSG_SIZE         (2u)            //!< I2C message size for single register
+#define BSP_MPU9150_APP_TIMER_PRESCALER         (0u)            //!< Prescaler of application timer, same as in application
+#define BSP_MPU9150_TWI_TIMEOUT_MS              (20u)           //!< I2C transfer timeout in ms, longest FIFO burst takes ~6 ms
+#define BSP_MPU9150_TWI_TIMEOUT_TICKS           APP_TIMER_TICKS(BSP_MPU9150_TWI_TIMEOUT_MS, BSP_MPU9150_APP_TIMER_PRESCALER) //!< I2C transfer timeout in timer ticks
+#define BSP_MPU9150_SINGLE_REG_MSG_SIZE         (BSP_MPU9150_TWI_TX_SIZE) //!< I2C message size for single register
 
-#define BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT (32767.f)       //!< Max positive value for signed 16-bit (floating point)
 #define BSP_MPU9150_16_BIT_SIGNED_MAX_VAL       (32767)         //!< Max positive value for signed 16-bit
+#define BSP_MPU9150_GYRO_OUTPUT_RATE_HZ         (8000u)         //!< Gyroscope output rate when DLPF is disabled (260 Hz setting)
+#define BSP_MPU9150_GYRO_OUTPUT_RATE_DLPF_HZ    (1000u)         //!< Gyroscope output rate when DLPF is enabled
+#define BSP_MPU9150_SMPLRT_DIV_MAX              (256u)          //!< Max sample rate divider (1 + SMPLRT_DIV)
+
+#if (BSP_MPU9150_CONVERSION_MODE == BSP_MPU9150_CONVERSION_FLOAT)
+#define BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT (32767.f)       //!< Max positive value for signed 16-bit (floating point)
 
 #define BSP_MPU9150_TEMP_CONVERSION_CONST_1     (340)           //!< First constant for temperature conversion (datasheet)
 #define BSP_MPU9150_TEMP_CONVERSION_CONST_2     (35)            //!< Second constant for temperature conversion (datasheet)
@@ -58,6 +67,27 @@
 #define BSP_MPU9150_ACC_RANGE_4G_CONST          (4.f)           //!< Constant for multiplication in acc range +-4G
 #define BSP_MPU9150_ACC_RANGE_8G_CONST          (8.f)           //!< Constant for multiplication in acc range +-8G
 #define BSP_MPU9150_ACC_RANGE_16G_CONST         (16.f)          //!< Constant for multiplication in acc range +-16G
+#elif (BSP_MPU9150_CONVERSION_MODE == BSP_MPU9150_CONVERSION_FIXED)
+/*
+ * Q16 scale constants, K = round(range * 65536 / 32767), so that value = (raw * K) >> 16 gives
+ * the same units as floating point conversion. Largest product (32768 * 32001) fits into int32.
+ */
+#define BSP_MPU9150_Q16_SHIFT                   (16u)           //!< Number of fractional bits in scale constants
+#define BSP_MPU9150_Q16_ROUNDING                (1 << 15)       //!< Half LSB added before shift for rounding
+
+#define BSP_MPU9150_TEMP_Q16_CONST              (193)           //!< Temperature scale, 1/340 in Q16 (datasheet)
+#define BSP_MPU9150_TEMP_OFFSET_CONST           (35)            //!< Temperature offset in degrees (datasheet)
+
+#define BSP_MPU9150_GYRO_RANGE_250DEG_Q16       (500)           //!< Gyro scale to deg/s in range +-250deg/s
+#define BSP_MPU9150_GYRO_RANGE_500DEG_Q16       (1000)          //!< Gyro scale to deg/s in range +-500deg/s
+#define BSP_MPU9150_GYRO_RANGE_1000DEG_Q16      (2000)          //!< Gyro scale to deg/s in range +-1000deg/s
+#define BSP_MPU9150_GYRO_RANGE_2000DEG_Q16      (4000)          //!< Gyro scale to deg/s in range +-2000deg/s
+
+#define BSP_MPU9150_ACC_RANGE_2G_Q16            (4000)          //!< Acc scale to mG in range +-2G
+#define BSP_MPU9150_ACC_RANGE_4G_Q16            (8000)          //!< Acc scale to mG in range +-4G
+#define BSP_MPU9150_ACC_RANGE_8G_Q16            (16000)         //!< Acc scale to mG in range +-8G
+#define BSP_MPU9150_ACC_RANGE_16G_Q16           (32001)         //!< Acc scale to mG in range +-16G
+#endif
 
 // pre-defined register values to send
 #define BSP_MPU9150_RESET_SIGNAL_PATH_VALUE     (0x7u)          //!< Value to send in order to reset signal paths
@@ -65,13 +95,37 @@
 #define BSP_MPU9150_DEVICE_ID_VALUE             (0b01101000u)   //!< Device ID that will verify correct device operation
 
 #define BSP_MPU9150_MAGNETOMETER_ID_VALUE       (0b01001000u)   //!< Device ID of magnetometer that will verify correct device operation
-#define BSP_MPU9150_MAGNETOMETER_SINGLE_MEAS_MODE (1u)          //!< Magnetometer single measurement mode control register value
+
+#define BSP_MPU9150_POWER_UP_TIME_MS            (100u)          //!< Start-up time before registers are accessible (datasheet)
+#define BSP_MPU9150_SIGNAL_PATH_RESET_TIME_MS   (30u)           //!< Time for signal path reset to finish
+#define BSP_MPU9150_PLL_SETTLE_TIME_MS          (2u)            //!< Time for PLL to settle after clock source change (datasheet)
+#define BSP_MPU9150_SENSOR_START_TIME_MS        (50u)           //!< Time for sensors to start up after configuration
+#define BSP_MPU9150_ACC_2G_COUNTS_PER_G         (16384u)        //!< Accelerometer sensitivity in +-2G range, halves with every range step
+#define BSP_MPU9150_MOT_THR_MG_PER_LSB          (32u)           //!< Motion detection threshold register unit
+#define BSP_MPU9150_MOT_THR_MAX                 (255u)          //!< Max motion detection threshold register value
+#define BSP_MPU9150_ACCEL_ON_DELAY_MS           (1u)            //!< Additional accelerometer power-on delay in cycle mode
+#define BSP_MPU9150_HPF_SETTLE_TIME_MS          (1u)            //!< Time high pass filter runs before sample is held as motion reference
+
+#if (BSP_MPU9150_MAG_MODE == true)
+#define BSP_MPU9150_I2C_MST_CLK_400KHZ          (13u)           //!< I2C master clock divider value for 400 kHz
+#define BSP_MPU9150_MAG_MAX_RATE_HZ             (50u)           //!< Max magnetometer read rate, single measurement takes up to 9 ms
+#define BSP_MPU9150_MAG_MAX_RATE_DIVIDER        (32u)           //!< Max magnetometer rate divider (1 + I2C_MST_DLY)
+#define BSP_MPU9150_MAG_MODE_CHANGE_DELAY_US    (100u)          //!< Min wait time between magnetometer mode changes (datasheet)
+#define BSP_MPU9150_MAG_ASA_SIZE                (3u)            //!< Number of sensitivity adjustment registers
+#define BSP_MPU9150_MAG_ASA_OFFSET              (128u)          //!< Adjusted value is H * (ASA + 128) / 256 (datasheet)
+#define BSP_MPU9150_MAG_TENTH_UT_PER_LSB        (3u)            //!< Magnetometer sensitivity, 0.3 uT per LSB
+#define BSP_MPU9150_MAG_SCALE_SHIFT             (8u)            //!< Number of fractional bits in magnetometer scale
+#define BSP_MPU9150_MAG_SCALE_ROUNDING          (1 << 7)        //!< Half LSB added before shift for rounding
+#define BSP_MPU9150_MAG_ST2_OFFSET              (6u)            //!< Index (offset) of ST2 register in magnetometer data
+#define BSP_MPU9150_MAG_ST2_ERROR_MASK          (0x0Cu)         //!< ST2 data error (DERR) and magnetic sensor overflow (HOFL) bits
+#define BSP_MPU9150_MAG_INVALID_VALUE           (INT16_MIN)     //!< Sent instead of magnetometer values on data error or overflow
+#endif
 
 /***************************************************************************************************
  *                          GLOBAL VARIABLES
  **************************************************************************************************/
-static volatile bool twi_tx_done = false;
-static volatile bool twi_rx_done = false;
+APP_TIMER_DEF(mpuTwiTimeoutTimerId);                    //!< Timer aborting TWI transfers that did not finish
+static bool mpuTwiTimerCreated = false;                 //!< Is TWI timeout timer created
 
 /***************************************************************************************************
  *                          PRIVATE FUNCTION DECLARATIONS
@@ -83,6 +137,14 @@ __INLINE static void BSP_MPU9150_calculateGyroValues(const BSP_MPU9150_device_S
 __INLINE static void BSP_MPU9150_calculateAccValues(const BSP_MPU9150_device_S *inDevice,
         const uint8_t *rawValue,
         int16_t *outAcc);
+#if (BSP_MPU9150_CONVERSION_MODE == BSP_MPU9150_CONVERSION_RAW)
+__INLINE static int16_t BSP_MPU9150_getRangeDescriptor(const BSP_MPU9150_device_S *inDevice);
+#endif
+#if (BSP_MPU9150_MAG_MODE == true)
+__INLINE static void BSP_MPU9150_calculateMagValues(const BSP_MPU9150_device_S *inDevice,
+        const uint8_t *rawValue,
+        int16_t *outMag);
+#endif
 __INLINE static void BSP_MPU9150_packDataToSend(const int16_t *gyroVals,
         const int16_t *accVals,
         const int16_t temp,
@@ -106,13 +168,54 @@ static void BSP_MPU9150_writeSingleMagReg(BSP_MPU9150_device_S *inDevice,
         const uint8_t regData,
         BSP_MPU9150_err_E *outErr);
 
+static void BSP_MPU9150_beginTransfer(BSP_MPU9150_device_S *inDevice,
+        uint8_t address,
+        BSP_MPU9150_readHandler handler,
+        void *context,
+        BSP_MPU9150_err_E *outErr);
+static void BSP_MPU9150_startRegWrite(BSP_MPU9150_device_S *inDevice,
+        uint8_t address,
+        uint8_t regAddr,
+        uint8_t regData,
+        BSP_MPU9150_err_E *outErr);
+static void BSP_MPU9150_startRegRead(BSP_MPU9150_device_S *inDevice,
+        uint8_t address,
+        uint8_t startRegAddr,
+        uint8_t length,
+        uint8_t *data,
+        BSP_MPU9150_readHandler handler,
+        void *context,
+        BSP_MPU9150_err_E *outErr);
+static void BSP_MPU9150_sendRegAddress(BSP_MPU9150_device_S *inDevice);
+static void BSP_MPU9150_startFifoDataRead(BSP_MPU9150_device_S *inDevice);
+static void BSP_MPU9150_finishTransfer(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E err);
+static void BSP_MPU9150_waitTransfer(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr);
+static void BSP_MPU9150_recoverBus(BSP_MPU9150_device_S *inDevice);
+static void BSP_MPU9150_twiTimeoutHandler(void *context);
+
 static void BSP_MPU9150_configuration(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr);
+static void BSP_MPU9150_writeDlpf(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_dlpf_E dlpf,
+        BSP_MPU9150_err_E *outErr);
+static void BSP_MPU9150_writeSampleRate(BSP_MPU9150_device_S *inDevice,
+        uint16_t sampleRateHz,
+        BSP_MPU9150_err_E *outErr);
+static void BSP_MPU9150_writeRanges(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_gyroFsRange_E gyroRange,
+        BSP_MPU9150_accFsRange_E accRange,
+        BSP_MPU9150_err_E *outErr);
+static void BSP_MPU9150_writeIntEnable(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr);
+#if (BSP_MPU9150_MAG_MODE == true)
+static void BSP_MPU9150_readMagAdjustment(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr);
+static void BSP_MPU9150_magMasterConfiguration(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr);
+#endif
 
 /***************************************************************************************************
  *                          PUBLIC FUNCTION DEFINITIONS
  **************************************************************************************************/
 /***********************************************************************************************//**
  * @brief Function initializes MEMS MPU-9150 component.
+ * @details Blocking variant, runs all initialization steps with busy waits in between.
  ***************************************************************************************************
  * @param [in]  *inDevice - pointer to device structure for MPU-9150 driver.
  * @param [in]  *inConfig - configuration structure for MPU-9150 driver.
@@ -126,50 +229,146 @@ void BSP_MPU9150_init(BSP_MPU9150_device_S *inDevice,
         BSP_MPU9150_err_E *outErr) {
 
     BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
-    uint8_t deviceId = 0u;
+    uint32_t waitMs = 0u;
+
+    BSP_MPU9150_initStart(inDevice, inConfig, &waitMs, &err);
+
+    while((err == BSP_MPU9150_err_NONE) && (inDevice->isInitialized == false)) {
+        nrf_delay_ms(waitMs);
+        BSP_MPU9150_initStep(inDevice, &waitMs, &err);
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function starts non-blocking initialization of MEMS MPU-9150 component.
+ * @details Registers are not accessed before device start-up time elapses. Initialization
+ *          continues with BSP_MPU9150_initStep, which has to be called after returned wait time
+ *          elapses. Waits are left to the caller, so they can overlap with initialization of other
+ *          components.
+ ***************************************************************************************************
+ * @param [in]  *inDevice  - pointer to device structure for MPU-9150 driver.
+ * @param [in]  *inConfig  - configuration structure for MPU-9150 driver.
+ * @param [out] *outWaitMs - time to wait before next initialization step (ms).
+ * @param [out] *outErr    - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_MPU9150_initStart(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_config_S *inConfig,
+        uint32_t *outWaitMs,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    uint32_t waitMs = 0u;
 
     if((inDevice != NULL) && (inConfig != NULL)) {
         inDevice->config = inConfig;
+        inDevice->twiState = BSP_MPU9150_twiState_IDLE;
+        inDevice->lowPowerMode = false;
+        inDevice->lpState = BSP_MPU9150_lpState_IDLE;
+        inDevice->isInitialized = false;
+
+        // every transfer is guarded by single shot timer instead of spinning on counter, timer is
+        // created once and kept over repeated initializations
+        if(mpuTwiTimerCreated == false) {
+            if(app_timer_create(&mpuTwiTimeoutTimerId,
+                    APP_TIMER_MODE_SINGLE_SHOT,
+                    BSP_MPU9150_twiTimeoutHandler) == NRF_SUCCESS) {
+                mpuTwiTimerCreated = true;
+            } else {
+                err = BSP_MPU9150_err_INIT;
+            }
+        }
+
+        if(err == BSP_MPU9150_err_NONE) {
+            inDevice->initState = BSP_MPU9150_initState_POWER_UP;
+            waitMs = BSP_MPU9150_POWER_UP_TIME_MS;
+        }
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
+    }
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = waitMs;
+    }
 
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function runs next step of non-blocking MEMS MPU-9150 initialization.
+ * @details Device is initialized when isInitialized is set, returned wait time is 0 then.
+ ***************************************************************************************************
+ * @param [in]  *inDevice  - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outWaitMs - time to wait before next initialization step (ms).
+ * @param [out] *outErr    - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_MPU9150_initStep(BSP_MPU9150_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    uint8_t deviceId = 0u;
+    uint32_t waitMs = 0u;
+
+    if(inDevice == NULL) {
+        err = BSP_MPU9150_err_NULL_PARAM;
+    } else if(inDevice->initState == BSP_MPU9150_initState_POWER_UP) {
         // verify device ID by reading register value
         BSP_MPU9150_readSingleReg(inDevice,
                 BSP_MPU9150_REG_WHO_AM_I,
                 &deviceId,
                 &err);
 
-        // reset signal path for gyroscope, accelerometer and temperature sensor
-        BSP_MPU9150_writeSingleReg(inDevice,
-                BSP_MPU9150_REG_SIGNAL_PATH_RESET,
-                BSP_MPU9150_RESET_SIGNAL_PATH_VALUE,
-                &err);
-        nrf_delay_ms(30u);
+        if((err == BSP_MPU9150_err_NONE) && (deviceId != BSP_MPU9150_DEVICE_ID_VALUE)) {
+            // device ID value read is not correct
+            err = BSP_MPU9150_err_INIT;
+        }
 
         if(err == BSP_MPU9150_err_NONE) {
-            // set PLL with X axis gyroscope reference (for better clock stability)
+            // reset signal path for gyroscope, accelerometer and temperature sensor
             BSP_MPU9150_writeSingleReg(inDevice,
-                    BSP_MPU9150_REG_PWR_MGMT_1,
-                    BSP_MPU9150_PLL_REFERENCE_VALUE,
+                    BSP_MPU9150_REG_SIGNAL_PATH_RESET,
+                    BSP_MPU9150_RESET_SIGNAL_PATH_VALUE,
                     &err);
-            // wait 2ms for PLL to settle (datasheet)
-            nrf_delay_ms(2u);
         }
 
-        if(err == BSP_MPU9150_err_NONE) {
-            if(deviceId != BSP_MPU9150_DEVICE_ID_VALUE) {
-                // device ID value read is not correct
-                err = BSP_MPU9150_err_INIT;
-            }
-        }
+        inDevice->initState = BSP_MPU9150_initState_SIGNAL_PATH_RESET;
+        waitMs = BSP_MPU9150_SIGNAL_PATH_RESET_TIME_MS;
+    } else if(inDevice->initState == BSP_MPU9150_initState_SIGNAL_PATH_RESET) {
+        // set PLL with X axis gyroscope reference (for better clock stability)
+        BSP_MPU9150_writeSingleReg(inDevice,
+                BSP_MPU9150_REG_PWR_MGMT_1,
+                BSP_MPU9150_PLL_REFERENCE_VALUE,
+                &err);
 
+        inDevice->initState = BSP_MPU9150_initState_PLL;
+        waitMs = BSP_MPU9150_PLL_SETTLE_TIME_MS;
+    } else if(inDevice->initState == BSP_MPU9150_initState_PLL) {
         // configure sensors before start of sampling
-        if(err == BSP_MPU9150_err_NONE) {
-            BSP_MPU9150_configuration(inDevice, &err);
-        }
-        nrf_delay_ms(50u);
+        BSP_MPU9150_configuration(inDevice, &err);
+
+        inDevice->initState = BSP_MPU9150_initState_CONFIGURATION;
+        waitMs = BSP_MPU9150_SENSOR_START_TIME_MS;
+    } else if(inDevice->initState == BSP_MPU9150_initState_CONFIGURATION) {
+        inDevice->initState = BSP_MPU9150_initState_DONE;
+        inDevice->isInitialized = true;
+    } else {
+        // nothing left to do
+    }
 
-        if(err == BSP_MPU9150_err_NONE) {
-            inDevice->isInitialized = true;
-        }
+    if(outWaitMs != NULL) {
+        *outWaitMs = waitMs;
     }
 
     if(outErr != NULL) {
@@ -193,22 +392,16 @@ void BSP_MPU9150_updateValues(BSP_MPU9150_device_S *inDevice,
 
     BSP_MPU9150_err_E mpuErr = BSP_MPU9150_err_NONE;
     // buffer for raw register values
-    uint8_t byteBuffer[BSP_MPU9150_READ_DATA_SIZE_IN_BYTES];
-    int16_t accVals[6];
-    int16_t gyroVals[6];
-    int16_t temp = 0;
+    BSP_MPU9150_rawFrame_S rawFrame;
 
     BSP_MPU9150_readMultiReg(inDevice,
             BSP_MPU9150_REG_ACCEL_XOUT_H,
             BSP_MPU9150_READ_DATA_SIZE_IN_BYTES,
-            &byteBuffer[0],
+            &rawFrame.data[0],
             &mpuErr);
 
     if(mpuErr == BSP_MPU9150_err_NONE) {
-        BSP_MPU9150_calculateAccValues(inDevice, &byteBuffer[BSP_MPU9150_ACC_DATA_TWI_OFFSET], &accVals[0]);
-        BSP_MPU9150_calculateTemperature(&byteBuffer[BSP_MPU9150_TEMP_DATA_TWI_OFFSET], &temp);
-        BSP_MPU9150_calculateGyroValues(inDevice, &byteBuffer[BSP_MPU9150_GYRO_DATA_TWI_OFFSET], &gyroVals[0]);
-        BSP_MPU9150_packDataToSend(&gyroVals[0], &accVals[0], temp, &newValues[0]);
+        BSP_MPU9150_convertFrame(inDevice, &rawFrame, &newValues[0]);
     }
 
     if(outErr != NULL) {
@@ -216,226 +409,151 @@ void BSP_MPU9150_updateValues(BSP_MPU9150_device_S *inDevice,
     }
 }
 
+/***********************************************************************************************//**
+ * @brief Converts raw frame to temperature, accelerometer, gyroscope and magnetometer data in send order.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ * @param [in]  *inFrame    - pointer to raw frame, read from sensor registers or FIFO buffer.
+ * @param [out] *newValues  - pointer to buffer that receives converted values.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_MPU9150_convertFrame(const BSP_MPU9150_device_S *inDevice,
+        const BSP_MPU9150_rawFrame_S *inFrame,
+        int16_t *newValues) {
 
-void nrf_drv_mpu_twi_event_handler(nrf_drv_twi_evt_t const * p_event, void * p_context) {
-
-    BSP_MPU9150_device_S *inDevice = (BSP_MPU9150_device_S *) p_context;
+    int16_t accVals[3];
+    int16_t gyroVals[3];
+    int16_t temp = 0;
 
-    switch(p_event->type) {
-        case NRF_DRV_TWI_EVT_DONE:
-            switch(p_event->xfer_desc.type) {
-                case NRF_DRV_TWI_XFER_TX:
-                    inDevice->twiTxDone = true;
-                    twi_tx_done = true;
-                    break;
-                case NRF_DRV_TWI_XFER_TXTX:
-                    twi_tx_done = true;
-                    inDevice->twiTxDone = true;
-                    break;
-                case NRF_DRV_TWI_XFER_RX:
-                    twi_rx_done = true;
-                    inDevice->twiRxDone = true;
-                    break;
-                case NRF_DRV_TWI_XFER_TXRX:
-                    twi_rx_done = true;
-                    inDevice->twiRxDone = true;
-                    break;
-                default:
-                    break;
-            }
-            break;
-        case NRF_DRV_TWI_EVT_ADDRESS_NACK:
-            break;
-        case NRF_DRV_TWI_EVT_DATA_NACK:
-            break;
-        default:
-            break;
-    }
+    BSP_MPU9150_calculateAccValues(inDevice, &inFrame->data[BSP_MPU9150_ACC_DATA_TWI_OFFSET], &accVals[0]);
+    BSP_MPU9150_calculateTemperature(&inFrame->data[BSP_MPU9150_TEMP_DATA_TWI_OFFSET], &temp);
+    BSP_MPU9150_calculateGyroValues(inDevice, &inFrame->data[BSP_MPU9150_GYRO_DATA_TWI_OFFSET], &gyroVals[0]);
+    BSP_MPU9150_packDataToSend(&gyroVals[0], &accVals[0], temp, &newValues[0]);
+#if (BSP_MPU9150_MAG_MODE == true)
+    BSP_MPU9150_calculateMagValues(inDevice,
+            &inFrame->data[BSP_MPU9150_MAG_DATA_TWI_OFFSET],
+            &newValues[BSP_MPU9150_MAG_DATA_INDEX]);
+#endif
+#if (BSP_MPU9150_CONVERSION_MODE == BSP_MPU9150_CONVERSION_RAW)
+    newValues[BSP_MPU9150_RANGE_DESCRIPTOR_INDEX] = BSP_MPU9150_getRangeDescriptor(inDevice);
+#endif
 }
 
-/***************************************************************************************************
- *                          PRIVATE FUNCTION DEFINITIONS
- **************************************************************************************************/
 /***********************************************************************************************//**
- * @brief Function for writing to single register of MPU9150.
+ * @brief Discards MPU-9150 FIFO buffer content and (re)enables writing samples to it.
  ***************************************************************************************************
- * @param [in]  *inDevice    - pointer to device structure for ECG driver.
- * @param [in]  regAddr      - register address.
- * @param [in]  regData      - data to be sent.
- * @param [out] *outErr      - error parameter.
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outErr     - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    15.05.2021
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void BSP_MPU9150_writeSingleReg(BSP_MPU9150_device_S *inDevice,
-        uint8_t regAddr,
-        const uint8_t regData,
-        BSP_MPU9150_err_E *outErr) {
+void BSP_MPU9150_resetFifo(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr) {
 
     BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
-#if (DEPRECATED_TWI == false)
-    uint32_t err_code;
-    volatile uint32_t timeout = BSP_MPU9150_TWI_TIMEOUT;
-#endif // (DEPRECATED_TWI == false)
-
-    // assemble I2C data - 1 byte register address, 1 byte data
-    uint8_t msg[BSP_MPU9150_SINGLE_REG_MSG_SIZE] = { regAddr, regData };
+    BSP_MPU9150_userCtrlReg_U userCtrlReg = { .R = 0u };
 
-#if (DEPRECATED_TWI == false)
-    err_code = nrf_drv_twi_tx(inDevice->twiInstance,
-            inDevice->config->mpuAddress,
-            &msg[0],
-            BSP_MPU9150_SINGLE_REG_MSG_SIZE,
-            false);
+    if(inDevice != NULL) {
+        // I2C master keeps polling magnetometer while FIFO is reset
+        userCtrlReg.B.i2cMstEn = BSP_MPU9150_MAG_MODE;
 
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
-    }
+        // FIFO can only be reset while it is disabled
+        BSP_MPU9150_writeSingleReg(inDevice,
+                BSP_MPU9150_REG_USER_CTRL,
+                userCtrlReg.R,
+                &err);
 
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    while((!twi_tx_done) && --timeout);
+        if(err == BSP_MPU9150_err_NONE) {
+            userCtrlReg.B.fifoReset = true;
+            BSP_MPU9150_writeSingleReg(inDevice,
+                    BSP_MPU9150_REG_USER_CTRL,
+                    userCtrlReg.R,
+                    &err);
+        }
 
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
+        if(err == BSP_MPU9150_err_NONE) {
+            userCtrlReg.B.fifoReset = false;
+            userCtrlReg.B.fifoEn = true;
+            BSP_MPU9150_writeSingleReg(inDevice,
+                    BSP_MPU9150_REG_USER_CTRL,
+                    userCtrlReg.R,
+                    &err);
+        }
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
     }
 
-    twi_tx_done = false;
-
-#else
-    twi_master_transfer((inDevice->config->mpuAddress << 1u) | 0u, &msg[0], 2u, false);
-#endif // (DEPRECATED_TWI == false)
-
     if(outErr != NULL) {
         *outErr = err;
     }
 }
 
 /***********************************************************************************************//**
- * @brief Function for writing to single register of MPU9150 magnetometer.
+ * @brief Reads (and clears) interrupt status and checks if MPU-9150 FIFO buffer overflowed.
+ * @details After overflow frame boundaries in FIFO are lost, so FIFO needs to be reset.
  ***************************************************************************************************
- * @param [in]  *inDevice    - pointer to device structure for ECG driver.
- * @param [in]  regAddr      - register address.
- * @param [in]  regData      - data to be sent.
- * @param [out] *outErr      - error parameter.
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outErr     - error parameter.
+ ***************************************************************************************************
+ * @return true if FIFO overflow interrupt occurred, false otherwise.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    15.05.2021
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void BSP_MPU9150_writeSingleMagReg(BSP_MPU9150_device_S *inDevice,
-        uint8_t regAddr,
-        const uint8_t regData,
-        BSP_MPU9150_err_E *outErr) {
+bool BSP_MPU9150_checkFifoOverflow(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr) {
 
     BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
-#if (DEPRECATED_TWI == false)
-    uint32_t err_code;
-    volatile uint32_t timeout = BSP_MPU9150_TWI_TIMEOUT;
-#endif // (DEPRECATED_TWI == false)
-
-    // assemble I2C data - 1 byte register address, 1 byte data
-    uint8_t msg[BSP_MPU9150_SINGLE_REG_MSG_SIZE] = { regAddr, regData };
+    BSP_MPU9150_intStatusReg_U intStatusReg = { .R = 0u };
 
-#if (DEPRECATED_TWI == false)
-    err_code = nrf_drv_twi_tx(inDevice->twiInstance,
-            inDevice->config->mpuMagAddress,
-            &msg[0],
-            BSP_MPU9150_SINGLE_REG_MSG_SIZE,
-            false);
-
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
-    }
-
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    while((!twi_tx_done) && --timeout);
-
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
+    if(inDevice != NULL) {
+        BSP_MPU9150_readSingleReg(inDevice,
+                BSP_MPU9150_REG_INT_STATUS,
+                &intStatusReg.R,
+                &err);
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
     }
 
-    twi_tx_done = false;
-
-#else
-    twi_master_transfer((inDevice->config->mpuMagAddress << 1u) | 0u, &msg[0], 2u, false);
-#endif // (DEPRECATED_TWI == false)
-
     if(outErr != NULL) {
         *outErr = err;
     }
+
+    return ((err == BSP_MPU9150_err_NONE) && (intStatusReg.B.fifoOflowInt == true));
 }
 
 /***********************************************************************************************//**
- * @brief Function for reading from single register of MPU9150.
+ * @brief Changes sample rate while sampling is running.
+ * @details Sample rate divider is computed for current DLPF setting, actual rate can be read back
+ *          with BSP_MPU9150_getOutputRate. In FIFO mode FIFO is reset, so no frame sampled at
+ *          previous rate is read out. Must not be called while asynchronous read is in progress.
  ***************************************************************************************************
- * @param [in]  *inDevice    - pointer to device structure for ECG driver.
- * @param [in]  regAddr      - register address.
- * @param [in]  *data        - pointer to data to read.
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [in]  sampleRateHz - requested sample rate in Hz (BSP_MPU9150_MIN_SAMPLE_RATE_HZ to
+ *                             BSP_MPU9150_MAX_SAMPLE_RATE_HZ).
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    15.05.2021
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void BSP_MPU9150_readSingleReg(BSP_MPU9150_device_S *inDevice,
-        uint8_t regAddr,
-        uint8_t *data,
+void BSP_MPU9150_setOutputRate(BSP_MPU9150_device_S *inDevice,
+        uint16_t sampleRateHz,
         BSP_MPU9150_err_E *outErr) {
 
     BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
-#if (DEPRECATED_TWI == false)
-    uint32_t err_code;
-    volatile uint32_t timeout = BSP_MPU9150_TWI_TIMEOUT;
-#endif // (DEPRECATED_TWI == false)
-
-#if (DEPRECATED_TWI == false)
-    // after first START condition send |SLAVE_ADDR+W|REG_ADDR|
-    err_code = nrf_drv_twi_tx(inDevice->twiInstance,
-            inDevice->config->mpuAddress,
-            &regAddr,
-            1u,
-            false);
-
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
-    }
-
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    while((!twi_tx_done) && --timeout);
-
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
-    }
-    twi_tx_done = false;
-
-    // after second START condition read in data from register
-    err_code = nrf_drv_twi_rx(inDevice->twiInstance,
-            inDevice->config->mpuAddress,
-            data,
-            1u);
-
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
-    }
 
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    timeout = BSP_MPU9150_TWI_TIMEOUT;
-    while((!twi_rx_done) && --timeout);
+    if(inDevice != NULL) {
+        BSP_MPU9150_writeSampleRate(inDevice, sampleRateHz, &err);
 
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
+#if (BSP_MPU9150_FIFO_MODE == true)
+        if(err == BSP_MPU9150_err_NONE) {
+            BSP_MPU9150_resetFifo(inDevice, &err);
+        }
+#endif
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
     }
-    twi_rx_done = false;
-
-#else
-    // TX first the reg address with write bit
-    twi_master_transfer((inDevice->config->mpuAddress << 1u) | 0u, &regAddr, 1u, false);
-
-    // RX data from register (single - 1 byte)
-    twi_master_transfer((inDevice->config->mpuAddress << 1u) | 1u, data, 1u, false);
-#endif // (DEPRECATED_TWI == false)
 
     if(outErr != NULL) {
         *outErr = err;
@@ -443,75 +561,39 @@ static void BSP_MPU9150_readSingleReg(BSP_MPU9150_device_S *inDevice,
 }
 
 /***********************************************************************************************//**
- * @brief Function for reading from single register of MPU9150 magnetometer sensor.
+ * @brief Changes digital low pass filter setting while sampling is running.
+ * @details Disabling DLPF (260 Hz setting) changes gyroscope output rate, so sample rate divider
+ *          is recomputed to keep sample rate. In FIFO mode FIFO is reset. Must not be called while
+ *          asynchronous read is in progress.
  ***************************************************************************************************
- * @param [in]  *inDevice    - pointer to device structure for ECG driver.
- * @param [in]  regAddr      - register address.
- * @param [in]  *data        - pointer to data to read.
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [in]  dlpf         - digital low pass filter setting.
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    15.05.2021
+ * @date    17.10.2026.
  **************************************************************************************************/
-void BSP_MPU9150_readSingleMagReg(BSP_MPU9150_device_S *inDevice,
-        uint8_t regAddr,
-        uint8_t *data,
+void BSP_MPU9150_setDlpf(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_dlpf_E dlpf,
         BSP_MPU9150_err_E *outErr) {
 
     BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
-#if (DEPRECATED_TWI == false)
-    uint32_t err_code;
-    volatile uint32_t timeout = BSP_MPU9150_TWI_TIMEOUT;
-#endif // (DEPRECATED_TWI == false)
-
-#if (DEPRECATED_TWI == false)
-    // after first START condition send |SLAVE_ADDR+W|REG_ADDR|
-    err_code = nrf_drv_twi_tx(inDevice->twiInstance,
-            inDevice->config->mpuMagAddress,
-            &regAddr,
-            1u,
-            false);
-
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
-    }
-
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    while((!twi_tx_done) && --timeout);
-
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
-    }
-    twi_tx_done = false;
 
-    // after second START condition read in data from register
-    err_code = nrf_drv_twi_rx(inDevice->twiInstance,
-            inDevice->config->mpuMagAddress,
-            data,
-            1u);
-
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
-    }
+    if(inDevice != NULL) {
+        BSP_MPU9150_writeDlpf(inDevice, dlpf, &err);
 
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    timeout = BSP_MPU9150_TWI_TIMEOUT;
-    while((!twi_rx_done) && --timeout);
+        if(err == BSP_MPU9150_err_NONE) {
+            BSP_MPU9150_writeSampleRate(inDevice, inDevice->config->sampleRateHz, &err);
+        }
 
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
+#if (BSP_MPU9150_FIFO_MODE == true)
+        if(err == BSP_MPU9150_err_NONE) {
+            BSP_MPU9150_resetFifo(inDevice, &err);
+        }
+#endif
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
     }
-    twi_rx_done = false;
-
-#else
-    // TX first the reg address with write bit
-    twi_master_transfer((inDevice->config->mpuMagAddress << 1u) | 0u, &regAddr, 1u, false);
-
-    // RX data from register (single - 1 byte)
-    twi_master_transfer((inDevice->config->mpuMagAddress << 1u) | 1u, data, 1u, false);
-#endif // (DEPRECATED_TWI == false)
 
     if(outErr != NULL) {
         *outErr = err;
@@ -519,79 +601,37 @@ void BSP_MPU9150_readSingleMagReg(BSP_MPU9150_device_S *inDevice,
 }
 
 /***********************************************************************************************//**
- * @brief Function for reading from multiple successive registers of MPU9150 magnetometer.
+ * @brief Changes gyroscope and accelerometer full-scale ranges while sampling is running.
+ * @details Frames converted after this call use new ranges. In FIFO mode FIFO is reset, so no
+ *          frame sampled with previous ranges is converted with new ones. Must not be called while
+ *          asynchronous read is in progress.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
- * @param [in]  startRegAddr - starting register address.
- * @param [in]  length       - number of registers (bytes) to read.
- * @param [in]  *data        - pointer to data to read.
+ * @param [in]  gyroRange    - gyroscope full-scale range.
+ * @param [in]  accRange     - accelerometer full-scale range.
  * @param [out] *outErr      - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    15.05.2021
+ * @date    17.10.2026.
  **************************************************************************************************/
-void BSP_MPU9150_readMultiMagReg(BSP_MPU9150_device_S *inDevice,
-        uint8_t startRegAddr,
-        const uint8_t length,
-        uint8_t *data,
+void BSP_MPU9150_setRanges(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_gyroFsRange_E gyroRange,
+        BSP_MPU9150_accFsRange_E accRange,
         BSP_MPU9150_err_E *outErr) {
 
     BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
-#if (DEPRECATED_TWI == false)
-    uint32_t err_code;
-    volatile uint32_t timeout = BSP_MPU9150_TWI_TIMEOUT;
-#endif // (DEPRECATED_TWI == false)
-
-#if (DEPRECATED_TWI == false)
-    // after first START condition send |SLAVE_ADDR+W|START_REG_ADDR|
-    err_code = nrf_drv_twi_tx(inDevice->twiInstance,
-            inDevice->config->mpuMagAddress,
-            &startRegAddr,
-            1u,
-            false);
 
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
-    }
-
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    while((!inDevice->twiTxDone) && --timeout);
-
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
-    }
-    inDevice->twiTxDone = false;
-
-    // after second START condition read in data from registers
-    err_code = nrf_drv_twi_rx(inDevice->twiInstance,
-            inDevice->config->mpuMagAddress,
-            data,
-            length);
-
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
-    }
-
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    timeout = BSP_MPU9150_TWI_TIMEOUT;
-    while((!inDevice->twiRxDone) && --timeout);
-
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
-    }
-    inDevice->twiRxDone = false;
-
-#else
-    // TX first the register address with write bit
-    err = twi_master_transfer((inDevice->config->mpuMagAddress << 1u) | 0u, &startRegAddr, 1u, false);
-
-    // RX data from register
-    err &= twi_master_transfer((inDevice->config->mpuMagAddress << 1u) | 1u, data, length, true);
+    if(inDevice != NULL) {
+        BSP_MPU9150_writeRanges(inDevice, gyroRange, accRange, &err);
 
-    err = 1 ? 0 : err;
+#if (BSP_MPU9150_FIFO_MODE == true)
+        if(err == BSP_MPU9150_err_NONE) {
+            BSP_MPU9150_resetFifo(inDevice, &err);
+        }
 #endif
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
+    }
 
     if(outErr != NULL) {
         *outErr = err;
@@ -599,85 +639,912 @@ void BSP_MPU9150_readMultiMagReg(BSP_MPU9150_device_S *inDevice,
 }
 
 /***********************************************************************************************//**
- * @brief Function for reading from multiple successive registers of MPU9150.
+ * @brief Returns actual sample rate set on device.
  ***************************************************************************************************
  * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
- * @param [in]  startRegAddr - starting register address.
- * @param [in]  length       - number of registers (bytes) to read.
- * @param [in]  *data        - pointer to data to read.
- * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @return Sample rate in Hz.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    15.05.2021
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void BSP_MPU9150_readMultiReg(BSP_MPU9150_device_S *inDevice,
-        uint8_t startRegAddr,
-        const uint8_t length,
-        uint8_t *data,
-        BSP_MPU9150_err_E *outErr) {
+uint16_t BSP_MPU9150_getOutputRate(const BSP_MPU9150_device_S *inDevice) {
 
-    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
-#if (DEPRECATED_TWI == false)
-    uint32_t err_code;
-    volatile uint32_t timeout = BSP_MPU9150_TWI_TIMEOUT;
-#endif // (DEPRECATED_TWI == false)
-
-#if (DEPRECATED_TWI == false)
-    // after first START condition send |SLAVE_ADDR+W|START_REG_ADDR|
-    err_code = nrf_drv_twi_tx(inDevice->twiInstance,
+    return inDevice->config->sampleRateHz;
+}
+
+/***********************************************************************************************//**
+ * @brief Starts putting MPU-9150 into accelerometer only low power mode with motion wake-up interrupt.
+ * @details Gyroscopes are put to standby and accelerometer is sampled in cycle mode at configured
+ *          wake-up rate. Accelerometer sample at the time of the call is held as reference, INT pin
+ *          signals when acceleration change exceeds configured threshold for configured duration.
+ *          FIFO and I2C master (magnetometer polling) are stopped. Entry is finished by
+ *          BSP_MPU9150_lowPowerStep, which has to be called after returned wait time elapses.
+ *          Must not be called while asynchronous read or low power mode transition is in progress.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outWaitMs   - time to wait before BSP_MPU9150_lowPowerStep (ms).
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_MPU9150_enterLowPowerMode(BSP_MPU9150_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    BSP_MPU9150_accConfigReg_U accConfigReg = { .R = 0u };
+    BSP_MPU9150_motDetectCtrlReg_U motDetectCtrlReg = { .R = 0u };
+    BSP_MPU9150_intEnableReg_U intEnableReg = { .R = 0u };
+    uint32_t motionThreshold = 0u;
+    uint32_t waitMs = 0u;
+
+    if(inDevice != NULL) {
+        motionThreshold = (inDevice->config->motionThresholdMg + (BSP_MPU9150_MOT_THR_MG_PER_LSB / 2u)) /
+                BSP_MPU9150_MOT_THR_MG_PER_LSB;
+        if(motionThreshold == 0u) {
+            motionThreshold = 1u;
+        } else if(motionThreshold > BSP_MPU9150_MOT_THR_MAX) {
+            motionThreshold = BSP_MPU9150_MOT_THR_MAX;
+        }
+
+        // high pass filter runs shortly before current sample is held as reference
+        accConfigReg.B.afsSel = (uint8_t) inDevice->config->accRange;
+        accConfigReg.B.accelHpf = BSP_MPU9150_accHpf_5Hz;
+        motDetectCtrlReg.B.accelOnDelay = BSP_MPU9150_ACCEL_ON_DELAY_MS;
+        intEnableReg.B.motEn = true;
+
+        // register address and value pairs, written in order
+        const uint8_t regWrites[][BSP_MPU9150_TWI_TX_SIZE] = {
+            { BSP_MPU9150_REG_INT_ENABLE,           0u },
+            { BSP_MPU9150_REG_USER_CTRL,            0u },
+            { BSP_MPU9150_REG_ACCEL_CONFIG,         accConfigReg.R },
+            { BSP_MPU9150_REG_MOT_THR,              (uint8_t) motionThreshold },
+            { BSP_MPU9150_REG_MOT_DUR,              inDevice->config->motionDurationMs },
+            { BSP_MPU9150_REG_MOT_DETECT_CTRL,      motDetectCtrlReg.R },
+            { BSP_MPU9150_REG_INT_ENABLE,           intEnableReg.R },
+        };
+
+        for(uint8_t i = 0u; (i < (sizeof(regWrites) / sizeof(regWrites[0]))) && (err == BSP_MPU9150_err_NONE); i++) {
+            BSP_MPU9150_writeSingleReg(inDevice,
+                    regWrites[i][0],
+                    regWrites[i][1],
+                    &err);
+        }
+
+        if(err == BSP_MPU9150_err_NONE) {
+            // reference is held once high pass filter settles
+            inDevice->lpState = BSP_MPU9150_lpState_ENTERING;
+            waitMs = BSP_MPU9150_HPF_SETTLE_TIME_MS;
+        }
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
+    }
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = waitMs;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Starts returning MPU-9150 from low power mode to sampling with configured rate.
+ * @details All sensors are powered up and clocked from gyroscope PLL again. Interrupts, FIFO and
+ *          I2C master are restored by BSP_MPU9150_lowPowerStep, which has to be called after
+ *          returned wait time elapses. Gyroscope needs some time to start up, so first frames may
+ *          have lower gyroscope values. Must not be called while asynchronous read or low power
+ *          mode transition is in progress.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outWaitMs   - time to wait before BSP_MPU9150_lowPowerStep (ms).
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_MPU9150_exitLowPowerMode(BSP_MPU9150_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    uint32_t waitMs = 0u;
+
+    if(inDevice != NULL) {
+        BSP_MPU9150_writeSingleReg(inDevice,
+                BSP_MPU9150_REG_PWR_MGMT_1,
+                BSP_MPU9150_PLL_REFERENCE_VALUE,
+                &err);
+
+        if(err == BSP_MPU9150_err_NONE) {
+            BSP_MPU9150_writeSingleReg(inDevice,
+                    BSP_MPU9150_REG_PWR_MGMT_2,
+                    0u,
+                    &err);
+        }
+
+        if(err == BSP_MPU9150_err_NONE) {
+            inDevice->lpState = BSP_MPU9150_lpState_EXITING;
+            waitMs = BSP_MPU9150_PLL_SETTLE_TIME_MS;
+        }
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
+    }
+
+    if(outWaitMs != NULL) {
+        *outWaitMs = waitMs;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Finishes low power mode entry or exit, once wait time returned by it elapsed.
+ * @details Transition state is cleared even on error, device then stays in mode it was in before.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_MPU9150_lowPowerStep(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    BSP_MPU9150_accConfigReg_U accConfigReg = { .R = 0u };
+    BSP_MPU9150_pwrMgmt1Reg_U pwrMgmt1Reg = { .R = 0u };
+    BSP_MPU9150_pwrMgmt2Reg_U pwrMgmt2Reg = { .R = 0u };
+#if (BSP_MPU9150_FIFO_MODE == false) && (BSP_MPU9150_MAG_MODE == true)
+    BSP_MPU9150_userCtrlReg_U userCtrlReg = { .R = 0u };
+#endif
+
+    if(inDevice == NULL) {
+        err = BSP_MPU9150_err_NULL_PARAM;
+    } else if(inDevice->lpState == BSP_MPU9150_lpState_ENTERING) {
+        accConfigReg.B.afsSel = (uint8_t) inDevice->config->accRange;
+        accConfigReg.B.accelHpf = BSP_MPU9150_accHpf_HOLD;
+        BSP_MPU9150_writeSingleReg(inDevice,
+                BSP_MPU9150_REG_ACCEL_CONFIG,
+                accConfigReg.R,
+                &err);
+
+        if(err == BSP_MPU9150_err_NONE) {
+            pwrMgmt2Reg.B.lpWakeCtrl = (uint8_t) inDevice->config->lpWakeRate;
+            pwrMgmt2Reg.B.stbyXg = true;
+            pwrMgmt2Reg.B.stbyYg = true;
+            pwrMgmt2Reg.B.stbyZg = true;
+
+            BSP_MPU9150_writeSingleReg(inDevice,
+                    BSP_MPU9150_REG_PWR_MGMT_2,
+                    pwrMgmt2Reg.R,
+                    &err);
+        }
+
+        if(err == BSP_MPU9150_err_NONE) {
+            // gyroscope PLL is not available in standby, internal oscillator is used
+            pwrMgmt1Reg.B.clkSel = 0u;
+            pwrMgmt1Reg.B.tempDis = true;
+            pwrMgmt1Reg.B.cycle = true;
+
+            BSP_MPU9150_writeSingleReg(inDevice,
+                    BSP_MPU9150_REG_PWR_MGMT_1,
+                    pwrMgmt1Reg.R,
+                    &err);
+        }
+
+        if(err == BSP_MPU9150_err_NONE) {
+            inDevice->lowPowerMode = true;
+        }
+    } else if(inDevice->lpState == BSP_MPU9150_lpState_EXITING) {
+        // rewriting ranges puts motion detection high pass filter back to reset
+        BSP_MPU9150_writeRanges(inDevice,
+                inDevice->config->gyroRange,
+                inDevice->config->accRange,
+                &err);
+
+        if(err == BSP_MPU9150_err_NONE) {
+            BSP_MPU9150_writeIntEnable(inDevice, &err);
+        }
+
+#if (BSP_MPU9150_FIFO_MODE == true)
+        if(err == BSP_MPU9150_err_NONE) {
+            BSP_MPU9150_resetFifo(inDevice, &err);
+        }
+#elif (BSP_MPU9150_MAG_MODE == true)
+        if(err == BSP_MPU9150_err_NONE) {
+            userCtrlReg.B.i2cMstEn = true;
+            BSP_MPU9150_writeSingleReg(inDevice,
+                    BSP_MPU9150_REG_USER_CTRL,
+                    userCtrlReg.R,
+                    &err);
+        }
+#endif
+
+        if(err == BSP_MPU9150_err_NONE) {
+            inDevice->lowPowerMode = false;
+        }
+    } else {
+        // no transition in progress
+    }
+
+    if(inDevice != NULL) {
+        inDevice->lpState = BSP_MPU9150_lpState_IDLE;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Checks if accelerometer values in frame moved away from motion reference.
+ * @details Works on raw counts, so it does not depend on conversion mode. Motion is reported when
+ *          any axis differs from reference by more than configured threshold, frame then becomes
+ *          new reference. Slow drift within threshold is therefore not reported as motion, while
+ *          change of orientation is.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [in]  *inFrame     - pointer to raw frame, as read from sensor registers or FIFO buffer.
+ ***************************************************************************************************
+ * @return true if motion is detected (or there was no reference yet), false otherwise.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+bool BSP_MPU9150_detectMotion(BSP_MPU9150_device_S *inDevice, const BSP_MPU9150_rawFrame_S *inFrame) {
+
+    bool isMotion = (inDevice->motionRefValid == false);
+    int16_t acc[3];
+
+    for(uint8_t i = 0u; i < 3u; i++) {
+        // accelerometer data is first in frame, MSB first
+        acc[i] = (int16_t) (inFrame->data[(2u * i) + 1u] + (inFrame->data[2u * i] << 8u));
+
+        int32_t diff = (int32_t) acc[i] - inDevice->motionRef[i];
+        if((diff > inDevice->motionThresholdCounts) || (diff < -inDevice->motionThresholdCounts)) {
+            isMotion = true;
+        }
+    }
+
+    if(isMotion == true) {
+        inDevice->motionRef[0] = acc[0];
+        inDevice->motionRef[1] = acc[1];
+        inDevice->motionRef[2] = acc[2];
+        inDevice->motionRefValid = true;
+    }
+
+    return isMotion;
+}
+
+/***********************************************************************************************//**
+ * @brief Starts non-blocking read of accelerometer, temperature and gyroscope registers.
+ * @details Register address and data read are chained in TWI event handler, handler is called with
+ *          frame count 1 when frame is read, or with error on NACK or timeout.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outFrame   - pointer to raw frame, has to stay valid until handler is called.
+ * @param [in]  handler     - called from interrupt context when read finishes.
+ * @param [in]  *context    - passed to handler.
+ * @param [out] *outErr     - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_MPU9150_readFrameAsync(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_rawFrame_S *outFrame,
+        BSP_MPU9150_readHandler handler,
+        void *context,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+
+    if((inDevice != NULL) && (outFrame != NULL)) {
+        BSP_MPU9150_startRegRead(inDevice,
+                inDevice->config->mpuAddress,
+                BSP_MPU9150_REG_ACCEL_XOUT_H,
+                BSP_MPU9150_READ_DATA_SIZE_IN_BYTES,
+                &outFrame->data[0],
+                handler,
+                context,
+                &err);
+
+        if(err == BSP_MPU9150_err_NONE) {
+            inDevice->twiTransfer.frameCount = 1u;
+        }
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Starts non-blocking read of all whole frames stored in MPU-9150 FIFO buffer.
+ * @details FIFO count is read first, then up to maxFrames frames are read from FIFO_R_W in single
+ *          burst. Both steps are chained in TWI event handler, handler is called with number of
+ *          frames read (can be 0), or with error on NACK or timeout.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outFrames  - pointer to array of maxFrames raw frames, has to stay valid until handler is called.
+ * @param [in]  maxFrames   - max number of frames to read, up to BSP_MPU9150_FIFO_MAX_BURST_FRAMES.
+ * @param [in]  handler     - called from interrupt context when read finishes.
+ * @param [in]  *context    - passed to handler.
+ * @param [out] *outErr     - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void BSP_MPU9150_readFifoFramesAsync(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_rawFrame_S *outFrames,
+        uint8_t maxFrames,
+        BSP_MPU9150_readHandler handler,
+        void *context,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+
+    if((inDevice != NULL) && (outFrames != NULL)) {
+        if((maxFrames == 0u) || (maxFrames > BSP_MPU9150_FIFO_MAX_BURST_FRAMES)) {
+            err = BSP_MPU9150_err_INVALID_PARAM;
+        }
+
+        if(err == BSP_MPU9150_err_NONE) {
+            BSP_MPU9150_beginTransfer(inDevice, inDevice->config->mpuAddress, handler, context, &err);
+        }
+
+        if(err == BSP_MPU9150_err_NONE) {
+            // frames buffer is kept in rxData while FIFO count is read
+            inDevice->twiTransfer.txData[0] = BSP_MPU9150_REG_FIFO_COUNTH;
+            inDevice->twiTransfer.rxData = &outFrames[0].data[0];
+            inDevice->twiTransfer.maxFrames = maxFrames;
+            inDevice->twiTransfer.fifoCountStage = true;
+
+            BSP_MPU9150_sendRegAddress(inDevice);
+        }
+    } else {
+        err = BSP_MPU9150_err_NULL_PARAM;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief TWI event handler, advances current transfer to its next step.
+ ***************************************************************************************************
+ * @param [in]  *p_event    - TWI driver event.
+ * @param [in]  *p_context  - pointer to device structure for MPU-9150 driver.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void nrf_drv_mpu_twi_event_handler(nrf_drv_twi_evt_t const * p_event, void * p_context) {
+
+    BSP_MPU9150_device_S *inDevice = (BSP_MPU9150_device_S *) p_context;
+    BSP_MPU9150_twiTransfer_S *transfer = &inDevice->twiTransfer;
+    uint32_t err_code = NRF_SUCCESS;
+
+    if(p_event->type != NRF_DRV_TWI_EVT_DONE) {
+        // address or data NACK, no point in continuing transfer
+        if(inDevice->twiState != BSP_MPU9150_twiState_IDLE) {
+            BSP_MPU9150_finishTransfer(inDevice, BSP_MPU9150_err_I2C_READ_WRITE);
+        }
+    } else {
+        switch(inDevice->twiState) {
+            case BSP_MPU9150_twiState_WRITE:
+                BSP_MPU9150_finishTransfer(inDevice, BSP_MPU9150_err_NONE);
+                break;
+            case BSP_MPU9150_twiState_READ_ADDRESS:
+                // TWI is suspended after register address, so read starts with repeated START
+                inDevice->twiState = BSP_MPU9150_twiState_READ_DATA;
+                if(transfer->fifoCountStage == true) {
+                    err_code = nrf_drv_twi_rx(inDevice->twiInstance,
+                            transfer->address,
+                            &transfer->fifoCount[0],
+                            BSP_MPU9150_FIFO_COUNT_SIZE);
+                } else {
+                    err_code = nrf_drv_twi_rx(inDevice->twiInstance,
+                            transfer->address,
+                            transfer->rxData,
+                            transfer->rxLength);
+                }
+
+                if(err_code != NRF_SUCCESS) {
+                    BSP_MPU9150_finishTransfer(inDevice, BSP_MPU9150_err_I2C_READ_WRITE);
+                }
+                break;
+            case BSP_MPU9150_twiState_READ_DATA:
+                if(transfer->fifoCountStage == true) {
+                    BSP_MPU9150_startFifoDataRead(inDevice);
+                } else {
+                    BSP_MPU9150_finishTransfer(inDevice, BSP_MPU9150_err_NONE);
+                }
+                break;
+            default:
+                // late event of transfer that was already aborted on timeout
+                break;
+        }
+    }
+}
+
+/***************************************************************************************************
+ *                          PRIVATE FUNCTION DEFINITIONS
+ **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Function for writing to single register of MPU9150.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [in]  regAddr      - register address.
+ * @param [in]  regData      - data to be sent.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    15.05.2021
+ **************************************************************************************************/
+static void BSP_MPU9150_writeSingleReg(BSP_MPU9150_device_S *inDevice,
+        uint8_t regAddr,
+        const uint8_t regData,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+
+    BSP_MPU9150_startRegWrite(inDevice, inDevice->config->mpuAddress, regAddr, regData, &err);
+
+    if(err == BSP_MPU9150_err_NONE) {
+        BSP_MPU9150_waitTransfer(inDevice, &err);
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function for writing to single register of MPU9150 magnetometer.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [in]  regAddr      - register address.
+ * @param [in]  regData      - data to be sent.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    15.05.2021
+ **************************************************************************************************/
+static void BSP_MPU9150_writeSingleMagReg(BSP_MPU9150_device_S *inDevice,
+        uint8_t regAddr,
+        const uint8_t regData,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+
+    BSP_MPU9150_startRegWrite(inDevice, inDevice->config->mpuMagAddress, regAddr, regData, &err);
+
+    if(err == BSP_MPU9150_err_NONE) {
+        BSP_MPU9150_waitTransfer(inDevice, &err);
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function for reading from single register of MPU9150.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [in]  regAddr      - register address.
+ * @param [in]  *data        - pointer to data to read.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    15.05.2021
+ **************************************************************************************************/
+static void BSP_MPU9150_readSingleReg(BSP_MPU9150_device_S *inDevice,
+        uint8_t regAddr,
+        uint8_t *data,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_readMultiReg(inDevice, regAddr, 1u, data, outErr);
+}
+
+/***********************************************************************************************//**
+ * @brief Function for reading from single register of MPU9150 magnetometer sensor.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for ECG driver.
+ * @param [in]  regAddr      - register address.
+ * @param [in]  *data        - pointer to data to read.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    15.05.2021
+ **************************************************************************************************/
+void BSP_MPU9150_readSingleMagReg(BSP_MPU9150_device_S *inDevice,
+        uint8_t regAddr,
+        uint8_t *data,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_readMultiMagReg(inDevice, regAddr, 1u, data, outErr);
+}
+
+/***********************************************************************************************//**
+ * @brief Function for reading from multiple successive registers of MPU9150 magnetometer.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [in]  startRegAddr - starting register address.
+ * @param [in]  length       - number of registers (bytes) to read.
+ * @param [in]  *data        - pointer to data to read.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    15.05.2021
+ **************************************************************************************************/
+void BSP_MPU9150_readMultiMagReg(BSP_MPU9150_device_S *inDevice,
+        uint8_t startRegAddr,
+        const uint8_t length,
+        uint8_t *data,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+
+    BSP_MPU9150_startRegRead(inDevice,
+            inDevice->config->mpuMagAddress,
+            startRegAddr,
+            length,
+            data,
+            NULL,
+            NULL,
+            &err);
+
+    if(err == BSP_MPU9150_err_NONE) {
+        BSP_MPU9150_waitTransfer(inDevice, &err);
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function for reading from multiple successive registers of MPU9150.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [in]  startRegAddr - starting register address.
+ * @param [in]  length       - number of registers (bytes) to read.
+ * @param [in]  *data        - pointer to data to read.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    15.05.2021
+ **************************************************************************************************/
+static void BSP_MPU9150_readMultiReg(BSP_MPU9150_device_S *inDevice,
+        uint8_t startRegAddr,
+        const uint8_t length,
+        uint8_t *data,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+
+    BSP_MPU9150_startRegRead(inDevice,
             inDevice->config->mpuAddress,
-            &startRegAddr,
-            1u,
-            false);
+            startRegAddr,
+            length,
+            data,
+            NULL,
+            NULL,
+            &err);
+
+    if(err == BSP_MPU9150_err_NONE) {
+        BSP_MPU9150_waitTransfer(inDevice, &err);
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Takes TWI bus for new transfer and arms transfer timeout.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ * @param [in]  address     - I2C address of accessed device.
+ * @param [in]  handler     - called when transfer finishes, NULL for blocking transfers.
+ * @param [in]  *context    - passed to handler.
+ * @param [out] *outErr     - error parameter, BUSY if another transfer is in progress.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_beginTransfer(BSP_MPU9150_device_S *inDevice,
+        uint8_t address,
+        BSP_MPU9150_readHandler handler,
+        void *context,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    BSP_MPU9150_twiTransfer_S *transfer = &inDevice->twiTransfer;
+
+    CRITICAL_REGION_ENTER();
+    if(inDevice->twiState != BSP_MPU9150_twiState_IDLE) {
+        err = BSP_MPU9150_err_BUSY;
+    } else {
+        // any state other than IDLE reserves the bus, actual state is set when transfer starts
+        inDevice->twiState = BSP_MPU9150_twiState_WRITE;
+    }
+    CRITICAL_REGION_EXIT();
+
+    if(err == BSP_MPU9150_err_NONE) {
+        transfer->address = address;
+        transfer->rxData = NULL;
+        transfer->rxLength = 0u;
+        transfer->maxFrames = 0u;
+        transfer->frameCount = 0u;
+        transfer->fifoCountStage = false;
+        transfer->err = BSP_MPU9150_err_NONE;
+        transfer->handler = handler;
+        transfer->context = context;
+
+        transfer->startTicks = app_timer_cnt_get();
+        (void) app_timer_start(mpuTwiTimeoutTimerId, BSP_MPU9150_TWI_TIMEOUT_TICKS, inDevice);
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Starts writing single register value.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ * @param [in]  address     - I2C address of accessed device.
+ * @param [in]  regAddr     - register address.
+ * @param [in]  regData     - data to be sent.
+ * @param [out] *outErr     - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_startRegWrite(BSP_MPU9150_device_S *inDevice,
+        uint8_t address,
+        uint8_t regAddr,
+        uint8_t regData,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    BSP_MPU9150_twiTransfer_S *transfer = &inDevice->twiTransfer;
+
+    BSP_MPU9150_beginTransfer(inDevice, address, NULL, NULL, &err);
+
+    if(err == BSP_MPU9150_err_NONE) {
+        // assemble I2C data - 1 byte register address, 1 byte data
+        transfer->txData[0] = regAddr;
+        transfer->txData[1] = regData;
+        inDevice->twiState = BSP_MPU9150_twiState_WRITE;
+
+        if(nrf_drv_twi_tx(inDevice->twiInstance,
+                address,
+                &transfer->txData[0],
+                BSP_MPU9150_SINGLE_REG_MSG_SIZE,
+                false) != NRF_SUCCESS) {
+            BSP_MPU9150_finishTransfer(inDevice, BSP_MPU9150_err_I2C_READ_WRITE);
+        }
+    }
 
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
+    if(outErr != NULL) {
+        *outErr = err;
     }
+}
+
+/***********************************************************************************************//**
+ * @brief Starts reading successive registers, data is read in TWI event handler.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [in]  address      - I2C address of accessed device.
+ * @param [in]  startRegAddr - starting register address.
+ * @param [in]  length       - number of registers (bytes) to read.
+ * @param [out] *data        - pointer to data to read.
+ * @param [in]  handler      - called when read finishes, NULL for blocking reads.
+ * @param [in]  *context     - passed to handler.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_startRegRead(BSP_MPU9150_device_S *inDevice,
+        uint8_t address,
+        uint8_t startRegAddr,
+        uint8_t length,
+        uint8_t *data,
+        BSP_MPU9150_readHandler handler,
+        void *context,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+
+    BSP_MPU9150_beginTransfer(inDevice, address, handler, context, &err);
 
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    while((!inDevice->twiTxDone) && --timeout);
+    if(err == BSP_MPU9150_err_NONE) {
+        inDevice->twiTransfer.txData[0] = startRegAddr;
+        inDevice->twiTransfer.rxData = data;
+        inDevice->twiTransfer.rxLength = length;
 
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
+        BSP_MPU9150_sendRegAddress(inDevice);
     }
-    inDevice->twiTxDone = false;
 
-    // after second START condition read in data from registers
-    err_code = nrf_drv_twi_rx(inDevice->twiInstance,
-            inDevice->config->mpuAddress,
-            data,
-            length);
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Sends register address of current read transfer, without STOP condition.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_sendRegAddress(BSP_MPU9150_device_S *inDevice) {
+
+    BSP_MPU9150_twiTransfer_S *transfer = &inDevice->twiTransfer;
 
-    if(err_code != NRF_SUCCESS) {
-        err = BSP_MPU9150_err_I2C_READ_WRITE;
+    inDevice->twiState = BSP_MPU9150_twiState_READ_ADDRESS;
+
+    if(nrf_drv_twi_tx(inDevice->twiInstance,
+            transfer->address,
+            &transfer->txData[0],
+            1u,
+            true) != NRF_SUCCESS) {
+        BSP_MPU9150_finishTransfer(inDevice, BSP_MPU9150_err_I2C_READ_WRITE);
     }
+}
+
+/***********************************************************************************************//**
+ * @brief Continues FIFO read after FIFO count is known, reads whole frames only.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_startFifoDataRead(BSP_MPU9150_device_S *inDevice) {
 
-    // TODO: add proper timeout check with timer
-    // wait for transfer finish or timeout
-    timeout = BSP_MPU9150_TWI_TIMEOUT;
-    while((!inDevice->twiRxDone) && --timeout);
+    BSP_MPU9150_twiTransfer_S *transfer = &inDevice->twiTransfer;
+    uint16_t frameCount = 0u;
 
-    if(!timeout) {
-        err = BSP_MPU9150_err_I2C_TIMEOUT;
+    // partially written frame stays in FIFO until next read
+    frameCount = ((transfer->fifoCount[0] << 8u) | transfer->fifoCount[1]) / BSP_MPU9150_FRAME_SIZE;
+    if(frameCount > transfer->maxFrames) {
+        frameCount = transfer->maxFrames;
     }
-    inDevice->twiRxDone = false;
 
-#else
-    // TX first the register address with write bit
-    err = twi_master_transfer((inDevice->config->mpuAddress << 1u) | 0u, &startRegAddr, 1u, false);
+    transfer->fifoCountStage = false;
+    transfer->frameCount = (uint8_t) frameCount;
 
-    // RX data from register
-    err &= twi_master_transfer((inDevice->config->mpuAddress << 1u) | 1u, data, length, true);
+    if(frameCount == 0u) {
+        BSP_MPU9150_finishTransfer(inDevice, BSP_MPU9150_err_NONE);
+    } else {
+        // FIFO_R_W register address is not incremented, every byte read pops one FIFO byte
+        transfer->txData[0] = BSP_MPU9150_REG_FIFO_R_W;
+        transfer->rxLength = (uint8_t) (frameCount * BSP_MPU9150_FRAME_SIZE);
 
-    err = 1 ? 0 : err;
-#endif
+        BSP_MPU9150_sendRegAddress(inDevice);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Ends current transfer, releases TWI bus and notifies handler.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ * @param [in]  err         - transfer result.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_finishTransfer(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E err) {
+
+    BSP_MPU9150_twiTransfer_S *transfer = &inDevice->twiTransfer;
+    BSP_MPU9150_readHandler handler = transfer->handler;
+
+    (void) app_timer_stop(mpuTwiTimeoutTimerId);
+
+    transfer->err = err;
+    if(err != BSP_MPU9150_err_NONE) {
+        transfer->frameCount = 0u;
+    }
+
+    // bus is released before handler is called, so handler can start next transfer
+    inDevice->twiState = BSP_MPU9150_twiState_IDLE;
+
+    if(handler != NULL) {
+        handler(err, transfer->frameCount, transfer->context);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Waits for current blocking transfer to finish.
+ * @details Wait always ends, either in TWI event handler or in transfer timeout handler, so it must
+ *          not be called from interrupt with priority equal or higher than those.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outErr     - transfer result.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_waitTransfer(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr) {
+
+    while(inDevice->twiState != BSP_MPU9150_twiState_IDLE) {
+    }
 
     if(outErr != NULL) {
-        *outErr = err;
+        *outErr = inDevice->twiTransfer.err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Recovers TWI bus after stuck transfer.
+ * @details TWI peripheral is re-initialized, with up to 9 SCL clocks sent first so that slave
+ *          holding SDA low can finish its byte and release the bus.
+ ***************************************************************************************************
+ * @param [in]  *inDevice   - pointer to device structure for MPU-9150 driver.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_recoverBus(BSP_MPU9150_device_S *inDevice) {
+
+    nrf_drv_twi_config_t recoveryConfig = *inDevice->twiConfig;
+
+    recoveryConfig.clear_bus_init = true;
+
+    nrf_drv_twi_uninit(inDevice->twiInstance);
+    (void) nrf_drv_twi_init(inDevice->twiInstance, &recoveryConfig, nrf_drv_mpu_twi_event_handler, inDevice);
+    nrf_drv_twi_enable(inDevice->twiInstance);
+}
+
+/***********************************************************************************************//**
+ * @brief Application timer callback, aborts transfer that did not finish in time.
+ * @details Expiry armed for already finished transfer only re-arms timer for rest of current one.
+ ***************************************************************************************************
+ * @param [in]  *context    - pointer to device structure for MPU-9150 driver.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_twiTimeoutHandler(void *context) {
+
+    BSP_MPU9150_device_S *inDevice = (BSP_MPU9150_device_S *) context;
+    uint32_t elapsedTicks = 0u;
+    uint32_t remainingTicks = 0u;
+
+    if(inDevice->twiState != BSP_MPU9150_twiState_IDLE) {
+        (void) app_timer_cnt_diff_compute(app_timer_cnt_get(),
+                inDevice->twiTransfer.startTicks,
+                &elapsedTicks);
+
+        if(elapsedTicks >= BSP_MPU9150_TWI_TIMEOUT_TICKS) {
+            BSP_MPU9150_recoverBus(inDevice);
+            BSP_MPU9150_finishTransfer(inDevice, BSP_MPU9150_err_I2C_TIMEOUT);
+        } else {
+            remainingTicks = BSP_MPU9150_TWI_TIMEOUT_TICKS - elapsedTicks;
+            if(remainingTicks < APP_TIMER_MIN_TIMEOUT_TICKS) {
+                remainingTicks = APP_TIMER_MIN_TIMEOUT_TICKS;
+            }
+            (void) app_timer_start(mpuTwiTimeoutTimerId, remainingTicks, inDevice);
+        }
     }
 }
 
+#if (BSP_MPU9150_CONVERSION_MODE == BSP_MPU9150_CONVERSION_FLOAT)
 /***********************************************************************************************//**
  * @brief Function calculates temperature value in degrees using datasheet conversion function.
  ***************************************************************************************************
@@ -769,63 +1636,263 @@ __INLINE static void BSP_MPU9150_calculateGyroValues(const BSP_MPU9150_device_S
  * @param  [out] *outAcc      - pointer to calculated accelerometer values in G.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    25.05.2021
+ * @date    25.05.2021
+ **************************************************************************************************/
+__INLINE static void BSP_MPU9150_calculateAccValues(const BSP_MPU9150_device_S *inDevice,
+        const uint8_t *rawValue,
+        int16_t *outAcc) {
+
+    int16_t accX = 0;
+    int16_t accY = 0;
+    int16_t accZ = 0;
+
+    float floatAccX = 0.f;
+    float floatAccY = 0.f;
+    float floatAccZ = 0.f;
+
+    accX = rawValue[1] + (rawValue[0] << 8u);
+    accY = rawValue[3] + (rawValue[2] << 8u);
+    accZ = rawValue[5] + (rawValue[4] << 8u);
+
+    // this will give the real (interpreted) value in G
+    switch(inDevice->config->accRange) {
+        default:
+        case BSP_MPU9150_accFsRange_2G:
+            floatAccX = ((float) accX / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_2G_CONST;
+            floatAccY = ((float) accY / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_2G_CONST;
+            floatAccZ = ((float) accZ / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_2G_CONST;
+            break;
+        case BSP_MPU9150_accFsRange_4G:
+            floatAccX = ((float) accX / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_4G_CONST;
+            floatAccY = ((float) accY / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_4G_CONST;
+            floatAccZ = ((float) accZ / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_4G_CONST;
+            break;
+        case BSP_MPU9150_accFsRange_8G:
+            floatAccX = ((float) accX / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_8G_CONST;
+            floatAccY = ((float) accY / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_8G_CONST;
+            floatAccZ = ((float) accZ / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_8G_CONST;
+            break;
+        case BSP_MPU9150_accFsRange_16G:
+            floatAccX = ((float) accX / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_16G_CONST;
+            floatAccY = ((float) accY / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_16G_CONST;
+            floatAccZ = ((float) accZ / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_16G_CONST;
+            break;
+    }
+
+    // output values in mG, that way they can be stored as 16-bit
+    accX = (int16_t) (floatAccX * 1000);
+    accY = (int16_t) (floatAccY * 1000);
+    accZ = (int16_t) (floatAccZ * 1000);
+
+    // X-axis Accelerometer
+    outAcc[0] = accX;
+    // Y-axis Accelerometer
+    outAcc[1] = accY;
+    // Z-axis Accelerometer
+    outAcc[2] = accZ;
+
+}
+
+#elif (BSP_MPU9150_CONVERSION_MODE == BSP_MPU9150_CONVERSION_FIXED)
+/***********************************************************************************************//**
+ * @brief Function calculates temperature value in degrees using datasheet conversion function.
+ ***************************************************************************************************
+ * @param  [in]  rawValue     -   pointer to raw temperature value, read from register.
+ * @param  [out] *outTemp     -   pointer to output temperature data.
+ ***************************************************************************************************
+ * @details Division by 340 is replaced by Q16 multiplication, Cortex-M0 has no divide instruction.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static void BSP_MPU9150_calculateTemperature(const uint8_t *rawValue, int16_t *outTemp) {
+
+    int32_t rawTemp = 0;
+
+    rawTemp = (int16_t) (rawValue[1] + (rawValue[0] << 8u));
+    *outTemp = (int16_t) (((rawTemp * BSP_MPU9150_TEMP_Q16_CONST + BSP_MPU9150_Q16_ROUNDING) >> BSP_MPU9150_Q16_SHIFT)
+            + BSP_MPU9150_TEMP_OFFSET_CONST);
+}
+
+/***********************************************************************************************//**
+ * @brief Function calculates gyroscope value using Q16 fixed point scale constants.
+ ***************************************************************************************************
+ * @param  [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param  [in]  *rawValue    - pointer to raw gyroscope measurements, read from register in bytes.
+ * @param  [out] *outGyro     - pointer to calculated gyroscope values in degree/seconds.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static void BSP_MPU9150_calculateGyroValues(const BSP_MPU9150_device_S *inDevice,
+        const uint8_t *rawValue,
+        int16_t *outGyro) {
+
+    int32_t scale = 0;
+    int32_t gyroX = 0;
+    int32_t gyroY = 0;
+    int32_t gyroZ = 0;
+
+    gyroX = (int16_t) (rawValue[1] + (rawValue[0] << 8u));
+    gyroY = (int16_t) (rawValue[3] + (rawValue[2] << 8u));
+    gyroZ = (int16_t) (rawValue[5] + (rawValue[4] << 8u));
+
+    switch(inDevice->config->gyroRange) {
+        default:
+        case BSP_MPU9150_gyroFsRange_250degS:
+            scale = BSP_MPU9150_GYRO_RANGE_250DEG_Q16;
+            break;
+        case BSP_MPU9150_gyroFsRange_500degS:
+            scale = BSP_MPU9150_GYRO_RANGE_500DEG_Q16;
+            break;
+        case BSP_MPU9150_gyroFsRange_1000degS:
+            scale = BSP_MPU9150_GYRO_RANGE_1000DEG_Q16;
+            break;
+        case BSP_MPU9150_gyroFsRange_2000degS:
+            scale = BSP_MPU9150_GYRO_RANGE_2000DEG_Q16;
+            break;
+    }
+
+    // X-axis Gyro
+    outGyro[0] = (int16_t) ((gyroX * scale + BSP_MPU9150_Q16_ROUNDING) >> BSP_MPU9150_Q16_SHIFT);
+    // Y-axis Gyro
+    outGyro[1] = (int16_t) ((gyroY * scale + BSP_MPU9150_Q16_ROUNDING) >> BSP_MPU9150_Q16_SHIFT);
+    // Z-axis Gyro
+    outGyro[2] = (int16_t) ((gyroZ * scale + BSP_MPU9150_Q16_ROUNDING) >> BSP_MPU9150_Q16_SHIFT);
+}
+
+/***********************************************************************************************//**
+ * @brief Function calculates accelerometer value using Q16 fixed point scale constants.
+ ***************************************************************************************************
+ * @param  [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param  [in]  *rawValue    - pointer to raw accelerometer measurements, read from register in bytes.
+ * @param  [out] *outAcc      - pointer to calculated accelerometer values in mG.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static void BSP_MPU9150_calculateAccValues(const BSP_MPU9150_device_S *inDevice,
+        const uint8_t *rawValue,
+        int16_t *outAcc) {
+
+    int32_t scale = 0;
+    int32_t accX = 0;
+    int32_t accY = 0;
+    int32_t accZ = 0;
+
+    accX = (int16_t) (rawValue[1] + (rawValue[0] << 8u));
+    accY = (int16_t) (rawValue[3] + (rawValue[2] << 8u));
+    accZ = (int16_t) (rawValue[5] + (rawValue[4] << 8u));
+
+    switch(inDevice->config->accRange) {
+        default:
+        case BSP_MPU9150_accFsRange_2G:
+            scale = BSP_MPU9150_ACC_RANGE_2G_Q16;
+            break;
+        case BSP_MPU9150_accFsRange_4G:
+            scale = BSP_MPU9150_ACC_RANGE_4G_Q16;
+            break;
+        case BSP_MPU9150_accFsRange_8G:
+            scale = BSP_MPU9150_ACC_RANGE_8G_Q16;
+            break;
+        case BSP_MPU9150_accFsRange_16G:
+            scale = BSP_MPU9150_ACC_RANGE_16G_Q16;
+            break;
+    }
+
+    // X-axis Accelerometer
+    outAcc[0] = (int16_t) ((accX * scale + BSP_MPU9150_Q16_ROUNDING) >> BSP_MPU9150_Q16_SHIFT);
+    // Y-axis Accelerometer
+    outAcc[1] = (int16_t) ((accY * scale + BSP_MPU9150_Q16_ROUNDING) >> BSP_MPU9150_Q16_SHIFT);
+    // Z-axis Accelerometer
+    outAcc[2] = (int16_t) ((accZ * scale + BSP_MPU9150_Q16_ROUNDING) >> BSP_MPU9150_Q16_SHIFT);
+}
+
+#else
+/***********************************************************************************************//**
+ * @brief Function assembles raw temperature counts, conversion is left to the receiver.
+ ***************************************************************************************************
+ * @param  [in]  rawValue     -   pointer to raw temperature value, read from register.
+ * @param  [out] *outTemp     -   pointer to output raw temperature counts.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static void BSP_MPU9150_calculateTemperature(const uint8_t *rawValue, int16_t *outTemp) {
+
+    *outTemp = (int16_t) (rawValue[1] + (rawValue[0] << 8u));
+}
+
+/***********************************************************************************************//**
+ * @brief Function assembles raw gyroscope counts, conversion is left to the receiver.
+ ***************************************************************************************************
+ * @param  [in]  *inDevice    - pointer to device structure for MPU-9150 driver (not used).
+ * @param  [in]  *rawValue    - pointer to raw gyroscope measurements, read from register in bytes.
+ * @param  [out] *outGyro     - pointer to output raw gyroscope counts.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static void BSP_MPU9150_calculateGyroValues(const BSP_MPU9150_device_S *inDevice,
+        const uint8_t *rawValue,
+        int16_t *outGyro) {
+
+    (void) inDevice;
+
+    // X-axis Gyro
+    outGyro[0] = (int16_t) (rawValue[1] + (rawValue[0] << 8u));
+    // Y-axis Gyro
+    outGyro[1] = (int16_t) (rawValue[3] + (rawValue[2] << 8u));
+    // Z-axis Gyro
+    outGyro[2] = (int16_t) (rawValue[5] + (rawValue[4] << 8u));
+}
+
+/***********************************************************************************************//**
+ * @brief Function assembles raw accelerometer counts, conversion is left to the receiver.
+ ***************************************************************************************************
+ * @param  [in]  *inDevice    - pointer to device structure for MPU-9150 driver (not used).
+ * @param  [in]  *rawValue    - pointer to raw accelerometer measurements, read from register in bytes.
+ * @param  [out] *outAcc      - pointer to output raw accelerometer counts.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
  **************************************************************************************************/
 __INLINE static void BSP_MPU9150_calculateAccValues(const BSP_MPU9150_device_S *inDevice,
         const uint8_t *rawValue,
         int16_t *outAcc) {
 
-    int16_t accX = 0;
-    int16_t accY = 0;
-    int16_t accZ = 0;
-
-    float floatAccX = 0.f;
-    float floatAccY = 0.f;
-    float floatAccZ = 0.f;
-
-    accX = rawValue[1] + (rawValue[0] << 8u);
-    accY = rawValue[3] + (rawValue[2] << 8u);
-    accZ = rawValue[5] + (rawValue[4] << 8u);
-
-    // this will give the real (interpreted) value in G
-    switch(inDevice->config->accRange) {
-        default:
-        case BSP_MPU9150_accFsRange_2G:
-            floatAccX = ((float) accX / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_2G_CONST;
-            floatAccY = ((float) accY / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_2G_CONST;
-            floatAccZ = ((float) accZ / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_2G_CONST;
-            break;
-        case BSP_MPU9150_accFsRange_4G:
-            floatAccX = ((float) accX / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_4G_CONST;
-            floatAccY = ((float) accY / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_4G_CONST;
-            floatAccZ = ((float) accZ / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_4G_CONST;
-            break;
-        case BSP_MPU9150_accFsRange_8G:
-            floatAccX = ((float) accX / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_8G_CONST;
-            floatAccY = ((float) accY / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_8G_CONST;
-            floatAccZ = ((float) accZ / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_8G_CONST;
-            break;
-        case BSP_MPU9150_accFsRange_16G:
-            floatAccX = ((float) accX / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_16G_CONST;
-            floatAccY = ((float) accY / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_16G_CONST;
-            floatAccZ = ((float) accZ / BSP_MPU9150_16_BIT_SIGNED_MAX_VAL_FLOAT) * BSP_MPU9150_ACC_RANGE_16G_CONST;
-            break;
-    }
-
-    // output values in mG, that way they can be stored as 16-bit
-    accX = (int16_t) (floatAccX * 1000);
-    accY = (int16_t) (floatAccY * 1000);
-    accZ = (int16_t) (floatAccZ * 1000);
+    (void) inDevice;
 
     // X-axis Accelerometer
-    outAcc[0] = accX;
+    outAcc[0] = (int16_t) (rawValue[1] + (rawValue[0] << 8u));
     // Y-axis Accelerometer
-    outAcc[1] = accY;
+    outAcc[1] = (int16_t) (rawValue[3] + (rawValue[2] << 8u));
     // Z-axis Accelerometer
-    outAcc[2] = accZ;
+    outAcc[2] = (int16_t) (rawValue[5] + (rawValue[4] << 8u));
+}
+
+/***********************************************************************************************//**
+ * @brief Function returns descriptor of currently configured full-scale ranges.
+ ***************************************************************************************************
+ * @param  [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ ***************************************************************************************************
+ * @return Range descriptor, sent along raw counts.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static int16_t BSP_MPU9150_getRangeDescriptor(const BSP_MPU9150_device_S *inDevice) {
+
+    BSP_MPU9150_rangeDescriptor_U descriptor = { .R = 0u };
+
+    descriptor.B.accRange = inDevice->config->accRange;
+    descriptor.B.gyroRange = inDevice->config->gyroRange;
 
+    return (int16_t) descriptor.R;
 }
 
+#endif // #if (BSP_MPU9150_CONVERSION_MODE == BSP_MPU9150_CONVERSION_FLOAT)
+
 /***********************************************************************************************//**
  * @brief Function calculates temperature value in degrees using datasheet conversion function.
  ***************************************************************************************************
@@ -842,15 +1909,15 @@ __INLINE static void BSP_MPU9150_packDataToSend(const int16_t *gyroVals,
         const int16_t temp,
         int16_t *outBuffer) {
 
-    outBuffer[0] = gyroVals[0];
-    outBuffer[1] = gyroVals[1];
-    outBuffer[2] = gyroVals[2];
+    outBuffer[BSP_MPU9150_GYRO_DATA_INDEX] = gyroVals[0];
+    outBuffer[BSP_MPU9150_GYRO_DATA_INDEX + 1u] = gyroVals[1];
+    outBuffer[BSP_MPU9150_GYRO_DATA_INDEX + 2u] = gyroVals[2];
 
-    outBuffer[3] = accVals[0];
-    outBuffer[4] = accVals[1];
-    outBuffer[5] = accVals[2];
+    outBuffer[BSP_MPU9150_ACC_DATA_INDEX] = accVals[0];
+    outBuffer[BSP_MPU9150_ACC_DATA_INDEX + 1u] = accVals[1];
+    outBuffer[BSP_MPU9150_ACC_DATA_INDEX + 2u] = accVals[2];
 
-    outBuffer[6] = temp;
+    outBuffer[BSP_MPU9150_TEMP_DATA_INDEX] = temp;
 }
 
 /***********************************************************************************************//**
@@ -865,49 +1932,32 @@ __INLINE static void BSP_MPU9150_packDataToSend(const int16_t *gyroVals,
 static void BSP_MPU9150_configuration(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr) {
 
     BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
-    BSP_MPU9150_configReg_U configRegVal = { .R = 0u };
-    BSP_MPU9150_gyroConfigReg_U gyroConfigReg = { .R = 0u };
-    BSP_MPU9150_accConfigReg_U accConfigReg = { .R = 0u };
     BSP_MPU9150_intConfigReg_U intConfigReg = { .R = 0u };
     BSP_MPU9150_fifoConfigReg_U fifoConfigReg = { .R = 0u };
-    BSP_MPU9150_intEnableReg_U intEnableReg = { .R = 0u };
 
     if(inDevice != NULL) {
         /*
-         * Sample Rate = Gyroscope Output Rate / (1 + SMPLRT_DIV), where Gyroscope Output Rate
-         * can be either 8kHz when DLPF is disabled, or 1kHz when DLPF is enabled
+         * Configuration register sets up DLPF, which also selects gyroscope output rate that
+         * sample rate is divided from
          */
+        BSP_MPU9150_writeDlpf(inDevice, inDevice->config->dlpf, &err);
 
-        // worked with 199, 143
-        uint8_t samplingRateRegVal = 9u;
-        BSP_MPU9150_writeSingleReg(inDevice,
-                BSP_MPU9150_REG_SMPLRT_DIV,
-                samplingRateRegVal,
-                &err);
-
-        /*
-         * Configuration register sets up DLPF and sampling of External FSYNC pin
-         */
         if(err == BSP_MPU9150_err_NONE ) {
-            // sets DLPF value
-            configRegVal.B.dlpfCfg = 2u;
-            configRegVal.B.extSyncSet = false;
-
-            BSP_MPU9150_writeSingleReg(inDevice,
-                    BSP_MPU9150_REG_CONFIG,
-                    configRegVal.R,
-                    &err);
+            BSP_MPU9150_writeSampleRate(inDevice, inDevice->config->sampleRateHz, &err);
         }
 
         /*
          * FIFO enable register sets which sensor output will be written to FIFO buffer
          */
         if(err == BSP_MPU9150_err_NONE ) {
-            fifoConfigReg.B.accelFifoEn = false;
-            fifoConfigReg.B.tempFifoEn = false;
-            fifoConfigReg.B.xgFifoEn = false;
-            fifoConfigReg.B.ygFifoEn = false;
-            fifoConfigReg.B.zgFifoEn = false;
+            // written in register order, so FIFO frame has the same layout as ACCEL_XOUT_H..GYRO_ZOUT_L
+            fifoConfigReg.B.accelFifoEn = BSP_MPU9150_FIFO_MODE;
+            fifoConfigReg.B.tempFifoEn = BSP_MPU9150_FIFO_MODE;
+            fifoConfigReg.B.xgFifoEn = BSP_MPU9150_FIFO_MODE;
+            fifoConfigReg.B.ygFifoEn = BSP_MPU9150_FIFO_MODE;
+            fifoConfigReg.B.zgFifoEn = BSP_MPU9150_FIFO_MODE;
+            // magnetometer data read by I2C slave 0 follows right after gyroscope data
+            fifoConfigReg.B.slv0FifoEn = (BSP_MPU9150_FIFO_MODE && BSP_MPU9150_MAG_MODE);
 
             BSP_MPU9150_writeSingleReg(inDevice,
                     BSP_MPU9150_REG_FIFO_EN,
@@ -922,7 +1972,8 @@ static void BSP_MPU9150_configuration(BSP_MPU9150_device_S *inDevice, BSP_MPU915
             intConfigReg.B.fsyncIntEn = false;
             intConfigReg.B.fsyncIntLevel = false;
             // if true enables I2C bypass, so we can directly access magnetometer through I2C
-            intConfigReg.B.i2cBypassEn = false;
+            // bypass is enabled only while magnetometer fuse ROM is read, then I2C master takes over
+            intConfigReg.B.i2cBypassEn = BSP_MPU9150_MAG_MODE;
             intConfigReg.B.intLevel = false;
             intConfigReg.B.intOpen = false;
             // if true - clear interrupt status on any read operation
@@ -936,58 +1987,317 @@ static void BSP_MPU9150_configuration(BSP_MPU9150_device_S *inDevice, BSP_MPU915
         }
 
         /*
-         * Setup gyroscope configuration
+         * Setup gyroscope and accelerometer full-scale ranges
          */
         if(err == BSP_MPU9150_err_NONE ) {
-            gyroConfigReg.B.fsSel = (uint8_t) inDevice->config->gyroRange;
-            gyroConfigReg.B.xg_st = false;
-            gyroConfigReg.B.yg_st = false;
-            gyroConfigReg.B.zg_st = false;
-
-            BSP_MPU9150_writeSingleReg(inDevice,
-                    BSP_MPU9150_REG_GYRO_CONFIG,
-                    gyroConfigReg.R,
+            BSP_MPU9150_writeRanges(inDevice,
+                    inDevice->config->gyroRange,
+                    inDevice->config->accRange,
                     &err);
         }
 
+#if (BSP_MPU9150_MAG_MODE == true)
         /*
-         * Setup accelerometer configuration
+         * Setup magnetometer configuration
          */
         if(err == BSP_MPU9150_err_NONE ) {
-            accConfigReg.B.afsSel = (uint8_t) inDevice->config->accRange;
-            accConfigReg.B.xa_st = false;
-            accConfigReg.B.ya_st = false;
-            accConfigReg.B.za_st = false;
+            BSP_MPU9150_readMagAdjustment(inDevice, &err);
+        }
+
+        if(err == BSP_MPU9150_err_NONE ) {
+            // from now on magnetometer is accessed only by MPU-9150 I2C master
+            intConfigReg.B.i2cBypassEn = false;
 
             BSP_MPU9150_writeSingleReg(inDevice,
-                    BSP_MPU9150_REG_ACCEL_CONFIG,
-                    accConfigReg.R,
+                    BSP_MPU9150_REG_INT_PIN_CFG,
+                    intConfigReg.R,
                     &err);
         }
 
-        /* TODO: [mario.kodba 28.06.2021] Needs to be tested
-         * Setup magnetometer configuration
-         */
-//        if(err == BSP_MPU9150_err_NONE ) {
-//            BSP_MPU9150_writeSingleMagReg(inDevice,
-//                    BSP_MPU9150_REG_MAG_CNTL,
-//                    BSP_MPU9150_MAGNETOMETER_SINGLE_MEAS_MODE,
-//                    &err);
-//        }
+        if(err == BSP_MPU9150_err_NONE ) {
+            BSP_MPU9150_magMasterConfiguration(inDevice, &err);
+        }
+#endif
 
         /*
          * Interrupt enable setup
          */
         if(err == BSP_MPU9150_err_NONE ) {
-            intEnableReg.B.i2cMstIntEn = false;
-            intEnableReg.B.fifoOverflowEn = false;
-            // if true - enable DATA READY interrupt signal on pin
-            intEnableReg.B.dataRdyEn = true;
+            BSP_MPU9150_writeIntEnable(inDevice, &err);
+        }
 
-            BSP_MPU9150_writeSingleReg(inDevice,
-                    BSP_MPU9150_REG_INT_ENABLE,
-                    intEnableReg.R,
-                    &err);
+#if (BSP_MPU9150_FIFO_MODE == true)
+        if(err == BSP_MPU9150_err_NONE ) {
+            BSP_MPU9150_resetFifo(inDevice, &err);
+        }
+#endif
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function writes digital low pass filter setting to configuration register.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [in]  dlpf         - digital low pass filter setting.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_writeDlpf(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_dlpf_E dlpf,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    BSP_MPU9150_configReg_U configRegVal = { .R = 0u };
+
+    if(dlpf > BSP_MPU9150_dlpf_5Hz) {
+        err = BSP_MPU9150_err_INVALID_PARAM;
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        configRegVal.B.dlpfCfg = (uint8_t) dlpf;
+        configRegVal.B.extSyncSet = false;
+
+        BSP_MPU9150_writeSingleReg(inDevice,
+                BSP_MPU9150_REG_CONFIG,
+                configRegVal.R,
+                &err);
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        inDevice->config->dlpf = dlpf;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function writes sample rate divider for requested sample rate.
+ * @details Sample Rate = Gyroscope Output Rate / (1 + SMPLRT_DIV), where Gyroscope Output Rate
+ *          is 8 kHz when DLPF is disabled, or 1 kHz when DLPF is enabled, so DLPF has to be set
+ *          first. Divider is rounded to nearest, actual rate is stored to configuration. With
+ *          magnetometer enabled, I2C master delay is updated as well, so magnetometer is not read
+ *          faster than BSP_MPU9150_MAG_MAX_RATE_HZ.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [in]  sampleRateHz - requested sample rate in Hz.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_writeSampleRate(BSP_MPU9150_device_S *inDevice,
+        uint16_t sampleRateHz,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    uint32_t gyroOutputRate = BSP_MPU9150_GYRO_OUTPUT_RATE_DLPF_HZ;
+    uint32_t rateDivider = 0u;
+#if (BSP_MPU9150_MAG_MODE == true)
+    BSP_MPU9150_i2cSlv4CtrlReg_U slv4CtrlReg = { .R = 0u };
+    uint32_t magRateDivider = 0u;
+#endif
+
+    if(inDevice->config->dlpf == BSP_MPU9150_dlpf_260Hz) {
+        gyroOutputRate = BSP_MPU9150_GYRO_OUTPUT_RATE_HZ;
+    }
+
+    if((sampleRateHz < BSP_MPU9150_MIN_SAMPLE_RATE_HZ) || (sampleRateHz > BSP_MPU9150_MAX_SAMPLE_RATE_HZ)) {
+        err = BSP_MPU9150_err_INVALID_PARAM;
+    } else {
+        rateDivider = (gyroOutputRate + (sampleRateHz / 2u)) / sampleRateHz;
+        if(rateDivider > BSP_MPU9150_SMPLRT_DIV_MAX) {
+            // only possible with DLPF disabled
+            err = BSP_MPU9150_err_INVALID_PARAM;
+        }
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        BSP_MPU9150_writeSingleReg(inDevice,
+                BSP_MPU9150_REG_SMPLRT_DIV,
+                (uint8_t) (rateDivider - 1u),
+                &err);
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        inDevice->config->sampleRateHz = (uint16_t) (gyroOutputRate / rateDivider);
+    }
+
+#if (BSP_MPU9150_MAG_MODE == true)
+    if(err == BSP_MPU9150_err_NONE) {
+        magRateDivider = (inDevice->config->sampleRateHz + BSP_MPU9150_MAG_MAX_RATE_HZ - 1u) / BSP_MPU9150_MAG_MAX_RATE_HZ;
+        if(magRateDivider > BSP_MPU9150_MAG_MAX_RATE_DIVIDER) {
+            magRateDivider = BSP_MPU9150_MAG_MAX_RATE_DIVIDER;
+        }
+        slv4CtrlReg.B.i2cMstDly = (uint8_t) (magRateDivider - 1u);
+
+        BSP_MPU9150_writeSingleReg(inDevice,
+                BSP_MPU9150_REG_I2C_SLV4_CTRL,
+                slv4CtrlReg.R,
+                &err);
+    }
+#endif
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function writes gyroscope and accelerometer full-scale ranges.
+ * @details Ranges are stored to configuration only after both are written, conversion constants
+ *          are selected from configuration for every frame. Motion detection high pass filter is
+ *          left in reset, it is used only in low power mode.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [in]  gyroRange    - gyroscope full-scale range.
+ * @param [in]  accRange     - accelerometer full-scale range.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_writeRanges(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_gyroFsRange_E gyroRange,
+        BSP_MPU9150_accFsRange_E accRange,
+        BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    BSP_MPU9150_gyroConfigReg_U gyroConfigReg = { .R = 0u };
+    BSP_MPU9150_accConfigReg_U accConfigReg = { .R = 0u };
+
+    if((gyroRange > BSP_MPU9150_gyroFsRange_2000degS) || (accRange > BSP_MPU9150_accFsRange_16G)) {
+        err = BSP_MPU9150_err_INVALID_PARAM;
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        gyroConfigReg.B.fsSel = (uint8_t) gyroRange;
+        gyroConfigReg.B.xg_st = false;
+        gyroConfigReg.B.yg_st = false;
+        gyroConfigReg.B.zg_st = false;
+
+        BSP_MPU9150_writeSingleReg(inDevice,
+                BSP_MPU9150_REG_GYRO_CONFIG,
+                gyroConfigReg.R,
+                &err);
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        accConfigReg.B.afsSel = (uint8_t) accRange;
+        accConfigReg.B.xa_st = false;
+        accConfigReg.B.ya_st = false;
+        accConfigReg.B.za_st = false;
+
+        BSP_MPU9150_writeSingleReg(inDevice,
+                BSP_MPU9150_REG_ACCEL_CONFIG,
+                accConfigReg.R,
+                &err);
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        inDevice->config->gyroRange = gyroRange;
+        inDevice->config->accRange = accRange;
+
+        // motion is detected on raw counts, so threshold follows accelerometer range
+        inDevice->motionThresholdCounts = (int16_t) ((inDevice->config->motionThresholdMg *
+                (BSP_MPU9150_ACC_2G_COUNTS_PER_G >> (uint8_t) accRange)) / 1000u);
+        inDevice->motionRefValid = false;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function enables interrupts signaled on INT pin while sampling.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_writeIntEnable(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_intEnableReg_U intEnableReg = { .R = 0u };
+
+    intEnableReg.B.i2cMstIntEn = false;
+    // in FIFO mode, interrupt pin signals only FIFO overflow, FIFO is drained periodically
+    intEnableReg.B.fifoOverflowEn = BSP_MPU9150_FIFO_MODE;
+    // if true - enable DATA READY interrupt signal on pin
+    intEnableReg.B.dataRdyEn = !BSP_MPU9150_FIFO_MODE;
+    // motion interrupt is used only to wake up from low power mode
+    intEnableReg.B.motEn = false;
+
+    BSP_MPU9150_writeSingleReg(inDevice,
+            BSP_MPU9150_REG_INT_ENABLE,
+            intEnableReg.R,
+            outErr);
+}
+
+#if (BSP_MPU9150_MAG_MODE == true)
+/***********************************************************************************************//**
+ * @brief Function reads magnetometer sensitivity adjustment values from fuse ROM.
+ * @details Magnetometer is accessed directly through I2C bypass, which has to be enabled. Scale
+ *          with adjustment applied is stored to device, magnetometer is left in power down mode.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_readMagAdjustment(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    uint8_t deviceId = 0u;
+    uint8_t asa[BSP_MPU9150_MAG_ASA_SIZE] = { 0u };
+
+    BSP_MPU9150_readSingleMagReg(inDevice,
+            BSP_MPU9150_REG_MAG_WIA,
+            &deviceId,
+            &err);
+
+    if((err == BSP_MPU9150_err_NONE) && (deviceId != BSP_MPU9150_MAGNETOMETER_ID_VALUE)) {
+        err = BSP_MPU9150_err_INIT;
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        BSP_MPU9150_writeSingleMagReg(inDevice,
+                BSP_MPU9150_REG_MAG_CNTL,
+                BSP_MPU9150_MAG_CNTL_FUSE_ROM,
+                &err);
+        nrf_delay_us(BSP_MPU9150_MAG_MODE_CHANGE_DELAY_US);
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        BSP_MPU9150_readMultiMagReg(inDevice,
+                BSP_MPU9150_REG_MAG_ASAX,
+                BSP_MPU9150_MAG_ASA_SIZE,
+                &asa[0],
+                &err);
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        BSP_MPU9150_writeSingleMagReg(inDevice,
+                BSP_MPU9150_REG_MAG_CNTL,
+                BSP_MPU9150_MAG_CNTL_POWER_DOWN,
+                &err);
+        nrf_delay_us(BSP_MPU9150_MAG_MODE_CHANGE_DELAY_US);
+    }
+
+    if(err == BSP_MPU9150_err_NONE) {
+        // sensitivity adjustment and conversion to 0.1 uT are folded into single Q8 multiplier
+        for(uint8_t i = 0u; i < BSP_MPU9150_MAG_ASA_SIZE; i++) {
+            inDevice->magScale[i] = (asa[i] + BSP_MPU9150_MAG_ASA_OFFSET) * BSP_MPU9150_MAG_TENTH_UT_PER_LSB;
         }
     }
 
@@ -996,6 +2306,123 @@ static void BSP_MPU9150_configuration(BSP_MPU9150_device_S *inDevice, BSP_MPU915
     }
 }
 
+/***********************************************************************************************//**
+ * @brief Function sets up MPU-9150 I2C master to poll magnetometer into EXT_SENS_DATA registers.
+ * @details On every I2C_MST_DLY + 1-th sample slave 0 reads previous measurement (HXL..ST2),
+ *          then slave 1 starts next single measurement. Delay follows sample rate, it is set in
+ *          BSP_MPU9150_writeSampleRate. Data is appended to each
+ *          frame, so it arrives in the same burst read as accelerometer and gyroscope data.
+ ***************************************************************************************************
+ * @param [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void BSP_MPU9150_magMasterConfiguration(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr) {
+
+    BSP_MPU9150_err_E err = BSP_MPU9150_err_NONE;
+    BSP_MPU9150_i2cMstCtrlReg_U i2cMstCtrlReg = { .R = 0u };
+    BSP_MPU9150_i2cSlvAddrReg_U slv0AddrReg = { .R = 0u };
+    BSP_MPU9150_i2cSlvCtrlReg_U slv0CtrlReg = { .R = 0u };
+    BSP_MPU9150_i2cSlvAddrReg_U slv1AddrReg = { .R = 0u };
+    BSP_MPU9150_i2cSlvCtrlReg_U slv1CtrlReg = { .R = 0u };
+    BSP_MPU9150_i2cMstDelayCtrlReg_U mstDelayCtrlReg = { .R = 0u };
+    BSP_MPU9150_userCtrlReg_U userCtrlReg = { .R = 0u };
+
+    // data ready is signaled only after magnetometer data is loaded, so frame is always complete
+    i2cMstCtrlReg.B.i2cMstClk = BSP_MPU9150_I2C_MST_CLK_400KHZ;
+    i2cMstCtrlReg.B.waitForEs = true;
+
+    // slave 0 reads measurement data and ST2 register, reading ST2 ends the measurement read
+    slv0AddrReg.B.i2cSlvAddr = inDevice->config->mpuMagAddress;
+    slv0AddrReg.B.i2cSlvRw = true;
+    slv0CtrlReg.B.i2cSlvLen = BSP_MPU9150_MAG_FRAME_SIZE;
+    slv0CtrlReg.B.i2cSlvEn = true;
+
+    // slave 1 starts next single measurement
+    slv1AddrReg.B.i2cSlvAddr = inDevice->config->mpuMagAddress;
+    slv1AddrReg.B.i2cSlvRw = false;
+    slv1CtrlReg.B.i2cSlvLen = 1u;
+    slv1CtrlReg.B.i2cSlvEn = true;
+
+    // both slaves are accessed at reduced rate, so measurement always completes in between
+    mstDelayCtrlReg.B.i2cSlv0DlyEn = true;
+    mstDelayCtrlReg.B.i2cSlv1DlyEn = true;
+    mstDelayCtrlReg.B.delayEsShadow = true;
+
+    userCtrlReg.B.i2cMstEn = true;
+
+    // register address and value pairs, written in order
+    const uint8_t regWrites[][BSP_MPU9150_TWI_TX_SIZE] = {
+        { BSP_MPU9150_REG_I2C_MST_CTRL,         i2cMstCtrlReg.R },
+        { BSP_MPU9150_REG_I2C_SLV0_ADDR,        slv0AddrReg.R },
+        { BSP_MPU9150_REG_I2C_SLV0_REG,         BSP_MPU9150_REG_MAG_HXL },
+        { BSP_MPU9150_REG_I2C_SLV0_CTRL,        slv0CtrlReg.R },
+        { BSP_MPU9150_REG_I2C_SLV1_ADDR,        slv1AddrReg.R },
+        { BSP_MPU9150_REG_I2C_SLV1_REG,         BSP_MPU9150_REG_MAG_CNTL },
+        { BSP_MPU9150_REG_I2C_SLV1_DO,          BSP_MPU9150_MAG_CNTL_SINGLE_MEAS },
+        { BSP_MPU9150_REG_I2C_SLV1_CTRL,        slv1CtrlReg.R },
+        { BSP_MPU9150_REG_I2C_MST_DELAY_CTRL,   mstDelayCtrlReg.R },
+        { BSP_MPU9150_REG_USER_CTRL,            userCtrlReg.R },
+    };
+
+    for(uint8_t i = 0u; (i < (sizeof(regWrites) / sizeof(regWrites[0]))) && (err == BSP_MPU9150_err_NONE); i++) {
+        BSP_MPU9150_writeSingleReg(inDevice,
+                regWrites[i][0],
+                regWrites[i][1],
+                &err);
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function calculates magnetometer values with fuse ROM sensitivity adjustment applied.
+ * @details Magnetometer axes are aligned to accelerometer and gyroscope axes (X and Y are swapped
+ *          and Z is inverted). On data error or magnetic sensor overflow all axes are set to
+ *          BSP_MPU9150_MAG_INVALID_VALUE.
+ ***************************************************************************************************
+ * @param  [in]  *inDevice    - pointer to device structure for MPU-9150 driver.
+ * @param  [in]  *rawValue    - pointer to raw magnetometer measurements and ST2 register (LSB first).
+ * @param  [out] *outMag      - pointer to calculated magnetometer values in 0.1 uT.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static void BSP_MPU9150_calculateMagValues(const BSP_MPU9150_device_S *inDevice,
+        const uint8_t *rawValue,
+        int16_t *outMag) {
+
+    int32_t magX = 0;
+    int32_t magY = 0;
+    int32_t magZ = 0;
+
+    if((rawValue[BSP_MPU9150_MAG_ST2_OFFSET] & BSP_MPU9150_MAG_ST2_ERROR_MASK) != 0u) {
+        outMag[0] = BSP_MPU9150_MAG_INVALID_VALUE;
+        outMag[1] = BSP_MPU9150_MAG_INVALID_VALUE;
+        outMag[2] = BSP_MPU9150_MAG_INVALID_VALUE;
+    } else {
+        magX = (int16_t) (rawValue[0] + (rawValue[1] << 8u));
+        magY = (int16_t) (rawValue[2] + (rawValue[3] << 8u));
+        magZ = (int16_t) (rawValue[4] + (rawValue[5] << 8u));
+
+        magX = (magX * inDevice->magScale[0] + BSP_MPU9150_MAG_SCALE_ROUNDING) >> BSP_MPU9150_MAG_SCALE_SHIFT;
+        magY = (magY * inDevice->magScale[1] + BSP_MPU9150_MAG_SCALE_ROUNDING) >> BSP_MPU9150_MAG_SCALE_SHIFT;
+        magZ = (magZ * inDevice->magScale[2] + BSP_MPU9150_MAG_SCALE_ROUNDING) >> BSP_MPU9150_MAG_SCALE_SHIFT;
+
+        // X-axis Magnetometer
+        outMag[0] = (int16_t) magY;
+        // Y-axis Magnetometer
+        outMag[1] = (int16_t) magX;
+        // Z-axis Magnetometer
+        outMag[2] = (int16_t) -magZ;
+    }
+}
+#endif // #if (BSP_MPU9150_MAG_MODE == true)
+
 /***************************************************************************************************
  *                          END OF FILE
  **************************************************************************************************/
@@ -32,10 +32,56 @@
 /***************************************************************************************************
  *                              DEFINES
  **************************************************************************************************/
-//! If set to true uses twi_hw_master drivers (workaround in order for TWI to work with SoftDevice) instead of nrf_twi drivers
-#define DEPRECATED_TWI      true
-
+// sensor data conversion modes
+#define BSP_MPU9150_CONVERSION_FLOAT        (0u)    //!< Convert to physical units using (soft) floating point arithmetic
+#define BSP_MPU9150_CONVERSION_FIXED        (1u)    //!< Convert to physical units using Q16 fixed point scale constants
+#define BSP_MPU9150_CONVERSION_RAW          (2u)    //!< No conversion, raw counts are sent together with range descriptor
+
+//! If set to true samples are buffered in MPU-9150 FIFO and read out in bursts, instead of one read per data ready
+#define BSP_MPU9150_FIFO_MODE               true
+
+//! If set to true magnetometer is polled by MPU-9150 I2C master and its data is appended to each frame
+#define BSP_MPU9150_MAG_MODE                true
+
+//! Selects how raw sensor readings are converted before they are stored to device data buffer
+#define BSP_MPU9150_CONVERSION_MODE         BSP_MPU9150_CONVERSION_FIXED
+
+#define BSP_MPU9150_DEFAULT_SAMPLE_RATE_HZ  (100u)  //!< Sensor sample rate in Hz, set on initialization
+#define BSP_MPU9150_MIN_SAMPLE_RATE_HZ      (4u)    //!< Min sample rate in Hz (max SMPLRT_DIV with DLPF enabled)
+#define BSP_MPU9150_MAX_SAMPLE_RATE_HZ      (1000u) //!< Max sample rate in Hz (accelerometer output rate)
+
+#define BSP_MPU9150_GYRO_DATA_INDEX         (0u)    //!< Index of gyroscope X-axis value in device data buffer
+#define BSP_MPU9150_ACC_DATA_INDEX          (3u)    //!< Index of accelerometer X-axis value in device data buffer
+#define BSP_MPU9150_TEMP_DATA_INDEX         (6u)    //!< Index of temperature value in device data buffer
+
+#if (BSP_MPU9150_CONVERSION_MODE == BSP_MPU9150_CONVERSION_RAW)
+#if (BSP_MPU9150_MAG_MODE == true)
+#error "Raw frame with magnetometer data and range descriptor does not fit in 20 byte BLE notification"
+#endif
+#define BSP_MPU9150_SENSOR_DATA_INT16_SIZE  (8u)    //!< Number of 16-bit (sensor) data stored to device data buffer
+#define BSP_MPU9150_RANGE_DESCRIPTOR_INDEX  (7u)    //!< Index of range descriptor in device data buffer
+#elif (BSP_MPU9150_MAG_MODE == true)
+#define BSP_MPU9150_SENSOR_DATA_INT16_SIZE  (10u)   //!< Number of 16-bit (sensor) data stored to device data buffer
+#define BSP_MPU9150_MAG_DATA_INDEX          (7u)    //!< Index of magnetometer X-axis value in device data buffer
+#else
 #define BSP_MPU9150_SENSOR_DATA_INT16_SIZE  (7u)    //!< Number of 16-bit (sensor) data stored to device data buffer
+#endif
+
+#if (BSP_MPU9150_MAG_MODE == true)
+#define BSP_MPU9150_MAG_FRAME_SIZE          (7u)    //!< Magnetometer HXL..HZH and ST2 registers, read into EXT_SENS_DATA
+#else
+#define BSP_MPU9150_MAG_FRAME_SIZE          (0u)    //!< Magnetometer is not read
+#endif
+
+#define BSP_MPU9150_TWI_TX_SIZE             (2u)    //!< Max number of bytes sent in single TWI transfer (register address and value)
+#define BSP_MPU9150_FIFO_COUNT_SIZE         (2u)    //!< Number of bytes in FIFO count registers
+//! Accelerometer, temperature, gyroscope and magnetometer frame size in bytes
+#define BSP_MPU9150_FRAME_SIZE              (14u + BSP_MPU9150_MAG_FRAME_SIZE)
+#define BSP_MPU9150_FIFO_SIZE_IN_BYTES      (1024u) //!< MPU-9150 FIFO buffer size in bytes
+//! Number of whole frames MPU-9150 FIFO buffer can hold
+#define BSP_MPU9150_FIFO_MAX_FRAMES         (BSP_MPU9150_FIFO_SIZE_IN_BYTES / BSP_MPU9150_FRAME_SIZE)
+//! Max number of frames read from MPU-9150 FIFO buffer in single TWI transfer (255 bytes)
+#define BSP_MPU9150_FIFO_MAX_BURST_FRAMES   (UINT8_MAX / BSP_MPU9150_FRAME_SIZE)
 
 /**********************************************************
 *    MPU-9150 Gyroscope and Accelerometer register map    *
@@ -51,9 +97,12 @@
 #define BSP_MPU9150_REG_CONFIG              (0x1Au)
 #define BSP_MPU9150_REG_GYRO_CONFIG         (0x1Bu)
 #define BSP_MPU9150_REG_ACCEL_CONFIG        (0x1Cu)
+#define BSP_MPU9150_REG_MOT_THR             (0x1Fu)
+#define BSP_MPU9150_REG_MOT_DUR             (0x20u)
 #define BSP_MPU9150_REG_FIFO_EN             (0x23u)
 #define BSP_MPU9150_REG_I2C_MST_CTRL        (0x24u)
 #define BSP_MPU9150_REG_SIGNAL_PATH_RESET   (0x68u)
+#define BSP_MPU9150_REG_MOT_DETECT_CTRL     (0x69u)
 #define BSP_MPU9150_REG_USER_CTRL           (0x6Au)
 #define BSP_MPU9150_REG_PWR_MGMT_1          (0x6Bu)
 #define BSP_MPU9150_REG_PWR_MGMT_2          (0x6Cu)
@@ -112,6 +161,9 @@
 #define BSP_MPU9150_REG_GYRO_ZOUT_H         (0x47u)
 #define BSP_MPU9150_REG_GYRO_ZOUT_L         (0x48u)
 
+// External sensor data registers, filled by I2C master from I2C slaves 0-3
+#define BSP_MPU9150_REG_EXT_SENS_DATA_00    (0x49u)
+
 /**********************************************************
 *       MPU-9150 Magnetometer (AK8975C) register map      *
 **********************************************************/
@@ -137,6 +189,11 @@
 #define BSP_MPU9150_REG_MAG_ASAY            (0x11u)
 #define BSP_MPU9150_REG_MAG_ASAZ            (0x12u)
 
+// Magnetometer CNTL register modes
+#define BSP_MPU9150_MAG_CNTL_POWER_DOWN     (0x00u)
+#define BSP_MPU9150_MAG_CNTL_SINGLE_MEAS    (0x01u)
+#define BSP_MPU9150_MAG_CNTL_FUSE_ROM       (0x0Fu)
+
 /***************************************************************************************************
  *                              ENUMERATIONS
  **************************************************************************************************/
@@ -147,9 +204,35 @@ typedef enum BSP_MPU9150_err_ENUM {
     BSP_MPU9150_err_INIT,                   //!< Error on initialization
     BSP_MPU9150_err_I2C_READ_WRITE,         //!< I2C operation error
     BSP_MPU9150_err_I2C_TIMEOUT,            //!< I2C timeout error
+    BSP_MPU9150_err_INVALID_PARAM,          //!< Parameter out of range error
+    BSP_MPU9150_err_BUSY,                   //!< Another TWI transfer is in progress
 
 } BSP_MPU9150_err_E;
 
+//! MPU9150 TWI transfer state
+typedef enum BSP_MPU9150_twiState_ENUM {
+    BSP_MPU9150_twiState_IDLE       = 0u,   //!< No transfer in progress
+    BSP_MPU9150_twiState_WRITE,             //!< Register address and value are being sent
+    BSP_MPU9150_twiState_READ_ADDRESS,      //!< Register address is being sent, read follows after repeated START
+    BSP_MPU9150_twiState_READ_DATA          //!< Register data is being read
+} BSP_MPU9150_twiState_E;
+
+//! MPU-9150 initialization state enumeration, state is named after the wait in progress
+typedef enum BSP_MPU9150_initState_ENUM {
+    BSP_MPU9150_initState_POWER_UP          = 0u,   //!< Waiting for device start-up after power-up
+    BSP_MPU9150_initState_SIGNAL_PATH_RESET,        //!< Waiting for signal path reset
+    BSP_MPU9150_initState_PLL,                      //!< Waiting for PLL to settle
+    BSP_MPU9150_initState_CONFIGURATION,            //!< Sensors configured, waiting for sensors start-up
+    BSP_MPU9150_initState_DONE                      //!< Initialization finished
+} BSP_MPU9150_initState_E;
+
+//! MPU9150 low power mode transition states
+typedef enum BSP_MPU9150_lpState_ENUM {
+    BSP_MPU9150_lpState_IDLE            = 0u,   //!< No low power mode transition in progress
+    BSP_MPU9150_lpState_ENTERING,               //!< Waiting for motion detection high pass filter to settle
+    BSP_MPU9150_lpState_EXITING                 //!< Waiting for gyroscope PLL to settle
+} BSP_MPU9150_lpState_E;
+
 //! MPU9150 accelerometer full scale range
 typedef enum BSP_MPU9150_accFsRange_ENUM {
     BSP_MPU9150_accFsRange_2G   = 0u,       //!< Accelerometer +-2G full-scale range
@@ -166,6 +249,32 @@ typedef enum BSP_MPU9150_gyroFsRange_ENUM {
     BSP_MPU9150_gyroFsRange_2000degS        //!< Gyroscope +-2000 DPS full-scale range
 } BSP_MPU9150_gyroFsRange_E;
 
+//! MPU9150 digital low pass filter setting, accelerometer bandwidth (gyroscope bandwidth is similar)
+typedef enum BSP_MPU9150_dlpf_ENUM {
+    BSP_MPU9150_dlpf_260Hz      = 0u,       //!< 260 Hz bandwidth, gyroscope output rate is 8 kHz
+    BSP_MPU9150_dlpf_184Hz,                 //!< 184 Hz bandwidth, gyroscope output rate is 1 kHz
+    BSP_MPU9150_dlpf_94Hz,                  //!< 94 Hz bandwidth, gyroscope output rate is 1 kHz
+    BSP_MPU9150_dlpf_44Hz,                  //!< 44 Hz bandwidth, gyroscope output rate is 1 kHz
+    BSP_MPU9150_dlpf_21Hz,                  //!< 21 Hz bandwidth, gyroscope output rate is 1 kHz
+    BSP_MPU9150_dlpf_10Hz,                  //!< 10 Hz bandwidth, gyroscope output rate is 1 kHz
+    BSP_MPU9150_dlpf_5Hz                    //!< 5 Hz bandwidth, gyroscope output rate is 1 kHz
+} BSP_MPU9150_dlpf_E;
+
+//! MPU9150 accelerometer wake-up frequency in low power (cycle) mode
+typedef enum BSP_MPU9150_lpWakeRate_ENUM {
+    BSP_MPU9150_lpWakeRate_1_25Hz   = 0u,   //!< Accelerometer sampled at 1.25 Hz
+    BSP_MPU9150_lpWakeRate_5Hz,             //!< Accelerometer sampled at 5 Hz
+    BSP_MPU9150_lpWakeRate_20Hz,            //!< Accelerometer sampled at 20 Hz
+    BSP_MPU9150_lpWakeRate_40Hz             //!< Accelerometer sampled at 40 Hz
+} BSP_MPU9150_lpWakeRate_E;
+
+//! MPU9150 accelerometer digital high pass filter, used by motion detection only
+typedef enum BSP_MPU9150_accHpf_ENUM {
+    BSP_MPU9150_accHpf_RESET        = 0u,   //!< Filter output settles to zero
+    BSP_MPU9150_accHpf_5Hz          = 1u,   //!< 5 Hz cut-off frequency
+    BSP_MPU9150_accHpf_HOLD         = 7u    //!< Current sample is held as reference for motion detection
+} BSP_MPU9150_accHpf_E;
+
 /***************************************************************************************************
  *                              DATA STRUCTURES
  **************************************************************************************************/
@@ -195,7 +304,7 @@ typedef union BSP_MPU9150_gyroConfigReg_UNION {
 typedef union BSP_MPU9150_accConfigReg_UNION {
     uint8_t R;                                  //!< Accelerometer configuration register value
     struct {
-       uint8_t              : 3;                //!< Not used
+       uint8_t  accelHpf    : 3;                //!< Configures high pass filter for motion detection (BSP_MPU9150_accHpf_E)
        uint8_t  afsSel      : 2;                //!< Configures accelerometer full-scale range
        uint8_t  za_st       : 1;                //!< Set Z-axis accelerometer self-test bit
        uint8_t  ya_st       : 1;                //!< Set Y-axis accelerometer self-test bit
@@ -207,7 +316,8 @@ typedef union BSP_MPU9150_accConfigReg_UNION {
 typedef union BSP_MPU9150_fifoConfigReg_UNION {
     uint8_t R;                                  //!< FIFO buffer configuration register value
     struct {
-       uint8_t              : 3;                //!< Not used on nRF51 MUHA board
+       uint8_t  slv0FifoEn  : 1;                //!< Set I2C slave 0 (EXT_SENS_DATA) FIFO enable
+       uint8_t              : 2;                //!< Not used on nRF51 MUHA board
        uint8_t  accelFifoEn : 1;                //!< Set accelerometer FIFO enable
        uint8_t  zgFifoEn    : 1;                //!< Set Z-axis gyroscope FIFO enable
        uint8_t  ygFifoEn    : 1;                //!< Set Y-axis gyroscope FIFO enable
@@ -224,7 +334,9 @@ typedef union BSP_MPU9150_intEnableReg_UNION {
        uint8_t                 : 2;             //!< Not used
        uint8_t  i2cMstIntEn    : 1;             //!< Enables any of the I2C Master interrupt sources to generate an interrupt
        uint8_t  fifoOverflowEn : 1;             //!< Enable interrupt on FIFO buffer overflow
-       uint8_t                 : 3;             //!< Not used
+       uint8_t                 : 1;             //!< Not used
+       uint8_t  motEn          : 1;             //!< Enable interrupt on motion detection
+       uint8_t                 : 1;             //!< Not used
     } B;                                        //!< Interrupt enable register bits
 } BSP_MPU9150_intEnableReg_U;
 
@@ -243,24 +355,203 @@ typedef union BSP_MPU9150_intConfigReg_UNION {
     } B;                                        //!< Interrupt configuration register bits
 } BSP_MPU9150_intConfigReg_U;
 
+//! MPU9150 User control register
+typedef union BSP_MPU9150_userCtrlReg_UNION {
+    uint8_t R;                                  //!< User control register value
+    struct {
+       uint8_t  sigCondReset : 1;               //!< Resets signal paths and clears sensor registers
+       uint8_t  i2cMstReset  : 1;               //!< Resets I2C master
+       uint8_t  fifoReset    : 1;               //!< Resets FIFO buffer, bit clears itself
+       uint8_t               : 1;               //!< Not used
+       uint8_t  i2cIfDis     : 1;               //!< Always write 0 on MPU-9150
+       uint8_t  i2cMstEn     : 1;               //!< Enables I2C master mode
+       uint8_t  fifoEn       : 1;               //!< Enables FIFO buffer operations
+       uint8_t               : 1;               //!< Not used
+    } B;                                        //!< User control register bits
+} BSP_MPU9150_userCtrlReg_U;
+
+//! MPU9150 Power management 1 register
+typedef union BSP_MPU9150_pwrMgmt1Reg_UNION {
+    uint8_t R;                                  //!< Power management 1 register value
+    struct {
+       uint8_t  clkSel       : 3;               //!< Clock source (0 - internal 8 MHz oscillator, 1 - PLL with X-axis gyroscope reference)
+       uint8_t  tempDis      : 1;               //!< Disables temperature sensor
+       uint8_t               : 1;               //!< Not used
+       uint8_t  cycle        : 1;               //!< Cycles between sleep and single accelerometer sample at LP_WAKE_CTRL rate
+       uint8_t  sleep        : 1;               //!< Puts device into sleep mode
+       uint8_t  deviceReset  : 1;               //!< Resets all registers to default values
+    } B;                                        //!< Power management 1 register bits
+} BSP_MPU9150_pwrMgmt1Reg_U;
+
+//! MPU9150 Power management 2 register
+typedef union BSP_MPU9150_pwrMgmt2Reg_UNION {
+    uint8_t R;                                  //!< Power management 2 register value
+    struct {
+       uint8_t  stbyZg       : 1;               //!< Puts Z-axis gyroscope into standby mode
+       uint8_t  stbyYg       : 1;               //!< Puts Y-axis gyroscope into standby mode
+       uint8_t  stbyXg       : 1;               //!< Puts X-axis gyroscope into standby mode
+       uint8_t  stbyZa       : 1;               //!< Puts Z-axis accelerometer into standby mode
+       uint8_t  stbyYa       : 1;               //!< Puts Y-axis accelerometer into standby mode
+       uint8_t  stbyXa       : 1;               //!< Puts X-axis accelerometer into standby mode
+       uint8_t  lpWakeCtrl   : 2;               //!< Accelerometer wake-up frequency in cycle mode (BSP_MPU9150_lpWakeRate_E)
+    } B;                                        //!< Power management 2 register bits
+} BSP_MPU9150_pwrMgmt2Reg_U;
+
+//! MPU9150 Motion detection control register
+typedef union BSP_MPU9150_motDetectCtrlReg_UNION {
+    uint8_t R;                                  //!< Motion detection control register value
+    struct {
+       uint8_t  motCount     : 2;               //!< Motion detection counter decrement rate
+       uint8_t  ffCount      : 2;               //!< Free fall detection counter decrement rate
+       uint8_t  accelOnDelay : 2;               //!< Additional accelerometer power-on delay in ms
+       uint8_t               : 2;               //!< Not used
+    } B;                                        //!< Motion detection control register bits
+} BSP_MPU9150_motDetectCtrlReg_U;
+
+//! MPU9150 I2C master control register
+typedef union BSP_MPU9150_i2cMstCtrlReg_UNION {
+    uint8_t R;                                  //!< I2C master control register value
+    struct {
+       uint8_t  i2cMstClk   : 4;                //!< I2C master clock divider (13 - 400 kHz)
+       uint8_t  i2cMstPNsr  : 1;                //!< When 0 - restart between slave reads, when 1 - stop and start
+       uint8_t  slv3FifoEn  : 1;                //!< Set I2C slave 3 FIFO enable
+       uint8_t  waitForEs   : 1;                //!< Delays data ready interrupt until external sensor data is loaded
+       uint8_t  multMstEn   : 1;                //!< Enables multi-master capability
+    } B;                                        //!< I2C master control register bits
+} BSP_MPU9150_i2cMstCtrlReg_U;
+
+//! MPU9150 I2C slave address register (I2C_SLV0_ADDR - I2C_SLV4_ADDR)
+typedef union BSP_MPU9150_i2cSlvAddrReg_UNION {
+    uint8_t R;                                  //!< I2C slave address register value
+    struct {
+       uint8_t  i2cSlvAddr  : 7;                //!< I2C slave address
+       uint8_t  i2cSlvRw    : 1;                //!< When 0 - slave is written, when 1 - slave is read
+    } B;                                        //!< I2C slave address register bits
+} BSP_MPU9150_i2cSlvAddrReg_U;
+
+//! MPU9150 I2C slave control register (I2C_SLV0_CTRL - I2C_SLV3_CTRL)
+typedef union BSP_MPU9150_i2cSlvCtrlReg_UNION {
+    uint8_t R;                                  //!< I2C slave control register value
+    struct {
+       uint8_t  i2cSlvLen   : 4;                //!< Number of bytes transferred to/from slave
+       uint8_t  i2cSlvGrp   : 1;                //!< Word grouping, when 0 - bytes 0 and 1 form a word
+       uint8_t  i2cSlvRegDis: 1;                //!< When 1 - data is transferred without register address
+       uint8_t  i2cSlvByteSw: 1;                //!< Swaps bytes of each word
+       uint8_t  i2cSlvEn    : 1;                //!< Enables slave transfers on each sample
+    } B;                                        //!< I2C slave control register bits
+} BSP_MPU9150_i2cSlvCtrlReg_U;
+
+//! MPU9150 I2C slave 4 control register, also holds slave access rate divider
+typedef union BSP_MPU9150_i2cSlv4CtrlReg_UNION {
+    uint8_t R;                                  //!< I2C slave 4 control register value
+    struct {
+       uint8_t  i2cMstDly   : 5;                //!< Delayed slaves are accessed every (1 + i2cMstDly) samples
+       uint8_t  i2cSlv4RegDis: 1;               //!< When 1 - data is transferred without register address
+       uint8_t  i2cSlv4IntEn: 1;                //!< Enables interrupt on slave 4 transfer completion
+       uint8_t  i2cSlv4En   : 1;                //!< Enables slave 4 transfer
+    } B;                                        //!< I2C slave 4 control register bits
+} BSP_MPU9150_i2cSlv4CtrlReg_U;
+
+//! MPU9150 I2C master delay control register
+typedef union BSP_MPU9150_i2cMstDelayCtrlReg_UNION {
+    uint8_t R;                                  //!< I2C master delay control register value
+    struct {
+       uint8_t  i2cSlv0DlyEn: 1;                //!< Slave 0 is accessed at reduced rate
+       uint8_t  i2cSlv1DlyEn: 1;                //!< Slave 1 is accessed at reduced rate
+       uint8_t  i2cSlv2DlyEn: 1;                //!< Slave 2 is accessed at reduced rate
+       uint8_t  i2cSlv3DlyEn: 1;                //!< Slave 3 is accessed at reduced rate
+       uint8_t  i2cSlv4DlyEn: 1;                //!< Slave 4 is accessed at reduced rate
+       uint8_t              : 2;                //!< Not used
+       uint8_t  delayEsShadow: 1;               //!< Delays shadowing of external sensor data until all data is received
+    } B;                                        //!< I2C master delay control register bits
+} BSP_MPU9150_i2cMstDelayCtrlReg_U;
+
+//! MPU9150 Interrupt status register
+typedef union BSP_MPU9150_intStatusReg_UNION {
+    uint8_t R;                                  //!< Interrupt status register value
+    struct {
+       uint8_t  dataRdyInt     : 1;             //!< Data ready interrupt occurred
+       uint8_t                 : 2;             //!< Not used
+       uint8_t  i2cMstInt      : 1;             //!< I2C master interrupt occurred
+       uint8_t  fifoOflowInt   : 1;             //!< FIFO buffer overflow interrupt occurred
+       uint8_t                 : 1;             //!< Not used
+       uint8_t  motInt         : 1;             //!< Motion detection interrupt occurred
+       uint8_t                 : 1;             //!< Not used
+    } B;                                        //!< Interrupt status register bits
+} BSP_MPU9150_intStatusReg_U;
+
+//! MPU9150 range descriptor, sent along raw counts so receiver can scale them
+typedef union BSP_MPU9150_rangeDescriptor_UNION {
+    uint16_t R;                                 //!< Range descriptor value
+    struct {
+       uint16_t accRange    : 4;                //!< Accelerometer FS range (BSP_MPU9150_accFsRange_E)
+       uint16_t gyroRange   : 4;                //!< Gyroscope FS range (BSP_MPU9150_gyroFsRange_E)
+       uint16_t             : 8;                //!< Not used
+    } B;                                        //!< Range descriptor bits
+} BSP_MPU9150_rangeDescriptor_U;
+
+//! MPU9150 sensor data frame, as filled by BSP_MPU9150_updateValues
+typedef struct BSP_MPU9150_frame_STRUCT {
+    int16_t data[BSP_MPU9150_SENSOR_DATA_INT16_SIZE];   //!< Gyroscope, accelerometer, temperature and magnetometer values
+} BSP_MPU9150_frame_S;
+
+//! MPU9150 frame as read from sensor registers or FIFO buffer
+typedef struct BSP_MPU9150_rawFrame_STRUCT {
+    uint8_t data[BSP_MPU9150_FRAME_SIZE];       //!< Accelerometer, temperature, gyroscope (MSB first) and magnetometer (LSB first) values
+} BSP_MPU9150_rawFrame_S;
+
+//! Callback for finished asynchronous read, called from TWI (or timeout) interrupt context
+typedef void (*BSP_MPU9150_readHandler)(BSP_MPU9150_err_E err, uint8_t frameCount, void *context);
+
+//! MPU9150 TWI transfer, advanced in TWI event handler
+typedef struct BSP_MPU9150_twiTransfer_STRUCT {
+    uint8_t address;                                //!< I2C address of accessed device
+    uint8_t txData[BSP_MPU9150_TWI_TX_SIZE];        //!< Register address, followed by value for writes
+    uint8_t *rxData;                                //!< Buffer for read data
+    uint8_t rxLength;                               //!< Number of bytes to read
+    uint8_t fifoCount[BSP_MPU9150_FIFO_COUNT_SIZE]; //!< FIFO count, read before FIFO frames
+    uint8_t maxFrames;                              //!< Max number of frames to read, if FIFO count is read first
+    uint8_t frameCount;                             //!< Number of frames read
+    bool fifoCountStage;                            //!< Is FIFO count being read
+    uint32_t startTicks;                            //!< Application timer ticks on transfer start
+    BSP_MPU9150_err_E err;                          //!< Transfer result
+    BSP_MPU9150_readHandler handler;                //!< Called when read finishes, NULL for blocking transfers
+    void *context;                                  //!< Context passed to handler
+} BSP_MPU9150_twiTransfer_S;
+
 //! MPU9150 driver configuration structure
 typedef struct BSP_MPU9150_config_STRUCT {
     uint8_t mpuAddress;                     //!< MPU-9150 I2C address
     uint8_t mpuMagAddress;                  //!< MPU-9150 magnetometer I2C address
     BSP_MPU9150_gyroFsRange_E gyroRange;    //!< Gyroscope FS range
     BSP_MPU9150_accFsRange_E  accRange;     //!< Accelerometer FS range
+    BSP_MPU9150_dlpf_E dlpf;                //!< Digital low pass filter setting
+    uint16_t sampleRateHz;                  //!< Sample rate in Hz, updated to actual rate when set
+    uint16_t motionThresholdMg;             //!< Acceleration change that counts as motion, in mG
+    uint8_t motionDurationMs;               //!< Motion has to last this long to wake device from low power mode
+    BSP_MPU9150_lpWakeRate_E lpWakeRate;    //!< Accelerometer sample rate in low power mode
 
 } BSP_MPU9150_config_S;
 
 //! MPU9150 driver device structure
 typedef struct BSP_MPU9150_device_STRUCT {
     BSP_MPU9150_config_S    *config;        //!< Pointer to MPU9150 driver configuration
-    nrf_drv_twi_t           *twiInstance;   //!< Pointer to TWI instance used
+    const nrf_drv_twi_t     *twiInstance;   //!< Pointer to TWI instance used
+    const nrf_drv_twi_config_t *twiConfig;  //!< Pointer to TWI configuration, used for bus recovery
     int16_t dataBuffer[BSP_MPU9150_SENSOR_DATA_INT16_SIZE];  //!< Data buffer for sensor data
     bool isInitialized;                     //!< Is device initialized
+    BSP_MPU9150_initState_E initState;      //!< Current initialization state
     volatile bool dataReady;                //!< Is new data ready flag
-    volatile bool twiTxDone;                //!< Is TWI TX transfer finished
-    volatile bool twiRxDone;                //!< Is TWI RX transfer finished
+    volatile BSP_MPU9150_twiState_E twiState;   //!< Current TWI transfer state
+    BSP_MPU9150_twiTransfer_S twiTransfer;  //!< Current TWI transfer
+#if (BSP_MPU9150_MAG_MODE == true)
+    uint16_t magScale[3];                   //!< Magnetometer scale with fuse ROM sensitivity adjustment applied (Q8)
+#endif
+    bool lowPowerMode;                      //!< Is device in accelerometer only low power mode
+    BSP_MPU9150_lpState_E lpState;          //!< Current low power mode transition state
+    bool motionRefValid;                    //!< Is motion reference set
+    int16_t motionRef[3];                   //!< Raw accelerometer values motion is detected against
+    int16_t motionThresholdCounts;          //!< Motion threshold in raw accelerometer counts for current range
 
 } BSP_MPU9150_device_S;
 /***************************************************************************************************
@@ -274,10 +565,53 @@ typedef struct BSP_MPU9150_device_STRUCT {
 void BSP_MPU9150_init(BSP_MPU9150_device_S *inDevice,
         BSP_MPU9150_config_S *inConfig,
         BSP_MPU9150_err_E *outErr);
+void BSP_MPU9150_initStart(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_config_S *inConfig,
+        uint32_t *outWaitMs,
+        BSP_MPU9150_err_E *outErr);
+void BSP_MPU9150_initStep(BSP_MPU9150_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_MPU9150_err_E *outErr);
 void BSP_MPU9150_updateValues(BSP_MPU9150_device_S *inDevice,
         int16_t *newValues,
         BSP_MPU9150_err_E *outErr);
 
+void BSP_MPU9150_convertFrame(const BSP_MPU9150_device_S *inDevice,
+        const BSP_MPU9150_rawFrame_S *inFrame,
+        int16_t *newValues);
+void BSP_MPU9150_resetFifo(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr);
+void BSP_MPU9150_setOutputRate(BSP_MPU9150_device_S *inDevice,
+        uint16_t sampleRateHz,
+        BSP_MPU9150_err_E *outErr);
+void BSP_MPU9150_setDlpf(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_dlpf_E dlpf,
+        BSP_MPU9150_err_E *outErr);
+void BSP_MPU9150_setRanges(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_gyroFsRange_E gyroRange,
+        BSP_MPU9150_accFsRange_E accRange,
+        BSP_MPU9150_err_E *outErr);
+uint16_t BSP_MPU9150_getOutputRate(const BSP_MPU9150_device_S *inDevice);
+void BSP_MPU9150_enterLowPowerMode(BSP_MPU9150_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_MPU9150_err_E *outErr);
+void BSP_MPU9150_exitLowPowerMode(BSP_MPU9150_device_S *inDevice,
+        uint32_t *outWaitMs,
+        BSP_MPU9150_err_E *outErr);
+void BSP_MPU9150_lowPowerStep(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr);
+bool BSP_MPU9150_detectMotion(BSP_MPU9150_device_S *inDevice, const BSP_MPU9150_rawFrame_S *inFrame);
+bool BSP_MPU9150_checkFifoOverflow(BSP_MPU9150_device_S *inDevice, BSP_MPU9150_err_E *outErr);
+void BSP_MPU9150_readFrameAsync(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_rawFrame_S *outFrame,
+        BSP_MPU9150_readHandler handler,
+        void *context,
+        BSP_MPU9150_err_E *outErr);
+void BSP_MPU9150_readFifoFramesAsync(BSP_MPU9150_device_S *inDevice,
+        BSP_MPU9150_rawFrame_S *outFrames,
+        uint8_t maxFrames,
+        BSP_MPU9150_readHandler handler,
+        void *context,
+        BSP_MPU9150_err_E *outErr);
+
 void nrf_drv_mpu_twi_event_handler(nrf_drv_twi_evt_t const *p_event, void *p_context);
 
 void BSP_MPU9150_readSingleMagReg(BSP_MPU9150_device_S *inDevice,
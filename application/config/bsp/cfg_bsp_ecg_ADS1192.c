@@ -39,8 +39,10 @@ BSP_ECG_ADS1192_config_S ecgDeviceConfig = {
         .spiInstance = &instanceSpi0,
         .spiConfig = &configSpi0,
 
-        .samplingRate = BSP_ECG_ADS1192_convRate_250_SPS,
-        .pgaSetting = BSP_ECG_ADS1192_pga_12X
+        // oversampled, decimated to rate set in ecgDecimatorConfig
+        .samplingRate = BSP_ECG_ADS1192_convRate_1000_SPS,
+        .pgaSetting = BSP_ECG_ADS1192_pga_12X,
+        .leadOffDetection = true
 };
 
 /***************************************************************************************************
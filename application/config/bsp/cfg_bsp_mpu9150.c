@@ -37,6 +37,7 @@
 //! MPU-9150 device assignment structure
 BSP_MPU9150_device_S mpuDevice = {
         .twiInstance = &instanceTwi1,
+        .twiConfig = &configTwi1,
         .isInitialized = false,
         .dataReady = false
 };
@@ -46,7 +47,12 @@ BSP_MPU9150_config_S mpuDeviceConfig = {
         .mpuAddress = BSP_MPU9150_I2C_ADDRESS,
         .mpuMagAddress = BSP_MPU9150_MAG_I2C_ADDRESS,
         .gyroRange = BSP_MPU9150_gyroFsRange_2000degS,
-        .accRange = BSP_MPU9150_accFsRange_16G
+        .accRange = BSP_MPU9150_accFsRange_16G,
+        .dlpf = BSP_MPU9150_dlpf_94Hz,
+        .sampleRateHz = BSP_MPU9150_DEFAULT_SAMPLE_RATE_HZ,
+        .motionThresholdMg = 64u,
+        .motionDurationMs = 2u,
+        .lpWakeRate = BSP_MPU9150_lpWakeRate_5Hz
 };
 
 /***************************************************************************************************
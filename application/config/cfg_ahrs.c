@@ -0,0 +1,47 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    cfg_ahrs.c
+ * @author  mario.kodba
+ * @brief   Configuration for AHRS orientation filter source file.
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include "cfg_ahrs.h"
+#include "bsp_mpu9150.h"
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+#define AHRS_CFG_TWO_KP         (AHRS_Q24_ONE)  //!< 2 * Kp, proportional gain of 0.5
+#define AHRS_CFG_TWO_KI         (0)             //!< 2 * Ki, integral feedback disabled
+#define AHRS_CFG_OUTPUT_DIVIDER (2u)            //!< Orientation sent at half of sensor sample rate
+
+/***************************************************************************************************
+ *                              GLOBAL VARIABLES
+ **************************************************************************************************/
+AHRS_config_S ahrsConfig = {
+        .sampleRateHz = BSP_MPU9150_DEFAULT_SAMPLE_RATE_HZ, // filter runs on every sensor sample
+        .twoKp = AHRS_CFG_TWO_KP,
+        .twoKi = AHRS_CFG_TWO_KI,
+        .outputDivider = AHRS_CFG_OUTPUT_DIVIDER
+};
+
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
@@ -0,0 +1,49 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    cfg_ahrs.h
+ * @author  mario.kodba
+ * @brief   Configuration for AHRS orientation filter header file.
+ **************************************************************************************************/
+
+#ifndef CFG_AHRS_H_
+#define CFG_AHRS_H_
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include "ahrs.h"
+
+/***************************************************************************************************
+ *                                  CONSTANTS
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *                              DATA STRUCTURES
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *                              GLOBAL VARIABLES
+ **************************************************************************************************/
+extern AHRS_config_S ahrsConfig;
+
+/***************************************************************************************************
+ *                        PUBLIC FUNCTION DECLARATIONS
+ **************************************************************************************************/
+
+#endif // #ifndef CFG_AHRS_H_ */
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
@@ -0,0 +1,43 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    cfg_decimator.c
+ * @author  mario.kodba
+ * @brief   Configuration for ADS1192 decimation filter source file.
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include "cfg_decimator.h"
+#include "nrf51_muha.h"
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+#define DECIMATOR_CFG_OUTPUT_RATE_HZ    (250u)  //!< Rate of ADS1192 samples sent over BLE
+
+/***************************************************************************************************
+ *                              GLOBAL VARIABLES
+ **************************************************************************************************/
+DECIMATOR_config_S ecgDecimatorConfig = {
+        .outputRateHz = DECIMATOR_CFG_OUTPUT_RATE_HZ, // ADS1192 runs at power of two multiple of this rate
+        .channelCount = NRF51_MUHA_ADS1192_CHANNEL_COUNT
+};
+
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
@@ -0,0 +1,45 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    cfg_ecg_codec.c
+ * @author  mario.kodba
+ * @brief   Configuration for ADS1192 compression codec source file.
+ **************************************************************************************************/
+
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include "cfg_ecg_codec.h"
+#include "nrf51_muha.h"
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+//! Number of packets between keyframes, receiver that lost a packet resynchronizes within it
+#define ECG_CODEC_CFG_KEYFRAME_INTERVAL (16u)
+
+/***************************************************************************************************
+ *                              GLOBAL VARIABLES
+ **************************************************************************************************/
+ECG_CODEC_config_S ecgCodecConfig = {
+        .channelCount = NRF51_MUHA_ADS1192_CHANNEL_COUNT,
+        .sampleStride = sizeof(NRF51_MUHA_ecgSample_S) / sizeof(int16_t), // timestamp follows channel values
+        .keyframeInterval = ECG_CODEC_CFG_KEYFRAME_INTERVAL
+};
+
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
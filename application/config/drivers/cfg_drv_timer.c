@@ -37,7 +37,7 @@ DRV_TIMER_instance_S instanceTimer2;
 DRV_TIMER_config_S configTimer1 = {
         .timerReg = NRF_TIMER1,
         .id = DRV_TIMER_id_1,
-        .frequency = DRV_TIMER_freq_31250Hz,
+        .frequency = DRV_TIMER_freq_250KHz,
         .mode = DRV_TIMER_mode_NORMAL,
         .bitWidth = DRV_TIMER_bitWidth_16,
         .irqPriority = 3u
@@ -0,0 +1,310 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    decimator.c
+ * @author  mario.kodba
+ * @brief   Fixed point half-band FIR decimator for ADS1192 samples source file.
+ * @details ADS1192 is oversampled and output rate is reduced in cascade of decimate by 2 half-band
+ *          FIR stages. Half-band filter has every other coefficient equal to zero and is only
+ *          evaluated for samples which are kept, so intermediate stage costs 3 and last stage 8
+ *          multiplications per channel and output sample. Intermediate stages only have to protect
+ *          band passed by later stages, last stage sets the response - flat within 0.02 dB up to
+ *          0.4 of output rate and at least 55 dB attenuation of everything aliasing below it.
+ *          Samples are 16 bits, coefficients Q15 and accumulation is done in 32 bits without
+ *          overflow, which is cheap enough on Cortex-M0 to run per sample in high priority task.
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include <stddef.h>
+#include <string.h>
+
+#include "decimator.h"
+#include "compiler_abstraction.h"
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+#define DECIMATOR_Q15_SHIFT         (15u)           //!< Number of fractional bits of coefficients
+#define DECIMATOR_HALF_SHIFT        (14u)           //!< Multiplication by center tap (0.5 in Q15)
+#define DECIMATOR_ROUNDING          (1L << 14)      //!< Rounding of Q15 accumulator to sample
+
+/***************************************************************************************************
+ *                          PRIVATE FUNCTION DECLARATIONS
+ **************************************************************************************************/
+static uint8_t DECIMATOR_countStages(uint16_t outputRateHz, uint16_t inputRateHz);
+static bool DECIMATOR_stageUpdate(DECIMATOR_stage_S *stage, uint8_t channelCount, int16_t *samples);
+__INLINE static int16_t DECIMATOR_saturate(int32_t value);
+
+/***************************************************************************************************
+ *                          GLOBAL VARIABLES
+ **************************************************************************************************/
+//! Intermediate stages coefficients, passband up to 1/8 of stage input rate
+static const int16_t decimatorShortCoefficients[DECIMATOR_SHORT_COEF_COUNT] = {
+        9883, -2092, 427
+};
+
+//! Last stage coefficients, passband up to 1/5 of stage input rate
+static const int16_t decimatorLongCoefficients[DECIMATOR_LONG_COEF_COUNT] = {
+        10344, -3225, 1689, -976, 564, -309, 152, -69
+};
+
+//! Intermediate stages filter
+static const DECIMATOR_halfBand_S decimatorShortFilter = {
+        .coefficients = &decimatorShortCoefficients[0],
+        .coefficientCount = DECIMATOR_SHORT_COEF_COUNT,
+        .taps = DECIMATOR_SHORT_TAPS
+};
+
+//! Last stage filter
+static const DECIMATOR_halfBand_S decimatorLongFilter = {
+        .coefficients = &decimatorLongCoefficients[0],
+        .coefficientCount = DECIMATOR_LONG_COEF_COUNT,
+        .taps = DECIMATOR_LONG_TAPS
+};
+
+/***************************************************************************************************
+ *                         PUBLIC FUNCTION DEFINITIONS
+ **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Initializes decimator instance for given input rate, delay lines start cleared.
+ * @details Input rate has to be output rate multiplied by power of two, up to
+ *          2^DECIMATOR_MAX_STAGES. Equal rates are allowed, samples are then passed through.
+ ***************************************************************************************************
+ * @param [in]  *decimator   - pointer to decimator instance.
+ * @param [in]  *config      - pointer to decimator configuration.
+ * @param [in]  inputRateHz  - rate at which DECIMATOR_update is called.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void DECIMATOR_init(DECIMATOR_instance_S *decimator,
+        const DECIMATOR_config_S *config,
+        uint16_t inputRateHz,
+        DECIMATOR_err_E *outErr) {
+
+    DECIMATOR_err_E err = DECIMATOR_err_NONE;
+    uint8_t stageCount = 0u;
+    uint8_t i = 0u;
+
+    if((decimator == NULL) || (config == NULL)) {
+        err = DECIMATOR_err_NULL_PARAM;
+    } else if((config->channelCount == 0u) || (config->channelCount > DECIMATOR_MAX_CHANNELS) ||
+            (config->outputRateHz == 0u)) {
+        err = DECIMATOR_err_INVALID_PARAM;
+    } else {
+        stageCount = DECIMATOR_countStages(config->outputRateHz, inputRateHz);
+
+        if(stageCount > DECIMATOR_MAX_STAGES) {
+            err = DECIMATOR_err_INVALID_PARAM;
+        }
+    }
+
+    if(err == DECIMATOR_err_NONE) {
+        decimator->config = config;
+        decimator->stageCount = stageCount;
+
+        memset(&decimator->shortDelay[0][0], 0, sizeof(decimator->shortDelay));
+        memset(&decimator->longDelay[0], 0, sizeof(decimator->longDelay));
+
+        for(i = 0u; i < stageCount; i++) {
+            // only last stage needs sharp transition band
+            if(i == (stageCount - 1u)) {
+                decimator->stages[i].filter = &decimatorLongFilter;
+                decimator->stages[i].delay = &decimator->longDelay[0];
+            } else {
+                decimator->stages[i].filter = &decimatorShortFilter;
+                decimator->stages[i].delay = &decimator->shortDelay[i][0];
+            }
+
+            decimator->stages[i].index = 0u;
+            decimator->stages[i].outputPhase = false;
+        }
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Checks if decimator can be initialized for given input rate.
+ * @details Used to validate sensor rate before sensor is reconfigured, so decimator is never left
+ *          without valid configuration.
+ ***************************************************************************************************
+ * @param [in]  *config      - pointer to decimator configuration.
+ * @param [in]  inputRateHz  - rate at which DECIMATOR_update would be called.
+ ***************************************************************************************************
+ * @return true if input rate is supported, false otherwise.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+bool DECIMATOR_isRateSupported(const DECIMATOR_config_S *config, uint16_t inputRateHz) {
+
+    return (config != NULL) && (config->outputRateHz != 0u) &&
+            (DECIMATOR_countStages(config->outputRateHz, inputRateHz) <= DECIMATOR_MAX_STAGES);
+}
+
+/***********************************************************************************************//**
+ * @brief Feeds single input sample of all channels through decimator stages.
+ ***************************************************************************************************
+ * @param [in]  *decimator - pointer to decimator instance.
+ * @param [in]  *input     - pointer to input values, one per channel.
+ * @param [out] *output    - filled with output values, one per channel, when output is due. May
+ *                           point to the same memory as input.
+ ***************************************************************************************************
+ * @return true if output was filled, false otherwise.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+bool DECIMATOR_update(DECIMATOR_instance_S *decimator, const int16_t *input, int16_t *output) {
+
+    int16_t samples[DECIMATOR_MAX_CHANNELS];
+    uint8_t channelCount = decimator->config->channelCount;
+    bool outputReady = true;
+    uint8_t i = 0u;
+
+    for(i = 0u; i < channelCount; i++) {
+        samples[i] = input[i];
+    }
+
+    // every stage consumes two samples for each one it passes on
+    for(i = 0u; (i < decimator->stageCount) && (outputReady == true); i++) {
+        outputReady = DECIMATOR_stageUpdate(&decimator->stages[i], channelCount, &samples[0]);
+    }
+
+    if(outputReady == true) {
+        for(i = 0u; i < channelCount; i++) {
+            output[i] = samples[i];
+        }
+    }
+
+    return outputReady;
+}
+
+/***************************************************************************************************
+ *                         PRIVATE FUNCTION DEFINITIONS
+ **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Counts decimate by 2 stages needed to reduce input rate to output rate.
+ ***************************************************************************************************
+ * @param [in]  outputRateHz - decimator output rate, not 0.
+ * @param [in]  inputRateHz  - decimator input rate.
+ ***************************************************************************************************
+ * @return number of stages, above DECIMATOR_MAX_STAGES if input rate is not supported.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint8_t DECIMATOR_countStages(uint16_t outputRateHz, uint16_t inputRateHz) {
+
+    uint32_t rate = outputRateHz;
+    uint8_t stageCount = 0u;
+
+    while((rate < inputRateHz) && (stageCount <= DECIMATOR_MAX_STAGES)) {
+        rate <<= 1u;
+        stageCount++;
+    }
+
+    if(rate != inputRateHz) {
+        stageCount = DECIMATOR_MAX_STAGES + 1u;
+    }
+
+    return stageCount;
+}
+
+/***********************************************************************************************//**
+ * @brief Pushes sample of all channels to stage delay lines and filters them on every other call.
+ * @details Each sample is stored twice, one delay line length apart, so filter window starting
+ *          at newest sample is always contiguous.
+ ***************************************************************************************************
+ * @param [in]      *stage        - pointer to decimator stage.
+ * @param [in]      channelCount  - number of channels.
+ * @param [in,out]  *samples      - input values, replaced with output values when output is due.
+ ***************************************************************************************************
+ * @return true if output was produced, false otherwise.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static bool DECIMATOR_stageUpdate(DECIMATOR_stage_S *stage, uint8_t channelCount, int16_t *samples) {
+
+    const DECIMATOR_halfBand_S *filter = stage->filter;
+    const int16_t *window = NULL;
+    int16_t *delay = NULL;
+    uint8_t taps = filter->taps;
+    uint8_t center = taps >> 1u;
+    bool outputReady = stage->outputPhase;
+    int32_t acc = 0;
+    uint8_t offset = 0u;
+    uint8_t i = 0u;
+    uint8_t k = 0u;
+
+    stage->index = (stage->index == 0u) ? (taps - 1u) : (stage->index - 1u);
+    stage->outputPhase = !outputReady;
+
+    for(i = 0u; i < channelCount; i++) {
+        delay = &stage->delay[i * 2u * taps];
+        delay[stage->index] = samples[i];
+        delay[stage->index + taps] = samples[i];
+
+        if(outputReady == true) {
+            window = &delay[stage->index];
+            acc = ((int32_t) window[center] << DECIMATOR_HALF_SHIFT) + DECIMATOR_ROUNDING;
+
+            // symmetric taps share coefficient, zero taps are skipped
+            for(k = 0u; k < filter->coefficientCount; k++) {
+                offset = (2u * k) + 1u;
+                acc += filter->coefficients[k] * ((int32_t) window[center - offset] + window[center + offset]);
+            }
+
+            samples[i] = DECIMATOR_saturate(acc >> DECIMATOR_Q15_SHIFT);
+        }
+    }
+
+    return outputReady;
+}
+
+/***********************************************************************************************//**
+ * @brief Limits value to 16 bits signed range.
+ ***************************************************************************************************
+ * @param [in]  value - value to be limited.
+ * @return limited value.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static int16_t DECIMATOR_saturate(int32_t value) {
+
+    int16_t result = 0;
+
+    if(value > INT16_MAX) {
+        result = INT16_MAX;
+    } else if(value < INT16_MIN) {
+        result = INT16_MIN;
+    } else {
+        result = (int16_t) value;
+    }
+
+    return result;
+}
+
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
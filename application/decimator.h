@@ -0,0 +1,104 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    decimator.h
+ * @author  mario.kodba
+ * @brief   Fixed point half-band FIR decimator for ADS1192 samples header file.
+ **************************************************************************************************/
+
+#ifndef DECIMATOR_H_
+#define DECIMATOR_H_
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+#define DECIMATOR_MAX_CHANNELS      (2u)    //!< Max number of channels filtered in lockstep
+#define DECIMATOR_MAX_STAGES        (4u)    //!< Max number of decimate by 2 stages (decimation by 16)
+#define DECIMATOR_SHORT_COEF_COUNT  (3u)    //!< Number of non-zero side coefficients of intermediate stages
+#define DECIMATOR_LONG_COEF_COUNT   (8u)    //!< Number of non-zero side coefficients of last stage
+//! Number of taps of intermediate stages
+#define DECIMATOR_SHORT_TAPS        ((4u * DECIMATOR_SHORT_COEF_COUNT) - 1u)
+//! Number of taps of last stage
+#define DECIMATOR_LONG_TAPS         ((4u * DECIMATOR_LONG_COEF_COUNT) - 1u)
+
+/***************************************************************************************************
+ *                              ENUMERATIONS
+ **************************************************************************************************/
+//! Decimator error enumeration
+typedef enum DECIMATOR_err_ENUM {
+    DECIMATOR_err_NONE          = 0u,   //!< No error
+    DECIMATOR_err_NULL_PARAM,           //!< NULL parameter error
+    DECIMATOR_err_INVALID_PARAM         //!< Parameter out of range error
+} DECIMATOR_err_E;
+
+/***************************************************************************************************
+ *                              DATA STRUCTURES
+ **************************************************************************************************/
+//! Decimator configuration structure
+typedef struct DECIMATOR_config_STRUCT {
+    uint16_t outputRateHz;                      //!< Output sample rate, input rate divided by power of two
+    uint8_t channelCount;                       //!< Number of channels in each sample
+} DECIMATOR_config_S;
+
+//! Half-band filter, center tap is 0.5 and every other tap is zero
+typedef struct DECIMATOR_halfBand_STRUCT {
+    const int16_t *coefficients;                //!< Side coefficients in Q15, from center outwards
+    uint8_t coefficientCount;                   //!< Number of side coefficients
+    uint8_t taps;                               //!< Filter length
+} DECIMATOR_halfBand_S;
+
+//! Decimate by 2 stage
+typedef struct DECIMATOR_stage_STRUCT {
+    const DECIMATOR_halfBand_S *filter;         //!< Pointer to stage filter
+    int16_t *delay;                             //!< Delay lines of all channels, each stored twice in a row
+    uint8_t index;                              //!< Position of newest sample in delay lines
+    bool outputPhase;                           //!< Is output produced on next input sample
+} DECIMATOR_stage_S;
+
+//! Decimator instance structure
+typedef struct DECIMATOR_instance_STRUCT {
+    const DECIMATOR_config_S *config;           //!< Pointer to decimator configuration
+    DECIMATOR_stage_S stages[DECIMATOR_MAX_STAGES]; //!< Stages, in order of processing
+    uint8_t stageCount;                         //!< Number of used stages, 0 passes samples through
+    //! Delay lines of intermediate stages
+    int16_t shortDelay[DECIMATOR_MAX_STAGES - 1u][DECIMATOR_MAX_CHANNELS * 2u * DECIMATOR_SHORT_TAPS];
+    //! Delay lines of last stage
+    int16_t longDelay[DECIMATOR_MAX_CHANNELS * 2u * DECIMATOR_LONG_TAPS];
+} DECIMATOR_instance_S;
+
+/***************************************************************************************************
+ *                              GLOBAL VARIABLES
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *                         PUBLIC FUNCTION DECLARATIONS
+ **************************************************************************************************/
+void DECIMATOR_init(DECIMATOR_instance_S *decimator,
+        const DECIMATOR_config_S *config,
+        uint16_t inputRateHz,
+        DECIMATOR_err_E *outErr);
+bool DECIMATOR_isRateSupported(const DECIMATOR_config_S *config, uint16_t inputRateHz);
+bool DECIMATOR_update(DECIMATOR_instance_S *decimator, const int16_t *input, int16_t *output);
+
+#endif // #ifndef DECIMATOR_H_
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
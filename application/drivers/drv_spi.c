@@ -26,6 +26,7 @@
 #include "hal_spi.h"
 
 #include "nrf_gpio.h"
+#include "app_util_platform.h"
 /***************************************************************************************************
  *                              DEFINES
  **************************************************************************************************/
@@ -39,10 +40,25 @@ static DRV_SPI_control_block_S DRV_SPI_controlBlock[DRV_SPI_id_COUNT];
  *                          PRIVATE FUNCTION DECLARATIONS
  **************************************************************************************************/
 static void DRV_SPI_initPins(DRV_SPI_instance_S *spiInstance);
+static void DRV_SPI_startTransfer(DRV_SPI_control_block_S *block);
+static void DRV_SPI_irqHandler(DRV_SPI_id_E spiInstanceId);
 
 /***************************************************************************************************
  *                          PUBLIC FUNCTION DEFINITIONS
  **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief SPI0 IRQ Handler.
+ * @details Shared with TWI0, which is not used (TWI0_ENABLED is 0).
+ ***************************************************************************************************
+ * @param [in]  - None.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void SPI0_TWI0_IRQHandler(void) {
+    DRV_SPI_irqHandler(DRV_SPI_id_0);
+}
+
 /***********************************************************************************************//**
  * @brief Initializes SPI instance.
  ***************************************************************************************************
@@ -68,6 +84,9 @@ void DRV_SPI_init(DRV_SPI_instance_S *spiInstance,
         DRV_SPI_control_block_S *block = &DRV_SPI_controlBlock[spiInstance->config->id];
         block->callbackFunction = irqHandler;
         block->context = spiInstance->config->context;
+        block->instance = spiInstance;
+        block->queueHead = 0u;
+        block->queueCount = 0u;
         // SPI pins setup
         DRV_SPI_initPins(spiInstance);
 
@@ -83,16 +102,11 @@ void DRV_SPI_init(DRV_SPI_instance_S *spiInstance,
                 spiInstance->config->mode,
                 spiInstance->config->bitOrder);
 
-        if(irqHandler) {
-            // enable interrupt on READY event
-            HAL_SPI_interruptEnable(spi);
-        }
         // enable SPI instance
         HAL_SPI_enableSpi(spi);
 
-        if(irqHandler) {
-            DRV_COMMON_enableIRQPriority(&spiInstance->irq, spiInstance->config->irqPriority);
-        }
+        // interrupt on READY event is enabled only while queued transfers are in progress
+        DRV_COMMON_enableIRQPriority(spiInstance->spiStruct, spiInstance->config->irqPriority);
         if(err == DRV_SPI_err_NONE) {
             spiInstance->isInitialized = true;
         }
@@ -128,7 +142,9 @@ void DRV_SPI_masterTxRxBlocking(const DRV_SPI_instance_S *spiInstance,
     volatile uint32_t *SPI_DATA_READY;
     uint32_t tmp;
 
-    if(spiInstance != NULL || inTxData != NULL || outRxData != NULL) {
+    if((spiInstance != NULL) && (DRV_SPI_controlBlock[spiInstance->config->id].queueCount != 0u)) {
+        spiErr = DRV_SPI_err_BUSY;
+    } else if((spiInstance != NULL) && (inTxData != NULL) && (outRxData != NULL)) {
         // which SPI instance to take
         NRF_SPI_Type *SPI = spiInstance->spiStruct;
 
@@ -190,7 +206,9 @@ void DRV_SPI_masterTxBlocking(const DRV_SPI_instance_S *spiInstance,
     // bytes received are being ignored
     volatile uint32_t dummyRead;
 
-    if(spiInstance != NULL || inTxData != NULL) {
+    if((spiInstance != NULL) && (DRV_SPI_controlBlock[spiInstance->config->id].queueCount != 0u)) {
+        spiErr = DRV_SPI_err_BUSY;
+    } else if((spiInstance != NULL) && (inTxData != NULL)) {
         // which SPI instance to take
         NRF_SPI_Type *SPI = spiInstance->spiStruct;
 
@@ -244,7 +262,9 @@ void DRV_SPI_masterRxBlocking(const DRV_SPI_instance_S *spiInstance,
 
     DRV_SPI_err_E spiErr = DRV_SPI_err_NONE;
 
-    if(spiInstance != NULL || outRxData != NULL) {
+    if((spiInstance != NULL) && (DRV_SPI_controlBlock[spiInstance->config->id].queueCount != 0u)) {
+        spiErr = DRV_SPI_err_BUSY;
+    } else if((spiInstance != NULL) && (outRxData != NULL)) {
         // which SPI instance to take
         NRF_SPI_Type *SPI = spiInstance->spiStruct;
 
@@ -280,9 +300,142 @@ void DRV_SPI_masterRxBlocking(const DRV_SPI_instance_S *spiInstance,
     }
 }
 
+/***********************************************************************************************//**
+ * @brief Function queues SPI transfer, done from SPI interrupt without blocking.
+ * @details Transfer starts immediately if SPI instance is idle, otherwise it starts right after
+ *          previously queued transfers. Transfer callback is called from SPI interrupt when all
+ *          bytes are received. Blocking functions return DRV_SPI_err_BUSY while transfers are queued.
+ ***************************************************************************************************
+ * @param [in]   *spiInstance   - pointer to SPI instance structure.
+ * @param [in]   *transfer      - pointer to transfer descriptor, must stay valid until transfer is done.
+ * @param [out]  *outErr        - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void DRV_SPI_transfer(const DRV_SPI_instance_S *spiInstance,
+        DRV_SPI_transfer_S *transfer,
+        DRV_SPI_err_E *outErr) {
+
+    DRV_SPI_err_E spiErr = DRV_SPI_err_NONE;
+
+    if((spiInstance != NULL) && (transfer != NULL) && (transfer->size != 0u)) {
+        DRV_SPI_control_block_S *block = &DRV_SPI_controlBlock[spiInstance->config->id];
+
+        CRITICAL_REGION_ENTER();
+        if(block->queueCount < DRV_SPI_QUEUE_SIZE) {
+            block->queue[(block->queueHead + block->queueCount) % DRV_SPI_QUEUE_SIZE] = transfer;
+            block->queueCount++;
+
+            if(block->queueCount == 1u) {
+                // SPI instance was idle
+                DRV_SPI_startTransfer(block);
+            }
+        } else {
+            spiErr = DRV_SPI_err_QUEUE_FULL;
+        }
+        CRITICAL_REGION_EXIT();
+    } else {
+        spiErr = DRV_SPI_err_NULL_PARAM;
+    }
+
+    if(outErr != NULL) {
+        *outErr = spiErr;
+    }
+}
+
 /***************************************************************************************************
  *                         PRIVATE FUNCTION DEFINITIONS
  **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Starts first queued transfer on given SPI instance.
+ * @details TXD is double buffered, so second byte is written right after the first one and
+ *          SPI clock runs without gaps between bytes.
+ ***************************************************************************************************
+ * @param [in]   *block         - pointer to SPI instance control block.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void DRV_SPI_startTransfer(DRV_SPI_control_block_S *block) {
+
+    DRV_SPI_transfer_S *transfer = block->queue[block->queueHead];
+    NRF_SPI_Type *SPI = block->instance->spiStruct;
+    uint8_t orc = block->instance->config->orc;
+
+    block->txIndex = 0u;
+    block->rxIndex = 0u;
+
+    // enable slave (slave select active low)
+    nrf_gpio_pin_clear(block->instance->config->ssPin);
+
+    SPI->EVENTS_READY = 0u;
+    HAL_SPI_interruptEnable(SPI);
+
+    while((block->txIndex < transfer->size) && (block->txIndex < 2u)) {
+        SPI->TXD = (transfer->txData != NULL) ? transfer->txData[block->txIndex] : orc;
+        block->txIndex++;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Common SPI IRQ handler, moves bytes of transfer in progress and starts next transfer.
+ ***************************************************************************************************
+ * @param [in]   spiInstanceId  - SPI instance ID.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void DRV_SPI_irqHandler(DRV_SPI_id_E spiInstanceId) {
+
+    DRV_SPI_control_block_S *block = &DRV_SPI_controlBlock[spiInstanceId];
+    DRV_SPI_event_E event = DRV_SPI_event_DONE;
+    NRF_SPI_Type *SPI = block->instance->spiStruct;
+    DRV_SPI_transfer_S *transfer = NULL;
+    uint8_t rxByte = 0u;
+
+    if(SPI->EVENTS_READY != 0u) {
+        SPI->EVENTS_READY = 0u;
+        transfer = block->queue[block->queueHead];
+
+        rxByte = (uint8_t) SPI->RXD;
+        if(transfer->rxData != NULL) {
+            transfer->rxData[block->rxIndex] = rxByte;
+        }
+        block->rxIndex++;
+
+        if(block->txIndex < transfer->size) {
+            SPI->TXD = (transfer->txData != NULL) ?
+                    transfer->txData[block->txIndex] : block->instance->config->orc;
+            block->txIndex++;
+        }
+
+        if(block->rxIndex >= transfer->size) {
+            // disable slave (slave select active low)
+            nrf_gpio_pin_set(block->instance->config->ssPin);
+
+            // transfer stays queued during callback, so transfers queued from callback only get appended
+            if(transfer->callbackFunction != NULL) {
+                transfer->callbackFunction(&event, transfer->context);
+            } else if(block->callbackFunction != NULL) {
+                block->callbackFunction(&event, block->context);
+            }
+
+            CRITICAL_REGION_ENTER();
+            block->queueHead = (block->queueHead + 1u) % DRV_SPI_QUEUE_SIZE;
+            block->queueCount--;
+
+            if(block->queueCount != 0u) {
+                // next transfer runs back-to-back
+                DRV_SPI_startTransfer(block);
+            } else {
+                HAL_SPI_interruptDisable(SPI);
+            }
+            CRITICAL_REGION_EXIT();
+        }
+    }
+}
+
 /***********************************************************************************************//**
  * @brief Initializes pins for given SPI instance.
  ***************************************************************************************************
@@ -32,13 +32,20 @@
 #include "drv_common.h"
 
 #include <stdint.h>
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+#define DRV_SPI_QUEUE_SIZE      (4u)                    //!< Maximum number of queued transfers per SPI instance.
+
 /***************************************************************************************************
  *                              ENUMERATIONS
  **************************************************************************************************/
 //! SPI error enumeration
 typedef enum DRV_SPI_err_ENUM {
     DRV_SPI_err_NONE       = 0u,                        //!< SPI no error.
-    DRV_SPI_err_NULL_PARAM                              //!< SPI null parameter error.
+    DRV_SPI_err_NULL_PARAM,                             //!< SPI null parameter error.
+    DRV_SPI_err_QUEUE_FULL,                             //!< SPI transfer queue full error.
+    DRV_SPI_err_BUSY                                    //!< SPI instance busy with queued transfers.
 } DRV_SPI_err_E;
 
 //! SPI driver frequency enumeration
@@ -85,11 +92,26 @@ typedef enum DRV_SPI_id_ENUM {
 //! SPI callback function pointer
 typedef void (*DRV_SPI_IRQHandler)(DRV_SPI_event_E *event, void *context);
 
+//! SPI transfer descriptor structure, must stay valid until transfer is done
+typedef struct DRV_SPI_transfer_STRUCT {
+    const uint8_t *txData;                              //!< TX data, over-run character is sent if NULL.
+    uint8_t *rxData;                                    //!< RX data buffer, received bytes are ignored if NULL.
+    uint16_t size;                                      //!< Size in bytes of RX/TX data.
+    DRV_SPI_IRQHandler callbackFunction;                //!< Callback on transfer done, instance callback is used if NULL.
+    void *context;                                      //!< Context passed to transfer callback function.
+} DRV_SPI_transfer_S;
+
 //! SPI control block structure
 typedef struct DRV_SPI_control_block_STRUCT {
     DRV_SPI_IRQHandler callbackFunction;                //!< Callback function for SPIx interrupt.
     void *context;                                      //!< Context passed to SPI callback function.
 
+    const struct DRV_SPI_instance_STRUCT *instance;     //!< SPI instance using this control block.
+    DRV_SPI_transfer_S *queue[DRV_SPI_QUEUE_SIZE];      //!< Queued transfers, first one is in progress.
+    uint8_t queueHead;                                  //!< Index of transfer in progress.
+    volatile uint8_t queueCount;                        //!< Number of queued transfers.
+    uint16_t txIndex;                                   //!< Next byte to write to TXD.
+    uint16_t rxIndex;                                   //!< Next byte to read from RXD.
 } DRV_SPI_control_block_S;
 
 //! SPI configuration structure
@@ -138,6 +160,9 @@ void DRV_SPI_masterRxBlocking(const DRV_SPI_instance_S *spiInstance,
         uint16_t inSize,
         uint8_t *outRxData,
         DRV_SPI_err_E *outErr);
+void DRV_SPI_transfer(const DRV_SPI_instance_S *spiInstance,
+        DRV_SPI_transfer_S *transfer,
+        DRV_SPI_err_E *outErr);
 
 #endif // #ifndef DRV_SPI_H_
 /***************************************************************************************************
@@ -28,7 +28,11 @@
 /***************************************************************************************************
  *                              DEFINES
  **************************************************************************************************/
-#define DRV_TIMER_MAX_VALUE_16_BIT      (65535u)
+#define DRV_TIMER_MAX_VALUE_8_BIT       (0xFFu)
+#define DRV_TIMER_MAX_VALUE_16_BIT      (0xFFFFu)
+#define DRV_TIMER_MAX_VALUE_24_BIT      (0xFFFFFFu)
+#define DRV_TIMER_MAX_VALUE_32_BIT      (0xFFFFFFFFu)
+#define DRV_TIMER_BASE_FREQUENCY_HZ     (16000000u)     //!< Timer clock frequency with prescaler 0
 
 //!< Timer time resolution settings
 #define DRV_TIMER_RESOLUTION_16MHZ      (0.0625f)       //!< TIMER resolution with 16MHz
@@ -407,6 +411,73 @@ void DRV_TIMER_compareDisableTimer(DRV_TIMER_instance_S *tInstance,
     }
 }
 
+/***********************************************************************************************//**
+ * @brief Reads value captured to one of timer CC[n] registers, without triggering capture.
+ * @details Meant for values captured by hardware, e.g. CAPTURE task triggered through PPI.
+ ***************************************************************************************************
+ * @param [in]   *tInstance     - pointer to timer instance structure.
+ * @param [in]   channel        - timer CC channel.
+ * @param [out]  *outErr        - error parameter.
+ * @return Captured timer value.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint32_t DRV_TIMER_readCapture(const DRV_TIMER_instance_S *tInstance,
+        DRV_TIMER_cc_E channel,
+        DRV_TIMER_err_E *outErr) {
+
+    DRV_TIMER_err_E err = DRV_TIMER_err_NONE;
+    uint32_t timerVal = 0u;
+
+    if(tInstance != NULL) {
+        if(DRV_TIMER_isInit[tInstance->config->id] == true) {
+            timerVal = HAL_TIMER_getValue(tInstance->config->timerReg, channel);
+        } else {
+            err = DRV_TIMER_err_NO_TIMER_INSTANCE;
+        }
+    } else {
+        err = DRV_TIMER_err_NULL_PARAM;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+
+    return timerVal;
+}
+
+/***********************************************************************************************//**
+ * @brief Returns address of given timer task register, to be used as PPI task end point.
+ ***************************************************************************************************
+ * @param [in]   *tInstance     - pointer to timer instance structure.
+ * @param [in]   task           - timer task.
+ * @param [out]  *outErr        - error parameter.
+ * @return Task register address.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint32_t DRV_TIMER_getTaskAddress(const DRV_TIMER_instance_S *tInstance,
+        DRV_TIMER_task_E task,
+        DRV_TIMER_err_E *outErr) {
+
+    DRV_TIMER_err_E err = DRV_TIMER_err_NONE;
+    uint32_t taskAddress = 0u;
+
+    if(tInstance != NULL) {
+        taskAddress = (uint32_t) tInstance->config->timerReg + (uint32_t) task;
+    } else {
+        err = DRV_TIMER_err_NULL_PARAM;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+
+    return taskAddress;
+}
+
 /***********************************************************************************************//**
  * @brief Function returns time difference in us between two time measurements.
  ***************************************************************************************************
@@ -422,12 +493,7 @@ uint32_t DRV_TIMER_getTimeDiff(const DRV_TIMER_instance_S *tInstance,
         uint32_t *start,
         uint32_t *stop) {
 
-    uint32_t timerDiff = 0u;
-    if(*stop < *start) {
-        timerDiff = *stop + DRV_TIMER_MAX_VALUE_16_BIT - *start;
-    } else {
-        timerDiff = *stop - *start;
-    }
+    uint32_t timerDiff = DRV_TIMER_getTickDiff(tInstance, *start, *stop);
     float timeResUs = DRV_TIMER_getTimerResolution(tInstance);
     // number of ticks * timer resolution
     float realTimeUs = ((float) timerDiff * timeResUs);
@@ -435,6 +501,58 @@ uint32_t DRV_TIMER_getTimeDiff(const DRV_TIMER_instance_S *tInstance,
     return (uint32_t) realTimeUs;
 }
 
+/***********************************************************************************************//**
+ * @brief Function returns number of timer ticks between two time measurements.
+ * @details Timer overflow is handled for timer bit width, so difference is correct as long as
+ *          it is shorter than one full timer period.
+ ***************************************************************************************************
+ * @param [in]   *tInstance  - pointer to timer instance structure.
+ * @param [in]   start       - first timer value.
+ * @param [in]   stop        - second timer value.
+ * @return Number of ticks between start and stop values.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint32_t DRV_TIMER_getTickDiff(const DRV_TIMER_instance_S *tInstance,
+        uint32_t start,
+        uint32_t stop) {
+
+    uint32_t mask = DRV_TIMER_MAX_VALUE_32_BIT;
+
+    switch(tInstance->config->bitWidth) {
+        case DRV_TIMER_bitWidth_8:
+            mask = DRV_TIMER_MAX_VALUE_8_BIT;
+            break;
+        case DRV_TIMER_bitWidth_16:
+            mask = DRV_TIMER_MAX_VALUE_16_BIT;
+            break;
+        case DRV_TIMER_bitWidth_24:
+            mask = DRV_TIMER_MAX_VALUE_24_BIT;
+            break;
+        case DRV_TIMER_bitWidth_32:
+            mask = DRV_TIMER_MAX_VALUE_32_BIT;
+            break;
+    }
+
+    return ((stop - start) & mask);
+}
+
+/***********************************************************************************************//**
+ * @brief Function returns timer frequency in Hz.
+ ***************************************************************************************************
+ * @param [in]   *tInstance  - pointer to timer instance structure.
+ * @return Timer frequency [Hz].
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint32_t DRV_TIMER_getFrequencyHz(const DRV_TIMER_instance_S *tInstance) {
+
+    // every prescaler step halves 16 MHz timer clock
+    return (DRV_TIMER_BASE_FREQUENCY_HZ >> (uint32_t) tInstance->config->frequency);
+}
+
 /***************************************************************************************************
  *                         PRIVATE FUNCTION DEFINITIONS
  ******************************************************************************/
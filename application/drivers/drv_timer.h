@@ -30,6 +30,7 @@
 #include "drv_common.h"
 
 #include <stdint.h>
+#include <stddef.h>
 /***************************************************************************************************
  *                              ENUMERATIONS
  **************************************************************************************************/
@@ -163,9 +164,19 @@ void DRV_TIMER_incrementTimer(DRV_TIMER_instance_S *tInstance, DRV_TIMER_err_E *
 uint32_t DRV_TIMER_captureTimer(DRV_TIMER_instance_S *tInstance,
         DRV_TIMER_cc_E channel,
         DRV_TIMER_err_E *outErr);
+uint32_t DRV_TIMER_readCapture(const DRV_TIMER_instance_S *tInstance,
+        DRV_TIMER_cc_E channel,
+        DRV_TIMER_err_E *outErr);
+uint32_t DRV_TIMER_getTaskAddress(const DRV_TIMER_instance_S *tInstance,
+        DRV_TIMER_task_E task,
+        DRV_TIMER_err_E *outErr);
 uint32_t DRV_TIMER_getTimeDiff(const DRV_TIMER_instance_S *tInstance,
         uint32_t *start,
         uint32_t *stop);
+uint32_t DRV_TIMER_getTickDiff(const DRV_TIMER_instance_S *tInstance,
+        uint32_t start,
+        uint32_t stop);
+uint32_t DRV_TIMER_getFrequencyHz(const DRV_TIMER_instance_S *tInstance);
 void DRV_TIMER_compareEnableTimer(DRV_TIMER_instance_S *tInstance,
         DRV_TIMER_cc_E channel,
         uint32_t compareValue,
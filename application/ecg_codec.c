@@ -0,0 +1,445 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    ecg_codec.c
+ * @author  mario.kodba
+ * @brief   Lossless ADS1192 sample compression for BLE notifications source file.
+ * @details Each sample is predicted from previous ones and only prediction residual is sent, Rice
+ *          coded. Predictor and Rice parameter are selected per packet for each channel, from
+ *          samples available for the packet, so packet holds as many samples as fit into
+ *          ECG_CODEC_PACKET_SIZE. Channel 2 can additionally be predicted from residual of channel
+ *          1, as most of ECG signal is common to both leads. Residual with Rice quotient of
+ *          ECG_CODEC_ESCAPE_LENGTH or more is replaced by raw sample, so any input is coded
+ *          losslessly. Every keyframe starts with raw sample, so receiver that missed a packet
+ *          resynchronizes on next keyframe. Sample count and keyframe flag are carried by BLE
+ *          stream record header.
+ *
+ *          Packet layout, bits are packed MSB first:
+ *          - for each channel: predictor (ECG_CODEC_predictor_E, 2 bits) and Rice parameter
+ *            k (4 bits).
+ *          - keyframe only: first sample, 16 bits per channel.
+ *          - remaining samples, channels interleaved. Residual r is mapped to u = 2r for r >= 0
+ *            and u = -2r - 1 otherwise, sent as (u >> k) ones, zero and low k bits of u. Escaped
+ *            value is sent as ECG_CODEC_ESCAPE_LENGTH ones and raw 16 bit sample.
+ *          - padding with zeros to whole byte.
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include <stddef.h>
+#include <string.h>
+
+#include "ecg_codec.h"
+#include "compiler_abstraction.h"
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+//! Number of bits in packet
+#define ECG_CODEC_PACKET_BITS       (ECG_CODEC_PACKET_SIZE * 8u)
+
+/***************************************************************************************************
+ *                          PRIVATE FUNCTION DECLARATIONS
+ **************************************************************************************************/
+static void ECG_CODEC_selectParameters(const ECG_CODEC_instance_S *codec,
+        const int16_t *samples,
+        uint8_t first,
+        uint8_t count,
+        int16_t history[2u][ECG_CODEC_MAX_CHANNELS],
+        uint8_t channel,
+        uint8_t *outPredictor,
+        uint8_t *outRiceParam);
+__INLINE static int32_t ECG_CODEC_residual(uint8_t predictor,
+        const int16_t *sample,
+        int16_t prev[2u][ECG_CODEC_MAX_CHANNELS],
+        uint8_t channel);
+__INLINE static uint32_t ECG_CODEC_mapResidual(int32_t residual);
+__INLINE static uint8_t ECG_CODEC_riceBits(uint32_t value, uint8_t riceParam);
+static void ECG_CODEC_writeRice(uint8_t *packet, uint16_t *bitPosition, uint32_t value, uint8_t riceParam, int16_t sample);
+static void ECG_CODEC_writeBits(uint8_t *packet, uint16_t *bitPosition, uint32_t value, uint8_t width);
+
+/***************************************************************************************************
+ *                         PUBLIC FUNCTION DEFINITIONS
+ **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Initializes codec instance, first encoded packet is keyframe.
+ ***************************************************************************************************
+ * @param [in]  *codec       - pointer to codec instance.
+ * @param [in]  *config      - pointer to codec configuration.
+ * @param [out] *outErr      - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void ECG_CODEC_init(ECG_CODEC_instance_S *codec, const ECG_CODEC_config_S *config, ECG_CODEC_err_E *outErr) {
+
+    ECG_CODEC_err_E err = ECG_CODEC_err_NONE;
+
+    if((codec == NULL) || (config == NULL)) {
+        err = ECG_CODEC_err_NULL_PARAM;
+    } else if((config->channelCount == 0u) || (config->channelCount > ECG_CODEC_MAX_CHANNELS) ||
+            (config->sampleStride < config->channelCount) || (config->keyframeInterval == 0u)) {
+        err = ECG_CODEC_err_INVALID_PARAM;
+    }
+
+    if(err == ECG_CODEC_err_NONE) {
+        codec->config = config;
+        codec->packetsToKeyframe = 0u;
+        codec->keyframeEncoded = false;
+
+        memset(&codec->history[0][0], 0, sizeof(codec->history));
+        memset(&codec->nextHistory[0][0], 0, sizeof(codec->nextHistory));
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Encodes as many samples as fit into one packet.
+ * @details Packet is only produced when it is full - next sample would not fit or it holds
+ *          ECG_CODEC_MAX_SAMPLES samples, otherwise 0 is returned and encoding should be retried
+ *          with more samples. Codec state is not changed, ECG_CODEC_commit has to be called once
+ *          packet is sent, so packet can be encoded again if sending fails.
+ ***************************************************************************************************
+ * @param [in]  *codec       - pointer to codec instance.
+ * @param [in]  *samples     - samples to encode, channel values of sample are next to each other.
+ * @param [in]  sampleCount  - number of samples available, ECG_CODEC_MAX_SAMPLES is always enough.
+ * @param [out] *outPacket   - encoded packet, up to ECG_CODEC_PACKET_SIZE bytes.
+ * @param [out] *outSize     - encoded packet size in bytes.
+ ***************************************************************************************************
+ * @return Number of samples encoded into packet, 0 if more samples are needed.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint8_t ECG_CODEC_encode(ECG_CODEC_instance_S *codec,
+        const int16_t *samples,
+        uint16_t sampleCount,
+        uint8_t *outPacket,
+        uint8_t *outSize) {
+
+    const uint8_t channelCount = codec->config->channelCount;
+    const uint8_t stride = codec->config->sampleStride;
+    const bool keyframe = (codec->packetsToKeyframe == 0u);
+    const uint8_t windowCount = (sampleCount < ECG_CODEC_MAX_SAMPLES) ? (uint8_t) sampleCount : ECG_CODEC_MAX_SAMPLES;
+    const int16_t *sample = NULL;
+    uint16_t sampleBits = 0u;
+    uint16_t bitPosition = 0u;
+    int16_t prev[2u][ECG_CODEC_MAX_CHANNELS];
+    uint8_t predictor[ECG_CODEC_MAX_CHANNELS] = { 0u };
+    uint8_t riceParam[ECG_CODEC_MAX_CHANNELS] = { 0u };
+    uint32_t value[ECG_CODEC_MAX_CHANNELS] = { 0u };
+    uint8_t count = 0u;
+    uint8_t first = 0u;
+    bool full = false;
+    uint8_t i = 0u;
+    uint8_t c = 0u;
+
+    memcpy(&prev[0][0], &codec->history[0][0], sizeof(prev));
+    memset(outPacket, 0, ECG_CODEC_PACKET_SIZE);
+
+    // keyframe sample is sent raw and restarts prediction
+    if((keyframe == true) && (windowCount != 0u)) {
+        for(c = 0u; c < channelCount; c++) {
+            prev[0][c] = samples[c];
+            prev[1][c] = samples[c];
+        }
+        count = 1u;
+        first = 1u;
+    }
+
+    for(c = 0u; c < channelCount; c++) {
+        ECG_CODEC_selectParameters(codec, samples, first, windowCount, prev, c, &predictor[c], &riceParam[c]);
+        ECG_CODEC_writeBits(outPacket, &bitPosition, predictor[c], ECG_CODEC_PREDICTOR_BITS);
+        ECG_CODEC_writeBits(outPacket, &bitPosition, riceParam[c], ECG_CODEC_RICE_PARAM_BITS);
+    }
+
+    for(c = 0u; c < (first * channelCount); c++) {
+        ECG_CODEC_writeBits(outPacket, &bitPosition, (uint16_t) samples[c], ECG_CODEC_RAW_WIDTH);
+    }
+
+    // parameters are fixed for the packet, so first sample that does not fit ends it
+    for(i = count; (i < windowCount) && (full == false); i++) {
+        sample = &samples[i * stride];
+        sampleBits = 0u;
+
+        for(c = 0u; c < channelCount; c++) {
+            value[c] = ECG_CODEC_mapResidual(ECG_CODEC_residual(predictor[c], sample, prev, c));
+            sampleBits += ECG_CODEC_riceBits(value[c], riceParam[c]);
+        }
+
+        if((bitPosition + sampleBits) > ECG_CODEC_PACKET_BITS) {
+            full = true;
+        } else {
+            for(c = 0u; c < channelCount; c++) {
+                ECG_CODEC_writeRice(outPacket, &bitPosition, value[c], riceParam[c], sample[c]);
+                prev[1][c] = prev[0][c];
+                prev[0][c] = sample[c];
+            }
+            count = i + 1u;
+            full = (count == ECG_CODEC_MAX_SAMPLES);
+        }
+    }
+
+    if(full == true) {
+        memcpy(&codec->nextHistory[0][0], &prev[0][0], sizeof(prev));
+        codec->keyframeEncoded = keyframe;
+        *outSize = (uint8_t) ((bitPosition + 7u) >> 3u);
+    } else {
+        count = 0u;
+    }
+
+    return count;
+}
+
+/***********************************************************************************************//**
+ * @brief Function returns if the last encoded packet is keyframe.
+ ***************************************************************************************************
+ * @param [in]  *codec       - pointer to codec instance.
+ ***************************************************************************************************
+ * @return true if packet starts with raw sample.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+bool ECG_CODEC_isKeyframe(const ECG_CODEC_instance_S *codec) {
+
+    return codec->keyframeEncoded;
+}
+
+/***********************************************************************************************//**
+ * @brief Advances codec state past the last encoded packet, called once packet is sent.
+ * @details Has to be called for dropped packets as well, receiver detects the gap from packet
+ *          sequence number and waits for next keyframe.
+ ***************************************************************************************************
+ * @param [in]  *codec       - pointer to codec instance.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void ECG_CODEC_commit(ECG_CODEC_instance_S *codec) {
+
+    memcpy(&codec->history[0][0], &codec->nextHistory[0][0], sizeof(codec->history));
+
+    if(codec->keyframeEncoded == true) {
+        codec->packetsToKeyframe = codec->config->keyframeInterval - 1u;
+    } else {
+        codec->packetsToKeyframe--;
+    }
+}
+
+/***************************************************************************************************
+ *                         PRIVATE FUNCTION DEFINITIONS
+ **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Function selects predictor and Rice parameter of channel for packet.
+ * @details Predictor with the smallest sum of mapped residuals is selected, Rice parameter is
+ *          rounded down log2 of their mean, which is within a fraction of a bit per value of the
+ *          optimal Rice code length.
+ ***************************************************************************************************
+ * @param [in]  *codec        - pointer to codec instance.
+ * @param [in]  *samples      - samples available for the packet.
+ * @param [in]  first         - index of first predicted sample.
+ * @param [in]  count         - number of samples available for the packet.
+ * @param [in]  history       - last two samples before first predicted sample, newest first.
+ * @param [in]  channel       - channel index.
+ * @param [out] *outPredictor - selected predictor (ECG_CODEC_predictor_E).
+ * @param [out] *outRiceParam - selected Rice parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void ECG_CODEC_selectParameters(const ECG_CODEC_instance_S *codec,
+        const int16_t *samples,
+        uint8_t first,
+        uint8_t count,
+        int16_t history[2u][ECG_CODEC_MAX_CHANNELS],
+        uint8_t channel,
+        uint8_t *outPredictor,
+        uint8_t *outRiceParam) {
+
+    // cross-channel predictors need channel 1 of the same sample
+    const uint8_t predictorCount = (channel == 0u) ? ECG_CODEC_predictor_CROSS_FIRST : ECG_CODEC_predictor_COUNT;
+    const int16_t *sample = NULL;
+    int16_t prev[2u][ECG_CODEC_MAX_CHANNELS];
+    uint32_t sum = 0u;
+    uint32_t bestSum = 0u;
+    uint32_t mean = 0u;
+    uint8_t riceParam = 0u;
+    uint8_t predictor = 0u;
+    uint8_t i = 0u;
+    uint8_t c = 0u;
+
+    *outPredictor = ECG_CODEC_predictor_FIRST_ORDER;
+
+    for(predictor = 0u; predictor < predictorCount; predictor++) {
+        memcpy(&prev[0][0], &history[0][0], sizeof(prev));
+        sum = 0u;
+
+        for(i = first; i < count; i++) {
+            sample = &samples[i * codec->config->sampleStride];
+            sum += ECG_CODEC_mapResidual(ECG_CODEC_residual(predictor, sample, prev, channel));
+
+            for(c = 0u; c < codec->config->channelCount; c++) {
+                prev[1][c] = prev[0][c];
+                prev[0][c] = sample[c];
+            }
+        }
+
+        if((predictor == 0u) || (sum < bestSum)) {
+            bestSum = sum;
+            *outPredictor = predictor;
+        }
+    }
+
+    if(count > first) {
+        mean = bestSum / (count - first);
+        while(((mean >> (riceParam + 1u)) != 0u) && (riceParam < ECG_CODEC_MAX_RICE_PARAM)) {
+            riceParam++;
+        }
+    }
+
+    *outRiceParam = riceParam;
+}
+
+/***********************************************************************************************//**
+ * @brief Function returns prediction residual of sample channel value.
+ ***************************************************************************************************
+ * @param [in]  predictor    - predictor (ECG_CODEC_predictor_E).
+ * @param [in]  *sample      - sample, channel values next to each other.
+ * @param [in]  prev         - last two samples, newest first.
+ * @param [in]  channel      - channel index.
+ ***************************************************************************************************
+ * @return Residual.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static int32_t ECG_CODEC_residual(uint8_t predictor,
+        const int16_t *sample,
+        int16_t prev[2u][ECG_CODEC_MAX_CHANNELS],
+        uint8_t channel) {
+
+    int32_t prediction = prev[0][channel];
+
+    switch(predictor) {
+        case ECG_CODEC_predictor_SECOND_ORDER:
+            prediction = (2 * (int32_t) prev[0][channel]) - prev[1][channel];
+            break;
+        case ECG_CODEC_predictor_CROSS_FIRST:
+            prediction += (int32_t) sample[0] - prev[0][0];
+            break;
+        case ECG_CODEC_predictor_CROSS_SECOND:
+            prediction = (2 * (int32_t) prev[0][channel]) - prev[1][channel] +
+                    (int32_t) sample[0] - ((2 * (int32_t) prev[0][0]) - prev[1][0]);
+            break;
+        default:
+            break;
+    }
+
+    return (int32_t) sample[channel] - prediction;
+}
+
+/***********************************************************************************************//**
+ * @brief Function maps signed residual to unsigned value, 0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+ ***************************************************************************************************
+ * @param [in]  residual     - prediction residual.
+ ***************************************************************************************************
+ * @return Mapped residual.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static uint32_t ECG_CODEC_mapResidual(int32_t residual) {
+
+    return (residual < 0) ? (((uint32_t) -residual * 2u) - 1u) : ((uint32_t) residual * 2u);
+}
+
+/***********************************************************************************************//**
+ * @brief Function returns number of bits of Rice coded value.
+ ***************************************************************************************************
+ * @param [in]  value        - mapped residual.
+ * @param [in]  riceParam    - Rice parameter.
+ ***************************************************************************************************
+ * @return Number of bits, escaped values take ECG_CODEC_ESCAPE_LENGTH and raw sample bits.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+__INLINE static uint8_t ECG_CODEC_riceBits(uint32_t value, uint8_t riceParam) {
+
+    const uint32_t quotient = value >> riceParam;
+
+    return (quotient < ECG_CODEC_ESCAPE_LENGTH) ? (uint8_t) (quotient + 1u + riceParam) :
+            (ECG_CODEC_ESCAPE_LENGTH + ECG_CODEC_RAW_WIDTH);
+}
+
+/***********************************************************************************************//**
+ * @brief Function appends Rice coded value to packet, or raw sample if value is escaped.
+ ***************************************************************************************************
+ * @param [out] *packet       - packet, cleared before first write.
+ * @param [in]  *bitPosition  - position of next bit in packet, advanced past written value.
+ * @param [in]  value         - mapped residual.
+ * @param [in]  riceParam     - Rice parameter.
+ * @param [in]  sample        - sample channel value, written if value is escaped.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void ECG_CODEC_writeRice(uint8_t *packet, uint16_t *bitPosition, uint32_t value, uint8_t riceParam, int16_t sample) {
+
+    const uint32_t quotient = value >> riceParam;
+
+    if(quotient < ECG_CODEC_ESCAPE_LENGTH) {
+        ECG_CODEC_writeBits(packet, bitPosition, ((1u << quotient) - 1u) << 1u, (uint8_t) (quotient + 1u));
+        ECG_CODEC_writeBits(packet, bitPosition, value, riceParam);
+    } else {
+        ECG_CODEC_writeBits(packet, bitPosition, (1u << ECG_CODEC_ESCAPE_LENGTH) - 1u, ECG_CODEC_ESCAPE_LENGTH);
+        ECG_CODEC_writeBits(packet, bitPosition, (uint16_t) sample, ECG_CODEC_RAW_WIDTH);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function appends lowest width bits of value to packet, MSB first.
+ ***************************************************************************************************
+ * @param [out] *packet       - packet, cleared before first write.
+ * @param [in]  *bitPosition  - position of next bit in packet, advanced by width.
+ * @param [in]  value         - value to write.
+ * @param [in]  width         - number of bits to write.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void ECG_CODEC_writeBits(uint8_t *packet, uint16_t *bitPosition, uint32_t value, uint8_t width) {
+
+    uint16_t position = *bitPosition;
+    uint8_t i = 0u;
+
+    for(i = width; i > 0u; i--) {
+        if(((value >> (i - 1u)) & 0x01u) != 0u) {
+            packet[position >> 3u] |= (uint8_t) (0x80u >> (position & 0x07u));
+        }
+        position++;
+    }
+
+    *bitPosition = position;
+}
+
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
@@ -0,0 +1,101 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    ecg_codec.h
+ * @author  mario.kodba
+ * @brief   Lossless ADS1192 sample compression for BLE notifications header file.
+ **************************************************************************************************/
+
+#ifndef ECG_CODEC_H_
+#define ECG_CODEC_H_
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+#define ECG_CODEC_MAX_CHANNELS          (2u)    //!< Max number of channels in each sample
+#define ECG_CODEC_PACKET_SIZE           (32u)   //!< Max size of encoded packet, BLE stream record payload
+#define ECG_CODEC_MAX_SAMPLES           (40u)   //!< Max number of samples (values of all channels) in packet
+
+#define ECG_CODEC_PREDICTOR_BITS        (2u)    //!< Width of channel predictor in packet header
+#define ECG_CODEC_RICE_PARAM_BITS       (4u)    //!< Width of channel Rice parameter in packet header
+#define ECG_CODEC_MAX_RICE_PARAM        (15u)   //!< Max Rice parameter, number of low bits sent as is
+#define ECG_CODEC_ESCAPE_LENGTH         (16u)   //!< Unary quotient length which escapes raw sample
+#define ECG_CODEC_RAW_WIDTH             (16u)   //!< Width of raw sample in bits
+
+/***************************************************************************************************
+ *                              ENUMERATIONS
+ **************************************************************************************************/
+//! ECG codec error enumeration
+typedef enum ECG_CODEC_err_ENUM {
+    ECG_CODEC_err_NONE          = 0u,   //!< No error
+    ECG_CODEC_err_NULL_PARAM,           //!< NULL parameter error
+    ECG_CODEC_err_INVALID_PARAM         //!< Parameter out of range error
+} ECG_CODEC_err_E;
+
+//! ECG codec channel predictor enumeration, sent in packet header
+typedef enum ECG_CODEC_predictor_ENUM {
+    ECG_CODEC_predictor_FIRST_ORDER     = 0u,   //!< Previous sample of channel
+    ECG_CODEC_predictor_SECOND_ORDER,           //!< Linear extrapolation of previous two samples
+    ECG_CODEC_predictor_CROSS_FIRST,            //!< First order, corrected by first order residual of channel 1
+    ECG_CODEC_predictor_CROSS_SECOND,           //!< Second order, corrected by second order residual of channel 1
+    ECG_CODEC_predictor_COUNT
+} ECG_CODEC_predictor_E;
+
+/***************************************************************************************************
+ *                              DATA STRUCTURES
+ **************************************************************************************************/
+//! ECG codec configuration structure
+typedef struct ECG_CODEC_config_STRUCT {
+    uint8_t channelCount;                       //!< Number of channels in each sample
+    uint8_t sampleStride;                       //!< Distance between samples in input, in 16-bit values
+    uint8_t keyframeInterval;                   //!< Every keyframeInterval-th packet is keyframe
+} ECG_CODEC_config_S;
+
+//! ECG codec instance structure
+typedef struct ECG_CODEC_instance_STRUCT {
+    const ECG_CODEC_config_S *config;           //!< Pointer to codec configuration
+    int16_t history[2u][ECG_CODEC_MAX_CHANNELS]; //!< Last two encoded samples, newest first
+    uint8_t packetsToKeyframe;                  //!< Number of packets before next keyframe
+    //! Last two samples of encoded packet, applied by ECG_CODEC_commit
+    int16_t nextHistory[2u][ECG_CODEC_MAX_CHANNELS];
+    bool keyframeEncoded;                       //!< Is encoded packet keyframe
+} ECG_CODEC_instance_S;
+
+/***************************************************************************************************
+ *                              GLOBAL VARIABLES
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *                         PUBLIC FUNCTION DECLARATIONS
+ **************************************************************************************************/
+void ECG_CODEC_init(ECG_CODEC_instance_S *codec, const ECG_CODEC_config_S *config, ECG_CODEC_err_E *outErr);
+uint8_t ECG_CODEC_encode(ECG_CODEC_instance_S *codec,
+        const int16_t *samples,
+        uint16_t sampleCount,
+        uint8_t *outPacket,
+        uint8_t *outSize);
+bool ECG_CODEC_isKeyframe(const ECG_CODEC_instance_S *codec);
+void ECG_CODEC_commit(ECG_CODEC_instance_S *codec);
+
+#endif // #ifndef ECG_CODEC_H_
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
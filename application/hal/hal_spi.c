@@ -128,6 +128,19 @@ void HAL_SPI_interruptEnable(NRF_SPI_Type *spiStruct) {
     spiStruct->INTENSET = HAL_SPI_INTERRUPT_ENABLE;
 }
 
+/***********************************************************************************************//**
+ * @brief Disables SPI interrupt on READY event.
+ ***************************************************************************************************
+ * @param [in]   *spiStruct     - pointer to SPI registers structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void HAL_SPI_interruptDisable(NRF_SPI_Type *spiStruct) {
+
+    spiStruct->INTENCLR = HAL_SPI_INTERRUPT_ENABLE;
+}
+
 /***********************************************************************************************//**
  * @brief Enables SPI instance.
  ***************************************************************************************************
@@ -48,6 +48,7 @@ void HAL_SPI_setSpiConfiguration(NRF_SPI_Type *spiStruct,
         DRV_SPI_mode_E mode,
         DRV_SPI_bitOrder_E bitOrder);
 void HAL_SPI_interruptEnable(NRF_SPI_Type *spiStruct);
+void HAL_SPI_interruptDisable(NRF_SPI_Type *spiStruct);
 void HAL_SPI_enableSpi(NRF_SPI_Type *spiStruct);
 
 #endif // #ifndef HAL_SPI_H_
@@ -26,14 +26,17 @@
 
 #include "app_timer.h"
 #include "app_fifo.h"
+#include "app_util_platform.h"
+#include "nrf_pwr_mgmt.h"
 #include "ringbuffer.h"
 #include "nrf_drv_gpiote.h"
+#include "nrf_drv_ppi.h"
 #include "nrf_drv_twi.h"
 #include "nrf_delay.h"
-#include "twi_master.h"
 #include "drv_timer.h"
 #include "drv_spi.h"
 #include "nrf51_muha.h"
+#include "pipeline.h"
 #include "ble_muha.h"
 #include "ble_ecgs.h"
 #include "ble_bas.h"
@@ -49,6 +52,9 @@
 #include "cfg_hal_watchdog.h"
 #include "cfg_bsp_ecg_ADS1192.h"
 #include "cfg_bsp_mpu9150.h"
+#include "cfg_ahrs.h"
+#include "cfg_decimator.h"
+#include "cfg_ecg_codec.h"
 #include "SEGGER_RTT.h"
 
 /***************************************************************************************************
@@ -57,9 +63,166 @@
 #define USE_HFCLK       true
 
 #define APP_TIMER_PRESCALER            0                                           /**< Value of the RTC1 PRESCALER register. */
-#define APP_TIMER_OP_QUEUE_SIZE        4                                           /**< Size of timer operation queues. */
+#define APP_TIMER_OP_QUEUE_SIZE        8                                           /**< Size of timer operation queues. */
 #define LED_HEARTBEAT_INTERVAL         APP_TIMER_TICKS(500, APP_TIMER_PRESCALER)   //!< Timer interrupt that toggles LED every 500 ms
+#define CPU_DUTY_CYCLE_WINDOW          APP_TIMER_TICKS(1000, APP_TIMER_PRESCALER)  //!< CPU duty cycle is calculated over 1 s window
+#define MPU_QUIET_TIMEOUT              APP_TIMER_TICKS(NRF51_MUHA_MPU9150_QUIET_TIMEOUT_MS, APP_TIMER_PRESCALER) //!< MPU-9150 low power mode entry timeout
+#define ECG_DRDY_CAPTURE_CHANNEL       DRV_TIMER_cc_CHANNEL0                       //!< TIMER1 channel capturing DRDY timestamp through PPI
+#define ECG_DRDY_CAPTURE_TASK          DRV_TIMER_task_CAPTURE0                     //!< TIMER1 task capturing DRDY timestamp through PPI
+#define MPU_READ_CAPTURE_CHANNEL       DRV_TIMER_cc_CHANNEL1                       //!< TIMER1 channel capturing MPU-9150 read done timestamp
 APP_TIMER_DEF(m_led_timer_id);
+APP_TIMER_DEF(m_ecg_init_timer_id);
+APP_TIMER_DEF(m_mpu_init_timer_id);
+#if (BSP_MPU9150_FIFO_MODE == true)
+APP_TIMER_DEF(m_mpu_fifo_timer_id);
+#endif
+
+//! ADS1192 samples FIFO type (ecg_fifo_t and ecg_fifo_* functions)
+RING_BUFFER_TYPED_DEFINE(ecg_fifo, NRF51_MUHA_ecgSample_S, NRF51_MUHA_ADS1192_FIFO_SIZE)
+//! ADS1192 raw frames FIFO type (ecg_frame_fifo_t and ecg_frame_fifo_* functions)
+RING_BUFFER_TYPED_DEFINE(ecg_frame_fifo, NRF51_MUHA_ecgFrame_S, NRF51_MUHA_ADS1192_FRAME_FIFO_SIZE)
+//! MPU-9150 frames FIFO type (mpu_fifo_t and mpu_fifo_* functions)
+RING_BUFFER_TYPED_DEFINE(mpu_fifo, NRF51_MUHA_mpuSample_S, NRF51_MUHA_MPU9150_FIFO_SIZE)
+
+/***************************************************************************************************
+ *                              GLOBAL VARIABLES
+ **************************************************************************************************/
+//! Main handle structure, used by pipeline tasks
+static NRF51_MUHA_handle_S *muhaHandle = NULL;
+//! Ticks spent sleeping in current CPU duty cycle window
+static uint32_t cpuSleepTicks = 0u;
+//! Start of current CPU duty cycle window in application timer ticks
+static uint32_t cpuWindowStart = 0u;
+//! CPU duty cycle in last completed window, in per mille
+static volatile uint16_t cpuDutyCycle = 1000u;
+
+//! Application timer ticks when application was started
+static uint32_t muhaStartTicks = 0u;
+//! Time from application start to first ADS1192 sample in ms, 0 until first sample
+static volatile uint32_t muhaTimeToFirstSample = 0u;
+//! Sensors initialization error, sampling is not started on error
+static ERR_E muhaInitErr = ERR_NONE;
+//! Is sensors sampling started
+static volatile bool muhaSampling = false;
+//! Is next ADS1192 initialization step due
+static volatile bool ecgInitStepPending = false;
+//! Is next MPU-9150 initialization step due
+static volatile bool mpuInitStepPending = false;
+
+//! ADS1192 raw frames FIFO, filled in DRDY interrupt and emptied by ECG acquisition task
+static ecg_frame_fifo_t ecgFrameFifoStruct;
+//! ADS1192 samples FIFO, filled by acquisition and emptied by BLE transmission
+static ecg_fifo_t ecgFifoStruct;
+//! MPU-9150 packets FIFO, filled by acquisition and emptied by BLE transmission
+static mpu_fifo_t mpuFifoStruct;
+//! Decimation filter reducing ADS1192 sample rate to rate sent over BLE
+static DECIMATOR_instance_S ecgDecimator;
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == true)
+//! Orientation filter fed with every MPU-9150 sample
+static AHRS_instance_S muhaAhrs;
+#endif
+
+//! Is MPU-9150 FIFO overflow signaled on interrupt pin
+static volatile bool mpuFifoOverflowPending = false;
+//! Number of MPU-9150 frames discarded on hardware FIFO overflow
+static uint32_t mpuFifoOverflowCount = 0u;
+//! Number of MPU-9150 frames removed from FIFO without being written to BLE sensor data stream
+static uint32_t mpuStreamDroppedCount = 0u;
+//! MPU-9150 raw frames, filled by TWI driver while MPU-9150 acquisition task is not running
+static BSP_MPU9150_rawFrame_S mpuRawFrames[NRF51_MUHA_MPU9150_BURST_FRAMES];
+//! Number of frames read into mpuRawFrames by last finished read
+static volatile uint8_t mpuReadCount = 0u;
+//! TIMER1 value when last read finished, taken as timestamp of the last frame read
+static volatile uint16_t mpuReadTicks = 0u;
+//! Is MPU-9150 read in progress
+static volatile bool mpuReadBusy = false;
+//! Is MPU-9150 read requested by data ready interrupt or FIFO drain timer
+static volatile bool mpuReadPending = false;
+//! MPU-9150 configuration requested over BLE, applied by MPU-9150 acquisition task
+static BLE_ECGS_mpuConfig_S mpuConfigRequest;
+//! Is MPU-9150 configuration change requested
+static volatile bool mpuConfigPending = false;
+//! Is MPU-9150 configuration requested over BLE control point, responded to once it is applied
+static volatile bool mpuConfigAckPending = false;
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+//! Is MPU-9150 in low power mode, interrupt pin then signals motion
+static volatile bool mpuLowPower = false;
+//! Is motion signaled while MPU-9150 is in low power mode
+static volatile bool mpuMotionPending = false;
+//! Application timer ticks when motion was last detected in MPU-9150 frames
+static uint32_t mpuLastMotionTicks = 0u;
+#endif
+
+//! ADS1192 sample rate in samples per second, used for missed DRDY detection
+static uint16_t ecgSampleRate = BSP_ECG_ADS1192_MIN_SPS;
+//! PPI channel connecting DRDY GPIOTE event to TIMER1 capture task
+static nrf_ppi_channel_t ecgDrdyPpiChannel;
+//! TIMER1 frequency in Hz, used for missed DRDY detection
+static uint32_t ecgTimerFrequency = 1u;
+//! TIMER1 value captured on last DRDY
+static uint32_t ecgLastDrdyTicks = 0u;
+//! Is ecgLastDrdyTicks valid
+static bool ecgDrdySeen = false;
+//! Samples lost since last frame stored in ADS1192 raw frames FIFO
+static uint16_t ecgMissedPending = 0u;
+//! Is ADS1192 frame read in progress
+static volatile bool ecgFrameReading = false;
+//! Total number of samples lost because DRDY was not served in time
+static volatile uint32_t ecgMissedCount = 0u;
+//! Number of ADS1192 samples removed from FIFO without being written to BLE sensor data stream
+static uint32_t ecgStreamDroppedCount = 0u;
+//! Lead-off status from the last ADS1192 frame, BSP_ECG_ADS1192_LOFF_x bits
+static volatile uint8_t ecgLeadOff = 0u;
+//! Is lead-off status change waiting to be sent over BLE
+static volatile bool ecgLeadOffPending = false;
+//! TIMER1 value of DRDY of the ADS1192 frame with last lead-off status change
+static volatile uint16_t ecgLeadOffTimestamp = 0u;
+//! Result of ADS1192 reconfiguration, responded to once ADS1192 reading is started again
+static BLE_ECGS_cpResult_E ecgConfigResult = BLE_ECGS_CP_RESULT_SUCCESS;
+//! ADS1192 conversion rate requested over BLE control point
+static BSP_ECG_ADS1192_convRate_E ecgRequestedRate = BSP_ECG_ADS1192_convRate_125_SPS;
+//! ADS1192 PGA gain requested over BLE control point
+static BSP_ECG_ADS1192_pga_E ecgRequestedPga = BSP_ECG_ADS1192_pga_6X;
+//! Is ADS1192 reconfiguration waiting for frame read in progress to finish
+static volatile bool ecgReconfigPending = false;
+//! Is decimator reset requested, done by ADS1192 acquisition task before it takes next frame
+static volatile bool ecgResetPending = false;
+#if (NRF51_MUHA_ADS1192_CODEC_MODE == true)
+//! Is ECG record compressed, selected over BLE control point
+static bool ecgCodecEnabled = true;
+//! Lossless compression of ADS1192 samples sent over BLE
+static ECG_CODEC_instance_S ecgCodec;
+//! ADS1192 samples copied out of ADS1192 FIFO for encoding
+static NRF51_MUHA_ecgSample_S ecgCodecSamples[ECG_CODEC_MAX_SAMPLES];
+//! Encoded ADS1192 BLE packet, kept until it is sent
+static uint8_t ecgCodecPacket[ECG_CODEC_PACKET_SIZE];
+//! Number of ADS1192 FIFO samples in encoded packet, 0 if there is no packet
+static uint8_t ecgCodecPacketSamples = 0u;
+//! Size of encoded packet in bytes
+static uint8_t ecgCodecPacketSize = 0u;
+#endif
+//! ADS1192 samples copied out of ADS1192 FIFO for uncompressed BLE packet
+static NRF51_MUHA_ecgSample_S ecgPacketBuffer[NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT];
+
+//! Control point request received over BLE, processed by control task
+static BLE_ECGS_cpRequest_S controlRequest;
+//! MPU-9150 configuration decoded from control point request
+static BLE_ECGS_mpuConfig_S controlMpuConfig;
+//! Is control point request waiting for control task
+static volatile bool controlPending = false;
+//! Stream record types enabled over BLE control point, one bit per record type
+static volatile uint8_t streamRecordMask = BLE_ECGS_RECORD_ALL_MASK;
+
+//! ADS1192 acquisition task, preempts all other pipeline stages
+static PIPELINE_task_S muhaEcgAcquireTask;
+//! MPU-9150 acquisition task
+static PIPELINE_task_S muhaMpuAcquireTask;
+//! BLE transmission task, posted when new packet is ready or when SoftDevice frees TX buffer
+static PIPELINE_task_S muhaBleTxTask;
+//! Sensors initialization task, runs initialization steps when their wait times elapse
+static PIPELINE_task_S muhaInitTask;
+//! Control task, processes BLE control point requests
+static PIPELINE_task_S muhaControlTask;
 
 /***************************************************************************************************
  *                          PRIVATE FUNCTION DECLARATIONS
@@ -67,17 +230,52 @@ APP_TIMER_DEF(m_led_timer_id);
 static void NRF51_MUHA_initGpio(ERR_E *outErr);
 static void NRF51_MUHA_initClock();
 static void NRF51_MUHA_initDrivers(ERR_E *outErr);
-static void NRF51_MUHA_initBsp(ERR_E *outErr);
+static void NRF51_MUHA_initPpi(NRF51_MUHA_handle_S *muha, ERR_E *outErr);
 static void NRF51_MUHA_mpuDataReadyInterrupt(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action);
 static void NRF51_MUHA_ecgDataReadyInterrupt(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action);
+static void NRF51_MUHA_ecgFrameReadInterrupt(DRV_SPI_event_E *event, void *context);
 static void NRF51_MUHA_ledHeartbeatInterrupt(void *context);
+static void NRF51_MUHA_initStepInterrupt(void *context);
+static void NRF51_MUHA_scheduleInitStep(app_timer_id_t timerId,
+        uint32_t waitMs,
+        volatile bool *stepPending);
+static void NRF51_MUHA_initTask(void *queue);
+static void NRF51_MUHA_startSampling(NRF51_MUHA_handle_S *muha, ERR_E *outErr);
+static void NRF51_MUHA_startEcg(NRF51_MUHA_handle_S *muha, ERR_E *outErr);
+static void NRF51_MUHA_controlTask(void *queue);
+static BLE_ECGS_cpResult_E NRF51_MUHA_reconfigureEcg(uint8_t convRate, uint8_t pga);
+static void NRF51_MUHA_applyEcgConfig(NRF51_MUHA_handle_S *muha);
+static uint8_t NRF51_MUHA_getCapabilities(NRF51_MUHA_handle_S *muha, uint8_t *outData);
+static bool NRF51_MUHA_isStreamEnabled(BLE_ECGS_recordType_E type);
+static void NRF51_MUHA_mpuFifoDrainInterrupt(void *context);
+static uint16_t NRF51_MUHA_countMissedDrdy(uint32_t drdyTicks);
+static void NRF51_MUHA_ecgAcquireTask(void *queue);
+static void NRF51_MUHA_mpuAcquireTask(void *queue);
+static void NRF51_MUHA_mpuReadDone(BSP_MPU9150_err_E err, uint8_t frameCount, void *context);
+static void NRF51_MUHA_applyMpuConfig(NRF51_MUHA_handle_S *muha);
+static void NRF51_MUHA_publishMpuConfig(NRF51_MUHA_handle_S *muha);
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+static void NRF51_MUHA_mpuEnterLowPower(NRF51_MUHA_handle_S *muha);
+static void NRF51_MUHA_mpuExitLowPower(NRF51_MUHA_handle_S *muha);
+static void NRF51_MUHA_mpuLowPowerStep(NRF51_MUHA_handle_S *muha);
+#endif
+#if (BSP_MPU9150_FIFO_MODE == true)
+static uint32_t NRF51_MUHA_getMpuDrainInterval(uint16_t sampleRateHz);
+#endif
+static void NRF51_MUHA_bleTxTask(void *queue);
+static void NRF51_MUHA_sleep(void);
+static bool NRF51_MUHA_ecgPacketReady(void);
+static uint32_t NRF51_MUHA_sendEcgPacket(NRF51_MUHA_handle_S *muha);
+static uint32_t NRF51_MUHA_sendMpuPacket(NRF51_MUHA_handle_S *muha);
+static uint32_t NRF51_MUHA_sendLeadOff(NRF51_MUHA_handle_S *muha);
 
 /***************************************************************************************************
  *                         PUBLIC FUNCTION DEFINITIONS
  **************************************************************************************************/
 
 /***********************************************************************************************//**
- * @brief Initializes GPIOs, drivers, BSP needed for application.
+ * @brief Initializes GPIOs, drivers and BLE needed for application.
+ * @details Sensors are initialized without blocking once application is started.
  ***************************************************************************************************
  * @param [in]   *muha   - pointer to main handle structure.
  * @param [out]  *outErr - error parameter.
@@ -102,6 +300,9 @@ void NRF51_MUHA_init(NRF51_MUHA_handle_S *muha, ERR_E *outErr) {
 
 #endif // #if (USE_HFCLK == true)
 
+    // initialize timer module, MPU-9150 driver uses it for TWI transfer timeouts
+    APP_TIMER_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, false);
+
     if(err == ERR_NONE) {
         // initialize BLE functionalities
         BLE_MUHA_init(&err);
@@ -113,8 +314,8 @@ void NRF51_MUHA_init(NRF51_MUHA_handle_S *muha, ERR_E *outErr) {
     }
 
     if(err == ERR_NONE) {
-        // initialize BSP components
-        NRF51_MUHA_initBsp(&err);
+        // connect hardware events to tasks
+        NRF51_MUHA_initPpi(muha, &err);
     }
 
     if(outErr != NULL) {
@@ -124,6 +325,10 @@ void NRF51_MUHA_init(NRF51_MUHA_handle_S *muha, ERR_E *outErr) {
 
 /***********************************************************************************************//**
  * @brief Function starts main application and should stay here in main loop.
+ * @details Sensors initialization is started here and continued by initialization task, so waits
+ *          for ADS1192 reference and MPU-9150 PLL to settle overlap with each other and with BLE
+ *          advertising. Sampling starts when both sensors are initialized. Returns only if
+ *          pipeline, application timers, power management or TIMER1 could not be started.
  ***************************************************************************************************
  * @param [in]   *muha - pointer to main handle structure.
  * @param [out]  *err  - error parameter.
@@ -137,48 +342,139 @@ void NRF51_MUHA_start(NRF51_MUHA_handle_S *muha, ERR_E *error) {
     uint32_t err_code = NRF_SUCCESS;
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
     BSP_MPU9150_err_E mpuErr = BSP_MPU9150_err_NONE;
-    // 16-bit data from ADS1192 goes here
-    int16_t ecgData[3] = { 0 };
+    PIPELINE_err_E pipelineErr = PIPELINE_err_NONE;
+    DRV_TIMER_err_E timerErr = DRV_TIMER_err_NONE;
+    uint32_t waitMs = 0u;
 
-    // create FIFO structures for both ADS1192 and MPU-9150
-    ring_buffer_t ecgFifoStruct;
-    ring_buffer_t mpuFifoStruct;
+    muhaHandle = muha;
 
-    ring_buffer_init(&ecgFifoStruct);
-    ring_buffer_init(&mpuFifoStruct);
+    // initialize FIFO structures for both ADS1192 and MPU-9150
+    ecg_frame_fifo_init(&ecgFrameFifoStruct);
+    ecg_fifo_init(&ecgFifoStruct);
+    mpu_fifo_init(&mpuFifoStruct);
 
-    // initialize timer module
-    APP_TIMER_INIT(APP_TIMER_PRESCALER, APP_TIMER_OP_QUEUE_SIZE, false);
+    // register pipeline stages, each stage takes data from its input queue
+    PIPELINE_init(&pipelineErr);
+
+    muhaEcgAcquireTask.handler = NRF51_MUHA_ecgAcquireTask;
+    muhaEcgAcquireTask.queue = &ecgFrameFifoStruct;
+    muhaEcgAcquireTask.priority = PIPELINE_priority_HIGH;
+    if(pipelineErr == PIPELINE_err_NONE) {
+        PIPELINE_registerTask(&muhaEcgAcquireTask, &pipelineErr);
+    }
+
+    muhaMpuAcquireTask.handler = NRF51_MUHA_mpuAcquireTask;
+    muhaMpuAcquireTask.queue = &mpuFifoStruct;
+    muhaMpuAcquireTask.priority = PIPELINE_priority_NORMAL;
+    if(pipelineErr == PIPELINE_err_NONE) {
+        PIPELINE_registerTask(&muhaMpuAcquireTask, &pipelineErr);
+    }
+
+    muhaBleTxTask.handler = NRF51_MUHA_bleTxTask;
+    muhaBleTxTask.queue = NULL;
+    muhaBleTxTask.priority = PIPELINE_priority_LOW;
+    if(pipelineErr == PIPELINE_err_NONE) {
+        PIPELINE_registerTask(&muhaBleTxTask, &pipelineErr);
+    }
+
+    muhaInitTask.handler = NRF51_MUHA_initTask;
+    muhaInitTask.queue = NULL;
+    muhaInitTask.priority = PIPELINE_priority_NORMAL;
+    if(pipelineErr == PIPELINE_err_NONE) {
+        PIPELINE_registerTask(&muhaInitTask, &pipelineErr);
+    }
+
+    muhaControlTask.handler = NRF51_MUHA_controlTask;
+    muhaControlTask.queue = NULL;
+    muhaControlTask.priority = PIPELINE_priority_NORMAL;
+    if(pipelineErr == PIPELINE_err_NONE) {
+        PIPELINE_registerTask(&muhaControlTask, &pipelineErr);
+    }
+
+    if(pipelineErr != PIPELINE_err_NONE) {
+        localErr = ERR_PIPELINE_INIT_FAIL;
+    }
 
     // create timer for LED heartbeat
     err_code = app_timer_create(&m_led_timer_id,
             APP_TIMER_MODE_REPEATED,
             NRF51_MUHA_ledHeartbeatInterrupt);
 
-    // template for using TIMER to measure time difference - timer resolution may need to be changed in config files
-//    DRV_TIMER_enableTimer(muha->timer1, &timerErr);
-//    uint32_t startTime = DRV_TIMER_captureTimer(&instanceTimer1, DRV_TIMER_cc_CHANNEL0, &timerErr);
-//
-//    uint32_t endTime = DRV_TIMER_captureTimer(&instanceTimer1, DRV_TIMER_cc_CHANNEL0, &timerErr);
-//
-//    uint32_t timeDiff = DRV_TIMER_getTimeDiff(&instanceTimer1, &startTime, &endTime);
+    // create timers for sensors initialization steps
+    if(err_code == NRF_SUCCESS) {
+        err_code = app_timer_create(&m_ecg_init_timer_id,
+                APP_TIMER_MODE_SINGLE_SHOT,
+                NRF51_MUHA_initStepInterrupt);
+    }
 
-    if(localErr == ERR_NONE) {
-        BSP_ECG_ADS1192_startEcgReading(muha->ads1192, &ecgErr);
+    if(err_code == NRF_SUCCESS) {
+        err_code = app_timer_create(&m_mpu_init_timer_id,
+                APP_TIMER_MODE_SINGLE_SHOT,
+                NRF51_MUHA_initStepInterrupt);
     }
 
-    if(ecgErr != BSP_ECG_ADS1192_err_NONE) {
-        localErr = ERR_ECG_ADS1192_START_FAIL;
+#if (BSP_MPU9150_FIFO_MODE == true)
+    // create timer for reading out MPU-9150 FIFO in bursts
+    if(err_code == NRF_SUCCESS) {
+        err_code = app_timer_create(&m_mpu_fifo_timer_id,
+                APP_TIMER_MODE_REPEATED,
+                NRF51_MUHA_mpuFifoDrainInterrupt);
+    }
+#endif
+
+    if(err_code == NRF_SUCCESS) {
+        // start application timer
+        err_code = app_timer_start(m_led_timer_id, LED_HEARTBEAT_INTERVAL, NULL);
+    }
+
+    if((localErr == ERR_NONE) && (err_code != NRF_SUCCESS)) {
+        localErr = ERR_APP_TIMER_INIT_FAIL;
     }
 
     if(localErr == ERR_NONE) {
-        nrf_drv_gpiote_in_event_enable(MPU_INT, true);
+        // initialize power management, main loop sleeps through it when there is nothing to do
+        err_code = nrf_pwr_mgmt_init(CPU_DUTY_CYCLE_WINDOW);
+
+        if(err_code != NRF_SUCCESS) {
+            localErr = ERR_PWR_MGMT_INIT_FAIL;
+        }
+    }
+
+    if(localErr == ERR_NONE) {
+        // TIMER1 runs all the time, DRDY timestamps are captured to ECG_DRDY_CAPTURE_CHANNEL through PPI
+        DRV_TIMER_enableTimer(muha->timer1, &timerErr);
+        ecgTimerFrequency = DRV_TIMER_getFrequencyHz(muha->timer1);
+
+        if(timerErr != DRV_TIMER_err_NONE) {
+            localErr = ERR_DRV_TIMER_INIT_FAIL;
+        }
     }
 
-    // start application timer
-    app_timer_start(m_led_timer_id, LED_HEARTBEAT_INTERVAL, NULL);
+    // template for using TIMER to measure time difference - CC channel 0 is used for DRDY timestamps
+//    uint32_t startTime = DRV_TIMER_captureTimer(&instanceTimer1, DRV_TIMER_cc_CHANNEL1, &timerErr);
+//
+//    uint32_t endTime = DRV_TIMER_captureTimer(&instanceTimer1, DRV_TIMER_cc_CHANNEL1, &timerErr);
+//
+//    uint32_t timeDiff = DRV_TIMER_getTimeDiff(&instanceTimer1, &startTime, &endTime);
+
+    muhaStartTicks = app_timer_cnt_get();
 
     if(localErr == ERR_NONE) {
+        // sensors are initialized while BLE stack starts advertising, sampling starts when both are ready
+        BSP_ECG_ADS1192_initStart(muha->ads1192, &ecgDeviceConfig, &waitMs, &ecgErr);
+        if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
+            NRF51_MUHA_scheduleInitStep(m_ecg_init_timer_id, waitMs, &ecgInitStepPending);
+        } else {
+            muhaInitErr = ERR_ECG_ADS1192_START_FAIL;
+        }
+
+        BSP_MPU9150_initStart(muha->mpu9150, &mpuDeviceConfig, &waitMs, &mpuErr);
+        if(mpuErr == BSP_MPU9150_err_NONE) {
+            NRF51_MUHA_scheduleInitStep(m_mpu_init_timer_id, waitMs, &mpuInitStepPending);
+        } else {
+            muhaInitErr = ERR_MPU9150_START_FAIL;
+        }
+
         BLE_MUHA_advertisingStart(&localErr);
     }
 
@@ -187,83 +483,135 @@ void NRF51_MUHA_start(NRF51_MUHA_handle_S *muha, ERR_E *error) {
     muhaConnected = true;
 #endif
 
-    // main loop
-    while(true){
-
-        if(muhaConnected == true) {
-            /*
-             * new data ready to be read from ADS1192
-             */
-            if(muha->ads1192->dataReady == true) {
-
-                BSP_ECG_ADS1192_readData(muha->ads1192, 6u, &ecgData[0], &ecgErr);
-
-                if(ring_buffer_is_full(&ecgFifoStruct) == 0u) {
-                    ring_buffer_queue_arr(&ecgFifoStruct, (char *) &ecgData[2], 2u);
-                }
+    cpuWindowStart = app_timer_cnt_get();
 
-                muha->ads1192->buffer[muha->ads1192->sampleIndex] = ecgData[2];
-                muha->ads1192->sampleIndex++;
+    // main loop, runs pipeline tasks posted from interrupts and sleeps until next interrupt
+    while(localErr == ERR_NONE) {
 
-                // with BLE notification, only 20 user data bytes is allowed on nRF51422
-                if(muha->ads1192->sampleIndex == BSP_ECG_ADS1192_CONNECTION_EVENT_SIZE) {
-                    muha->ads1192->bufferFull = true;
-                    muha->ads1192->sampleIndex = 0u;
-                }
+        PIPELINE_run();
 
-                muha->ads1192->dataReady = false;
-            }
+        // everything is handled, sleep until next interrupt
+        if(PIPELINE_isIdle() == true) {
+            NRF51_MUHA_sleep();
+        }
+    }
 
-            // if the ECG buffer is filled, update ECG characteristic data in BLE custom service and push notification if there is TX buffer available
-            if(muha->ads1192->bufferFull == true) {
+    if(error != NULL) {
+        *error = localErr;
+    }
+}
 
-                if(muhaBleTxBufferAvailable == true) {
+/***********************************************************************************************//**
+ * @brief Function returns number of samples/frames dropped because sensor FIFOs were full.
+ * @details ADS1192 count also includes samples lost because DRDY was not served before the device
+ *          overwrote its output register. MPU-9150 count also includes frames discarded on MPU-9150
+ *          hardware FIFO overflow. Both counts include samples/frames that could not be written to
+ *          BLE sensor data stream, e.g. because peer has not enabled stream notifications.
+ ***************************************************************************************************
+ * @param [out]  *outEcgDropped - number of dropped ADS1192 samples.
+ * @param [out]  *outMpuDropped - number of dropped MPU-9150 frames.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void NRF51_MUHA_getDroppedCount(uint32_t *outEcgDropped, uint32_t *outMpuDropped) {
 
-                    ring_buffer_dequeue_arr(&ecgFifoStruct, (char *) &muha->ads1192->buffer[0], NRF51_MUHA_ADS1192_BLE_BYTE_SIZE);
+    if(outEcgDropped != NULL) {
+        *outEcgDropped = ecg_fifo_overflow_count(&ecgFifoStruct) +
+                ecg_frame_fifo_overflow_count(&ecgFrameFifoStruct) +
+                ecgMissedCount +
+                ecgStreamDroppedCount;
+    }
 
-                    err_code = BLE_ECGS_ecgDataUpdate(muha->customService, (uint8_t *) &muha->ads1192->buffer[0]);
+    if(outMpuDropped != NULL) {
+        *outMpuDropped = mpu_fifo_overflow_count(&mpuFifoStruct) +
+                mpuFifoOverflowCount +
+                mpuStreamDroppedCount;
+    }
+}
 
-                    if(err_code == BLE_ERROR_NO_TX_PACKETS) {
-                        muhaBleTxBufferAvailable = false;
-                    }
-                }
+/***********************************************************************************************//**
+ * @brief Function returns CPU duty cycle, measured as time not spent sleeping in main loop.
+ ***************************************************************************************************
+ * @return CPU duty cycle over last 1 s window, in per mille.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint16_t NRF51_MUHA_getCpuDutyCycle(void) {
 
-                muha->ads1192->bufferFull = false;
-            }
+    return cpuDutyCycle;
+}
 
+/***********************************************************************************************//**
+ * @brief Function returns time from application start to first ADS1192 sample.
+ ***************************************************************************************************
+ * @return time to first sample in ms, 0 if no sample was received yet.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+uint32_t NRF51_MUHA_getTimeToFirstSample(void) {
 
-            // new data ready to be read from MPU-9150
-            if(muha->mpu9150->dataReady == true) {
-                // read in new values from MPU
-                BSP_MPU9150_updateValues(muha->mpu9150, &muha->mpu9150->dataBuffer[0], &mpuErr);
+    return muhaTimeToFirstSample;
+}
 
-                if(ring_buffer_is_full(&mpuFifoStruct) == 0u) {
-                    ring_buffer_queue_arr(&mpuFifoStruct, (char *) &muha->mpu9150->dataBuffer[0], NRF51_MUHA_MPU9150_BLE_BYTE_SIZE);
-                }
+/***********************************************************************************************//**
+ * @brief Requests change of MPU-9150 sample rate, DLPF and ranges.
+ * @details Called from BLE event handler. Change is applied by MPU-9150 acquisition task once no
+ *          TWI read is in progress, later request overrides earlier one that was not applied yet.
+ ***************************************************************************************************
+ * @param [in]  *config - pointer to requested MPU-9150 configuration.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void NRF51_MUHA_requestMpuConfig(const BLE_ECGS_mpuConfig_S *config) {
 
-                // update MPU characteristic data in BLE custom service and push notification if there is TX buffer available
-                if(muhaBleTxBufferAvailable == true) {
+    if(config != NULL) {
+        CRITICAL_REGION_ENTER();
+        mpuConfigRequest = *config;
+        mpuConfigPending = true;
+        CRITICAL_REGION_EXIT();
 
-                    ring_buffer_dequeue_arr(&mpuFifoStruct, (char *) &muha->mpu9150->dataBuffer[0], NRF51_MUHA_MPU9150_BLE_BYTE_SIZE);
+        PIPELINE_post(&muhaMpuAcquireTask);
+    }
+}
 
-                    err_code = BLE_ECGS_mpuDataUpdate(muha->customService, (uint8_t *) &muha->mpu9150->dataBuffer[0]);
-                    if(err_code == BLE_ERROR_NO_TX_PACKETS) {
-                        muhaBleTxBufferAvailable = false;
-                    }
-                }
+/***********************************************************************************************//**
+ * @brief Requests processing of BLE control point request.
+ * @details Called from BLE event handler. Request is processed by control task, custom service
+ *          does not accept next request until this one is responded to.
+ ***************************************************************************************************
+ * @param [in]  *request   - pointer to control point request.
+ * @param [in]  *mpuConfig - pointer to MPU-9150 configuration, used by BLE_ECGS_CP_OP_SET_MPU_CONFIG.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void NRF51_MUHA_requestControl(const BLE_ECGS_cpRequest_S *request, const BLE_ECGS_mpuConfig_S *mpuConfig) {
 
-                muha->mpu9150->dataReady = false;
-            }
+    if((request != NULL) && (mpuConfig != NULL)) {
+        CRITICAL_REGION_ENTER();
+        controlRequest = *request;
+        controlMpuConfig = *mpuConfig;
+        controlPending = true;
+        CRITICAL_REGION_EXIT();
 
-            if(muha->mpu9150->twiRxDone == true) {
-                muha->mpu9150->twiRxDone = false;
-            }
-        }
+        PIPELINE_post(&muhaControlTask);
     }
+}
 
-    if(error != NULL) {
-        *error = localErr;
-    }
+/***********************************************************************************************//**
+ * @brief Requests sending of queued ADS1192 and MPU-9150 data over BLE notifications.
+ * @details Called from BLE event handler when SoftDevice frees TX buffers.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void NRF51_MUHA_requestBleTx(void) {
+
+    PIPELINE_post(&muhaBleTxTask);
 }
 
 /***************************************************************************************************
@@ -347,9 +695,8 @@ static void NRF51_MUHA_initDrivers(ERR_E *outErr) {
     // initialize SPI 0 peripheral
     DRV_SPI_init(&instanceSpi0, &configSpi0, NULL, &spiErr);
 
-#if (DEPRECATED_TWI == false)
     uint32_t err_code;
-    // initialize TWI 1 peripheral
+    // initialize TWI 1 peripheral, MPU-9150 driver chains transfers in its event handler
     err_code = nrf_drv_twi_init(&instanceTwi1, &configTwi1, nrf_drv_mpu_twi_event_handler, &mpuDevice);
 
     if(err_code != NRF_SUCCESS) {
@@ -357,9 +704,6 @@ static void NRF51_MUHA_initDrivers(ERR_E *outErr) {
     }
 
     nrf_drv_twi_enable(&instanceTwi1);
-#else
-    twi_master_init();
-#endif
 
     if(outErr != NULL) {
         *outErr = drvInitErr;
@@ -367,93 +711,1506 @@ static void NRF51_MUHA_initDrivers(ERR_E *outErr) {
 }
 
 /***********************************************************************************************//**
- * @brief Function initializes BSP components used by NRF51422 on MUHA board.
+ * @brief Callback of sensor initialization step timer, called when wait time of a step elapses.
  ***************************************************************************************************
- * @param [out] *outErr - error parameter.
+ * @param [in] context      - pointer to step pending flag of sensor.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    18.10.2020.
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_initStepInterrupt(void *context) {
+
+    *((volatile bool *) context) = true;
+    PIPELINE_post(&muhaInitTask);
+}
+
+/***********************************************************************************************//**
+ * @brief Function schedules next sensor initialization step after given wait time.
+ ***************************************************************************************************
+ * @param [in]  timerId      - sensor initialization step timer.
+ * @param [in]  waitMs       - wait time before next step (ms), step is run right away on 0.
+ * @param [in]  *stepPending - pointer to step pending flag of sensor.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_scheduleInitStep(app_timer_id_t timerId,
+        uint32_t waitMs,
+        volatile bool *stepPending) {
+
+    if(waitMs == 0u) {
+        *stepPending = true;
+        PIPELINE_post(&muhaInitTask);
+    } else {
+        (void) app_timer_start(timerId, APP_TIMER_TICKS(waitMs, APP_TIMER_PRESCALER), (void *) stepPending);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Pipeline task that runs due ADS1192 and MPU-9150 initialization steps.
+ * @details Runs from main loop, since MPU-9150 register access waits on TWI transfers. Sensor that
+ *          failed is not initialized further. Sampling is started once both sensors are initialized.
+ *          ADS1192 steps of initialized device apply reconfiguration requested over BLE control
+ *          point, then start reading again and respond to the request. MPU-9150 step of initialized device
+ *          finishes low power mode entry or exit.
+ ***************************************************************************************************
+ * @param [in]  *queue - not used.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void NRF51_MUHA_initBsp(ERR_E *outErr) {
+static void NRF51_MUHA_initTask(void *queue) {
 
     BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
     BSP_MPU9150_err_E mpuErr = BSP_MPU9150_err_NONE;
-    ERR_E err = ERR_NONE;
+    ERR_E startErr = ERR_NONE;
+    uint32_t waitMs = 0u;
+    uint8_t response[2];
 
-    // initialize ADS1192 ECG device
-    BSP_ECG_ADS1192_init(&ecgDevice, &ecgDeviceConfig, &ecgErr);
+    (void) queue;
 
-    if(ecgErr != BSP_ECG_ADS1192_err_NONE) {
-        err = ERR_ECG_ADS1192_START_FAIL;
+    if(ecgInitStepPending == true) {
+        ecgInitStepPending = false;
+
+        if((muhaHandle->ads1192->isInitialized == true) && (ecgReconfigPending == true)) {
+            NRF51_MUHA_applyEcgConfig(muhaHandle);
+        } else if(muhaHandle->ads1192->isInitialized == true) {
+            // offset calibration after reconfiguration is done
+            NRF51_MUHA_startEcg(muhaHandle, &startErr);
+
+            if(startErr != ERR_NONE) {
+                ecgConfigResult = BLE_ECGS_CP_RESULT_FAILED;
+            }
+
+            // settings in use are returned
+            response[0] = (uint8_t) muhaHandle->ads1192->config->samplingRate;
+            response[1] = (uint8_t) muhaHandle->ads1192->config->pgaSetting;
+            (void) BLE_ECGS_controlPointRespond(muhaHandle->customService,
+                    BLE_ECGS_CP_OP_SET_ECG_CONFIG,
+                    ecgConfigResult,
+                    &response[0],
+                    sizeof(response));
+        } else {
+            BSP_ECG_ADS1192_initStep(muhaHandle->ads1192, &waitMs, &ecgErr);
+
+            if(ecgErr != BSP_ECG_ADS1192_err_NONE) {
+                muhaInitErr = ERR_ECG_ADS1192_START_FAIL;
+            } else if(muhaHandle->ads1192->isInitialized == false) {
+                NRF51_MUHA_scheduleInitStep(m_ecg_init_timer_id, waitMs, &ecgInitStepPending);
+            }
+        }
     }
 
-    // initialize MPU-9150 device
-    BSP_MPU9150_init(&mpuDevice, &mpuDeviceConfig, &mpuErr);
+    if(mpuInitStepPending == true) {
+        mpuInitStepPending = false;
 
-    if(mpuErr != BSP_MPU9150_err_NONE) {
-        err = ERR_MPU9150_START_FAIL;
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+        if(muhaHandle->mpu9150->isInitialized == true) {
+            // low power mode settle time elapsed
+            NRF51_MUHA_mpuLowPowerStep(muhaHandle);
+        } else
+#endif
+        {
+            BSP_MPU9150_initStep(muhaHandle->mpu9150, &waitMs, &mpuErr);
+
+            if(mpuErr != BSP_MPU9150_err_NONE) {
+                muhaInitErr = ERR_MPU9150_START_FAIL;
+            } else if(muhaHandle->mpu9150->isInitialized == false) {
+                NRF51_MUHA_scheduleInitStep(m_mpu_init_timer_id, waitMs, &mpuInitStepPending);
+            }
+        }
     }
 
-    if(outErr != NULL) {
-        *outErr = err;
+    if((muhaSampling == false) &&
+            (muhaInitErr == ERR_NONE) &&
+            (muhaHandle->ads1192->isInitialized == true) &&
+            (muhaHandle->mpu9150->isInitialized == true)) {
+        NRF51_MUHA_startSampling(muhaHandle, &muhaInitErr);
     }
 }
 
 /***********************************************************************************************//**
- * @brief Callback for new data ready signal, called depending on sampling period of MPU-9150.
- * @details Sampling period is set on MPU-9150 initialization in BSP_MPU9150_configuration function.
+ * @brief Function starts ADS1192 and MPU-9150 sampling, once both sensors are initialized.
  ***************************************************************************************************
- * @param [in]  pin    - GPIOTE pin number.
- * @param [in]  action - GPIOTE trigger action.
+ * @param [in]   *muha   - pointer to main handle structure.
+ * @param [out]  *outErr - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    06.06.2021.
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void NRF51_MUHA_mpuDataReadyInterrupt(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
+static void NRF51_MUHA_startSampling(NRF51_MUHA_handle_S *muha, ERR_E *outErr) {
 
-    (void) pin;
-    (void) action;
+    ERR_E localErr = ERR_NONE;
+    BSP_MPU9150_err_E mpuErr = BSP_MPU9150_err_NONE;
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == true)
+    AHRS_err_E ahrsErr = AHRS_err_NONE;
+#endif
+
+    NRF51_MUHA_startEcg(muha, &localErr);
+
+#if (BSP_MPU9150_FIFO_MODE == true)
+    if(localErr == ERR_NONE) {
+        // discard frames collected since initialization, so FIFO does not overflow before first drain
+        BSP_MPU9150_resetFifo(muha->mpu9150, &mpuErr);
+        mpuFifoOverflowPending = false;
+    }
+#endif
+    mpuReadBusy = false;
+    mpuReadPending = false;
+
+    if(mpuErr != BSP_MPU9150_err_NONE) {
+        localErr = ERR_MPU9150_START_FAIL;
+    }
+
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == true)
+    if(localErr == ERR_NONE) {
+        AHRS_init(&muhaAhrs, &ahrsConfig, &ahrsErr);
+    }
+
+    if(ahrsErr == AHRS_err_NONE) {
+        // sensor rate may differ from configured one, since it is rounded to sample rate divider
+        AHRS_setSampleRate(&muhaAhrs, BSP_MPU9150_getOutputRate(muha->mpu9150), &ahrsErr);
+    }
+
+    if(ahrsErr != AHRS_err_NONE) {
+        localErr = ERR_AHRS_INIT_FAIL;
+    }
+#endif
+
+    if(localErr == ERR_NONE) {
+        nrf_drv_gpiote_in_event_enable(MPU_INT, true);
+    }
+
+    NRF51_MUHA_publishMpuConfig(muha);
+
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+    mpuLowPower = false;
+    mpuMotionPending = false;
+    mpuLastMotionTicks = app_timer_cnt_get();
+#endif
 
-    mpuDevice.dataReady = true;
+#if (BSP_MPU9150_FIFO_MODE == true)
+    if(localErr == ERR_NONE) {
+        app_timer_start(m_mpu_fifo_timer_id,
+                NRF51_MUHA_getMpuDrainInterval(BSP_MPU9150_getOutputRate(muha->mpu9150)),
+                NULL);
+    }
+#endif
+
+    if(localErr == ERR_NONE) {
+        muhaSampling = true;
+        // configuration requested over BLE during initialization is applied now
+        PIPELINE_post(&muhaMpuAcquireTask);
+    }
+
+    if(outErr != NULL) {
+        *outErr = localErr;
+    }
 }
 
 /***********************************************************************************************//**
- * @brief Callback for new data ready signal, called depending on sampling period of ADS1192.
- * @details Sampling period is set on ADS1192 initialization.
+ * @brief Function starts ADS1192 reading with decimator and codec set up for its sample rate.
+ * @details Called on sampling start and after ADS1192 reconfiguration. Samples already in ADS1192
+ *          FIFO are kept, since decimator output rate does not change. Decimator is reset by ADS1192
+ *          acquisition task, which is posted before reading is started, so it never mixes frames
+ *          of two sample rates. Codec is reset right here, since it is only used from main loop.
  ***************************************************************************************************
- * @param [in]  pin    - GPIOTE pin number.
- * @param [in]  action - GPIOTE trigger action.
+ * @param [in]   *muha   - pointer to main handle structure.
+ * @param [out]  *outErr - error parameter.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    06.06.2021.
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void NRF51_MUHA_ecgDataReadyInterrupt(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
+static void NRF51_MUHA_startEcg(NRF51_MUHA_handle_S *muha, ERR_E *outErr) {
 
-    (void) pin;
-    (void) action;
+    ERR_E localErr = ERR_NONE;
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+#if (NRF51_MUHA_ADS1192_CODEC_MODE == true)
+    ECG_CODEC_err_E codecErr = ECG_CODEC_err_NONE;
+#endif
+
+    // DRDY is disabled, so no frame read is in progress
+    ecgSampleRate = BSP_ECG_ADS1192_getSampleRate(muha->ads1192);
+    ecgDrdySeen = false;
+    ecgFrameReading = false;
+
+    if(DECIMATOR_isRateSupported(&ecgDecimatorConfig, ecgSampleRate) == false) {
+        localErr = ERR_DECIMATOR_INIT_FAIL;
+    }
+
+    if(localErr == ERR_NONE) {
+        // acquisition task starts feeding decimator with the first frame read after this
+        ecgResetPending = true;
+        PIPELINE_post(&muhaEcgAcquireTask);
+    }
+
+#if (NRF51_MUHA_ADS1192_CODEC_MODE == true)
+    if(localErr == ERR_NONE) {
+        // first packet is keyframe
+        ECG_CODEC_init(&ecgCodec, &ecgCodecConfig, &codecErr);
+        ecgCodecPacketSamples = 0u;
+
+        if(codecErr != ECG_CODEC_err_NONE) {
+            localErr = ERR_ECG_CODEC_INIT_FAIL;
+        }
+    }
+#endif
+
+    if(localErr == ERR_NONE) {
+        BSP_ECG_ADS1192_startEcgReading(muha->ads1192, &ecgErr);
+    }
+
+    if(ecgErr != BSP_ECG_ADS1192_err_NONE) {
+        localErr = ERR_ECG_ADS1192_START_FAIL;
+    }
 
-    ecgDevice.dataReady = true;
+    if(outErr != NULL) {
+        *outErr = localErr;
+    }
 }
 
 /***********************************************************************************************//**
- * @brief Timer callback that will toggle LD1 pin (shows if device alive).
+ * @brief Pipeline task that processes BLE control point request and responds to it.
+ * @details Runs from main loop, so stream and codec selection change between BLE transmissions.
+ *          ADS1192 and MPU-9150 configuration requests are responded to once applied, with settings
+ *          in use. Every other request is responded to right here.
  ***************************************************************************************************
- * @param [in] context      - pointer to callback context (if given on initialization).
+ * @param [in]  *queue - not used.
  ***************************************************************************************************
  * @author  mario.kodba
- * @date    10.06.2021.
+ * @date    17.10.2026.
  **************************************************************************************************/
-static void NRF51_MUHA_ledHeartbeatInterrupt(void *context) {
+static void NRF51_MUHA_controlTask(void *queue) {
+
+    BLE_ECGS_cpRequest_S request;
+    BLE_ECGS_cpResult_E result = BLE_ECGS_CP_RESULT_SUCCESS;
+    ble_gap_conn_params_t connParams;
+    ERR_E connErr = ERR_NONE;
+    uint8_t response[BLE_ECGS_CP_CAPABILITIES_SIZE];
+    uint8_t responseSize = 0u;
+    bool isDeferred = false;
+#if (NRF51_MUHA_ADS1192_CODEC_MODE == true)
+    ECG_CODEC_err_E codecErr = ECG_CODEC_err_NONE;
+#endif
 
-    (void) context;
+    (void) queue;
+
+    if(controlPending == true) {
+        CRITICAL_REGION_ENTER();
+        request = controlRequest;
+        controlPending = false;
+        CRITICAL_REGION_EXIT();
+
+        switch(request.opcode) {
+            case BLE_ECGS_CP_OP_START_STREAMS:
+            case BLE_ECGS_CP_OP_STOP_STREAMS:
+                if((request.params[0] & ~BLE_ECGS_RECORD_ALL_MASK) != 0u) {
+                    result = BLE_ECGS_CP_RESULT_INVALID_PARAM;
+                } else if(request.opcode == BLE_ECGS_CP_OP_START_STREAMS) {
+                    streamRecordMask |= request.params[0];
+                } else {
+                    // records already in sensor FIFOs are still sent
+                    streamRecordMask &= (uint8_t) ~request.params[0];
+                }
+                break;
+
+            case BLE_ECGS_CP_OP_SET_ECG_CONFIG:
+                result = NRF51_MUHA_reconfigureEcg(request.params[0], request.params[1]);
+                isDeferred = (result == BLE_ECGS_CP_RESULT_SUCCESS);
+                break;
+
+            case BLE_ECGS_CP_OP_SET_MPU_CONFIG:
+                if((muhaInitErr != ERR_NONE) || (muhaHandle->mpu9150->isInitialized == false)) {
+                    result = BLE_ECGS_CP_RESULT_FAILED;
+                } else {
+                    // flag is set before request, acquisition task responds once it is applied
+                    mpuConfigAckPending = true;
+                    NRF51_MUHA_requestMpuConfig(&controlMpuConfig);
+                    isDeferred = true;
+                }
+                break;
+
+            case BLE_ECGS_CP_OP_SELECT_CODEC:
+#if (NRF51_MUHA_ADS1192_CODEC_MODE == true)
+                if(request.params[0] >= BLE_ECGS_CODEC_COUNT) {
+                    result = BLE_ECGS_CP_RESULT_INVALID_PARAM;
+                } else if((request.params[0] == BLE_ECGS_CODEC_ECG) != ecgCodecEnabled) {
+                    // encoded packet is dropped, its samples are still in ADS1192 FIFO
+                    ecgCodecEnabled = (request.params[0] == BLE_ECGS_CODEC_ECG);
+                    ecgCodecPacketSamples = 0u;
+                    // first compressed packet is keyframe
+                    ECG_CODEC_init(&ecgCodec, &ecgCodecConfig, &codecErr);
+
+                    if(codecErr != ECG_CODEC_err_NONE) {
+                        ecgCodecEnabled = false;
+                        result = BLE_ECGS_CP_RESULT_FAILED;
+                    }
+                }
+#else
+                if(request.params[0] >= BLE_ECGS_CODEC_COUNT) {
+                    result = BLE_ECGS_CP_RESULT_INVALID_PARAM;
+                } else if(request.params[0] != BLE_ECGS_CODEC_RAW) {
+                    // ECG codec is not compiled in
+                    result = BLE_ECGS_CP_RESULT_NOT_SUPPORTED;
+                }
+#endif
+                break;
 
-    if(muhaConnected) {
-        // toggles LED 1
-        nrf_gpio_pin_toggle(LD1);
-    } else {
-        // keep ON
-        nrf_gpio_pin_clear(LD1);
-    }
+            case BLE_ECGS_CP_OP_SET_CONN_PARAMS:
+                connParams.min_conn_interval = uint16_decode(&request.params[0]);
+                connParams.max_conn_interval = uint16_decode(&request.params[2]);
+                connParams.slave_latency = uint16_decode(&request.params[4]);
+                connParams.conn_sup_timeout = uint16_decode(&request.params[6]);
+
+                BLE_MUHA_connParamsUpdate(&connParams, &connErr);
+
+                if(connErr == ERR_BLE_CONN_PARAMS_INVALID) {
+                    result = BLE_ECGS_CP_RESULT_INVALID_PARAM;
+                } else if(connErr != ERR_NONE) {
+                    result = BLE_ECGS_CP_RESULT_FAILED;
+                }
+                break;
+
+            case BLE_ECGS_CP_OP_GET_CAPABILITIES:
+                responseSize = NRF51_MUHA_getCapabilities(muhaHandle, &response[0]);
+                break;
+
+            default:
+                result = BLE_ECGS_CP_RESULT_NOT_SUPPORTED;
+                break;
+        }
+
+        if(isDeferred == false) {
+            (void) BLE_ECGS_controlPointRespond(muhaHandle->customService,
+                    request.opcode,
+                    result,
+                    &response[0],
+                    responseSize);
+        }
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function starts ADS1192 reconfiguration requested over BLE control point.
+ * @details Conversion rate has to be one decimator divides down to its output rate, so ECG record
+ *          rate does not change. No new frame read is started, reconfiguration is applied from
+ *          initialization task once frame read in progress finishes. Reading is started again
+ *          after offset calibration, which responds to the request. Reading is started again even
+ *          if reconfiguration failed.
+ ***************************************************************************************************
+ * @param [in]  convRate - requested conversion rate (BSP_ECG_ADS1192_convRate_E).
+ * @param [in]  pga      - requested PGA gain (BSP_ECG_ADS1192_pga_E).
+ * @return BLE_ECGS_CP_RESULT_SUCCESS if ADS1192 reconfiguration is pending, request is rejected
+ *         otherwise.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static BLE_ECGS_cpResult_E NRF51_MUHA_reconfigureEcg(uint8_t convRate, uint8_t pga) {
+
+    BLE_ECGS_cpResult_E result = BLE_ECGS_CP_RESULT_SUCCESS;
+
+    if((convRate > BSP_ECG_ADS1192_convRate_8000_SPS) ||
+            (pga > BSP_ECG_ADS1192_pga_12X) ||
+            (DECIMATOR_isRateSupported(&ecgDecimatorConfig,
+                    (uint16_t) (BSP_ECG_ADS1192_MIN_SPS << convRate)) == false)) {
+        result = BLE_ECGS_CP_RESULT_INVALID_PARAM;
+    } else if(muhaSampling == false) {
+        // ADS1192 is still being initialized
+        result = BLE_ECGS_CP_RESULT_FAILED;
+    } else {
+        ecgRequestedRate = (BSP_ECG_ADS1192_convRate_E) convRate;
+        ecgRequestedPga = (BSP_ECG_ADS1192_pga_E) pga;
+
+        // no new frame read is started, the one in progress finishes in SPI interrupt
+        nrf_drv_gpiote_in_event_disable(ECG_DRDY);
+        ecgReconfigPending = true;
+
+        // otherwise frame read done callback schedules the step
+        if(ecgFrameReading == false) {
+            NRF51_MUHA_scheduleInitStep(m_ecg_init_timer_id, 0u, &ecgInitStepPending);
+        }
+    }
+
+    return result;
+}
+
+/***********************************************************************************************//**
+ * @brief Function applies pending ADS1192 reconfiguration, once no frame read is in progress.
+ * @details Reading is started again from initialization task, once offset calibration is done.
+ ***************************************************************************************************
+ * @param [in]  *muha - pointer to main handle structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_applyEcgConfig(NRF51_MUHA_handle_S *muha) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    uint32_t waitMs = 0u;
+
+    // step is scheduled again by frame read done callback
+    if(ecgFrameReading == false) {
+        ecgReconfigPending = false;
+
+        BSP_ECG_ADS1192_stopEcgReading(muha->ads1192, &ecgErr);
+
+        if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
+            BSP_ECG_ADS1192_reconfigure(muha->ads1192,
+                    ecgRequestedRate,
+                    ecgRequestedPga,
+                    &waitMs,
+                    &ecgErr);
+        }
+
+        ecgConfigResult = (ecgErr == BSP_ECG_ADS1192_err_NONE) ?
+                BLE_ECGS_CP_RESULT_SUCCESS : BLE_ECGS_CP_RESULT_FAILED;
+        NRF51_MUHA_scheduleInitStep(m_ecg_init_timer_id, waitMs, &ecgInitStepPending);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function fills capabilities response, see BLE_ECGS_CP_OP_GET_CAPABILITIES for layout.
+ ***************************************************************************************************
+ * @param [in]  *muha    - pointer to main handle structure.
+ * @param [out] *outData - pointer to BLE_ECGS_CP_CAPABILITIES_SIZE bytes of response data.
+ * @return size of response data.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint8_t NRF51_MUHA_getCapabilities(NRF51_MUHA_handle_S *muha, uint8_t *outData) {
+
+    uint8_t rateMask = 0u;
+
+    for(uint8_t rate = BSP_ECG_ADS1192_convRate_125_SPS; rate <= BSP_ECG_ADS1192_convRate_8000_SPS; rate++) {
+        if(DECIMATOR_isRateSupported(&ecgDecimatorConfig, (uint16_t) (BSP_ECG_ADS1192_MIN_SPS << rate)) == true) {
+            rateMask |= (uint8_t) (1u << rate);
+        }
+    }
+
+    outData[0] = BLE_ECGS_CP_VERSION;
+    outData[1] = BLE_ECGS_RECORD_ALL_MASK;
+    outData[2] = streamRecordMask;
+    outData[3] = NRF51_MUHA_ADS1192_CHANNEL_COUNT;
+    outData[4] = rateMask;
+    outData[5] = (uint8_t) muha->ads1192->config->samplingRate;
+    outData[6] = (uint8_t) muha->ads1192->config->pgaSetting;
+    (void) uint16_encode(ecgDecimatorConfig.outputRateHz, &outData[7]);
+#if (NRF51_MUHA_ADS1192_CODEC_MODE == true)
+    outData[9] = (uint8_t) ((1u << BLE_ECGS_CODEC_RAW) | (1u << BLE_ECGS_CODEC_ECG));
+    outData[10] = (ecgCodecEnabled == true) ? BLE_ECGS_CODEC_ECG : BLE_ECGS_CODEC_RAW;
+#else
+    outData[9] = (uint8_t) (1u << BLE_ECGS_CODEC_RAW);
+    outData[10] = BLE_ECGS_CODEC_RAW;
+#endif
+
+    return BLE_ECGS_CP_CAPABILITIES_SIZE;
+}
+
+/***********************************************************************************************//**
+ * @brief Function checks if stream record type is enabled over BLE control point.
+ ***************************************************************************************************
+ * @param [in]  type - stream record type.
+ * @return true if records of given type are sent.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static bool NRF51_MUHA_isStreamEnabled(BLE_ECGS_recordType_E type) {
+
+    return ((streamRecordMask & (1u << type)) != 0u);
+}
+
+/***********************************************************************************************//**
+ * @brief Function connects ADS1192 DRDY GPIOTE event to TIMER1 capture task through PPI.
+ * @details Every ADS1192 sample gets a timestamp captured by hardware, without interrupt latency.
+ *          SPI on nRF51 has no START task (transfer starts by writing TXD), so frame read is
+ *          still started from DRDY interrupt.
+ ***************************************************************************************************
+ * @param [in]  *muha   - pointer to main handle structure.
+ * @param [out] *outErr - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_initPpi(NRF51_MUHA_handle_S *muha, ERR_E *outErr) {
+
+    uint32_t ppiErr = NRF_SUCCESS;
+    DRV_TIMER_err_E timerErr = DRV_TIMER_err_NONE;
+
+    uint32_t captureTask = DRV_TIMER_getTaskAddress(muha->timer1, ECG_DRDY_CAPTURE_TASK, &timerErr);
+
+    ppiErr = nrf_drv_ppi_init();
+
+    if(ppiErr == NRF_SUCCESS) {
+        ppiErr = nrf_drv_ppi_channel_alloc(&ecgDrdyPpiChannel);
+    }
+
+    if(ppiErr == NRF_SUCCESS) {
+        ppiErr = nrf_drv_ppi_channel_assign(ecgDrdyPpiChannel,
+                nrf_drv_gpiote_in_event_addr_get(ECG_DRDY),
+                captureTask);
+    }
+
+    if(ppiErr == NRF_SUCCESS) {
+        ppiErr = nrf_drv_ppi_channel_enable(ecgDrdyPpiChannel);
+    }
+
+    if(outErr != NULL) {
+        if((ppiErr != NRF_SUCCESS) || (timerErr != DRV_TIMER_err_NONE)) {
+            *outErr = ERR_PPI_INIT_FAIL;
+        }
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Callback for new data ready signal, called depending on sampling period of MPU-9150.
+ * @details Sampling period is set on MPU-9150 initialization in BSP_MPU9150_configuration function.
+ *          In FIFO mode the pin only signals FIFO overflow, which is handled by acquisition task.
+ ***************************************************************************************************
+ * @param [in]  pin    - GPIOTE pin number.
+ * @param [in]  action - GPIOTE trigger action.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    06.06.2021.
+ **************************************************************************************************/
+static void NRF51_MUHA_mpuDataReadyInterrupt(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
+
+    (void) pin;
+    (void) action;
+
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+    if(mpuLowPower == true) {
+        // in low power mode only motion is signaled
+        mpuMotionPending = true;
+    } else
+#endif
+    {
+#if (BSP_MPU9150_FIFO_MODE == true)
+        mpuFifoOverflowPending = true;
+#else
+        mpuReadPending = true;
+#endif
+    }
+    PIPELINE_post(&muhaMpuAcquireTask);
+}
+
+/***********************************************************************************************//**
+ * @brief Application timer callback that schedules reading out of MPU-9150 FIFO.
+ ***************************************************************************************************
+ * @param [in]  *context - not used.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_mpuFifoDrainInterrupt(void *context) {
+
+    (void) context;
+
+    mpuReadPending = true;
+    PIPELINE_post(&muhaMpuAcquireTask);
+}
+
+/***********************************************************************************************//**
+ * @brief Callback for new data ready signal, called depending on sampling period of ADS1192.
+ * @details Sampling period is set on ADS1192 initialization. Frame read is started right here, since
+ *          in RDATAC mode ADS1192 overwrites it on next DRDY. Frame is shifted in from SPI interrupt
+ *          directly to ADS1192 raw frames FIFO storage. Sample is lost if FIFO is full or previous
+ *          frame is still being read, lost samples are reported with the next stored frame.
+ ***************************************************************************************************
+ * @param [in]  pin    - GPIOTE pin number.
+ * @param [in]  action - GPIOTE trigger action.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    06.06.2021.
+ **************************************************************************************************/
+static void NRF51_MUHA_ecgDataReadyInterrupt(nrf_drv_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
+
+    BSP_ECG_ADS1192_err_E ecgErr = BSP_ECG_ADS1192_err_NONE;
+    // timestamp is captured by hardware on DRDY edge, it does not depend on interrupt latency
+    uint32_t drdyTicks = DRV_TIMER_readCapture(muhaHandle->timer1, ECG_DRDY_CAPTURE_CHANNEL, NULL);
+    uint16_t missed = NRF51_MUHA_countMissedDrdy(drdyTicks);
+
+    (void) pin;
+    (void) action;
+
+    ecgMissedCount += missed;
+    ecgMissedPending += missed;
+
+    NRF51_MUHA_ecgFrame_S *frame = NULL;
+
+    if(ecgFrameReading == false) {
+        frame = ecg_frame_fifo_reserve(&ecgFrameFifoStruct);
+    } else {
+        ecgMissedCount++;
+    }
+
+    if(frame != NULL) {
+        frame->missedBefore = ecgMissedPending;
+        frame->timestamp = (uint16_t) drdyTicks;
+        ecgFrameReading = true;
+
+        BSP_ECG_ADS1192_readFrameAsync(muhaHandle->ads1192,
+                &frame->raw,
+                NRF51_MUHA_ecgFrameReadInterrupt,
+                NULL,
+                &ecgErr);
+
+        if(ecgErr == BSP_ECG_ADS1192_err_NONE) {
+            ecgMissedPending = 0u;
+        } else {
+            ecgFrameReading = false;
+            ecgMissedCount++;
+            ecgMissedPending++;
+        }
+    } else {
+        // this sample is lost as well
+        ecgMissedPending++;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Callback for ADS1192 frame read done, called from SPI interrupt.
+ ***************************************************************************************************
+ * @param [in]  *event   - SPI driver event.
+ * @param [in]  *context - not used.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_ecgFrameReadInterrupt(DRV_SPI_event_E *event, void *context) {
+
+    (void) event;
+    (void) context;
+
+    ecg_frame_fifo_commit(&ecgFrameFifoStruct);
+    ecgFrameReading = false;
+
+    PIPELINE_post(&muhaEcgAcquireTask);
+
+    if(ecgReconfigPending == true) {
+        // ADS1192 reconfiguration waited for this read to finish
+        NRF51_MUHA_scheduleInitStep(m_ecg_init_timer_id, 0u, &ecgInitStepPending);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Timer callback that will toggle LD1 pin (shows if device alive).
+ ***************************************************************************************************
+ * @param [in] context      - pointer to callback context (if given on initialization).
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    10.06.2021.
+ **************************************************************************************************/
+static void NRF51_MUHA_ledHeartbeatInterrupt(void *context) {
+
+    (void) context;
+
+    if(muhaConnected) {
+        // toggles LED 1
+        nrf_gpio_pin_toggle(LD1);
+    } else {
+        // keep ON
+        nrf_gpio_pin_clear(LD1);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function counts samples missed since previous DRDY interrupt.
+ * @details Gap between DRDY timestamps captured by TIMER1 is rounded to whole sample periods.
+ *          Gaps longer than one TIMER1 period (262 ms) can not be detected.
+ ***************************************************************************************************
+ * @param [in]  drdyTicks - TIMER1 value captured on current DRDY.
+ * @return number of missed samples.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint16_t NRF51_MUHA_countMissedDrdy(uint32_t drdyTicks) {
+
+    uint32_t elapsed = 0u;
+    uint32_t periods = 0u;
+    uint16_t missed = 0u;
+
+    if(ecgDrdySeen == true) {
+        // 16-bit TIMER1 difference times sample rate fits in 32 bits
+        elapsed = DRV_TIMER_getTickDiff(muhaHandle->timer1, ecgLastDrdyTicks, drdyTicks);
+
+        periods = ((elapsed * ecgSampleRate) + (ecgTimerFrequency / 2u)) / ecgTimerFrequency;
+
+        if(periods > 1u) {
+            missed = (uint16_t) (periods - 1u);
+        }
+    }
+
+    ecgLastDrdyTicks = drdyTicks;
+    ecgDrdySeen = true;
+
+    return missed;
+}
+
+/***********************************************************************************************//**
+ * @brief Pipeline task that converts ADS1192 frames read in DRDY interrupt into ADS1192 FIFO.
+ * @details Runs from software interrupt, so it preempts MPU-9150 acquisition and BLE transmission.
+ *          Only channels selected with NRF51_MUHA_ADS1192_CHANNELS are decimated to output rate and
+ *          stored. Decimator runs even while not connected, so its delay lines hold recent samples
+ *          on connection. Samples are not stored while ECG stream is disabled over BLE control point.
+ *          Sample is dropped and counted as overflow if FIFO is full. Lead-off status is taken from status word of
+ *          every frame and its changes are handed to BLE transmission task. On reset requested when
+ *          reading is started, frames read at previous sample rate are dropped and counted as missed,
+ *          and decimator is set up for current sample rate.
+ ***************************************************************************************************
+ * @param [in]  *queue - pointer to ADS1192 raw frames FIFO structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_ecgAcquireTask(void *queue) {
+
+    ecg_frame_fifo_t *frameFifo = (ecg_frame_fifo_t *) queue;
+    NRF51_MUHA_ecgFrame_S frame;
+    BSP_ECG_ADS1192_frame_S ecgData;
+    NRF51_MUHA_ecgSample_S ecgSample;
+    DECIMATOR_err_E decimatorErr = DECIMATOR_err_NONE;
+    uint8_t leadOff = 0u;
+    uint32_t startupTicks = 0u;
+
+    if(ecgResetPending == true) {
+        ecgResetPending = false;
+
+        while(ecg_frame_fifo_dequeue(frameFifo, &frame) != 0u) {
+            ecgMissedCount++;
+        }
+
+        // sample rate is checked before reset is requested
+        DECIMATOR_init(&ecgDecimator, &ecgDecimatorConfig, ecgSampleRate, &decimatorErr);
+        (void) decimatorErr;
+
+        ecgLeadOff = 0u;
+        ecgLeadOffPending = false;
+    }
+
+    if((muhaTimeToFirstSample == 0u) && (ecg_frame_fifo_num_items(frameFifo) != 0u)) {
+        (void) app_timer_cnt_diff_compute(app_timer_cnt_get(), muhaStartTicks, &startupTicks);
+        muhaTimeToFirstSample = (uint32_t) (((uint64_t) startupTicks * 1000u * (APP_TIMER_PRESCALER + 1u)) /
+                APP_TIMER_CLOCK_FREQ);
+    }
+
+    while(ecg_frame_fifo_dequeue(frameFifo, &frame) != 0u) {
+
+        BSP_ECG_ADS1192_convertFrame(&frame.raw, &ecgData);
+
+        // only lead-off status changes are reported
+        leadOff = BSP_ECG_ADS1192_getLeadOff(&ecgData);
+        if(leadOff != ecgLeadOff) {
+            ecgLeadOff = leadOff;
+            ecgLeadOffTimestamp = frame.timestamp;
+            ecgLeadOffPending = true;
+        }
+
+#if (NRF51_MUHA_ADS1192_CHANNELS == NRF51_MUHA_ADS1192_CHANNEL_2)
+        ecgSample.ch[0] = ecgData.ch2;
+#else
+        ecgSample.ch[0] = ecgData.ch1;
+#if (NRF51_MUHA_ADS1192_CHANNEL_COUNT == 2u)
+        ecgSample.ch[1] = ecgData.ch2;
+#endif
+#endif
+        ecgSample.timestamp = frame.timestamp;
+
+        if((DECIMATOR_update(&ecgDecimator, &ecgSample.ch[0], &ecgSample.ch[0]) == true) &&
+                (muhaConnected == true) &&
+                (NRF51_MUHA_isStreamEnabled(BLE_ECGS_RECORD_ECG) == true)) {
+            (void) ecg_fifo_queue(&ecgFifoStruct, &ecgSample);
+        }
+    }
+
+    if((ecgLeadOffPending == true) ||
+            (ecg_fifo_num_items(&ecgFifoStruct) >= NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT)) {
+        PIPELINE_post(&muhaBleTxTask);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Pipeline task that moves MPU-9150 frames read by TWI driver into MPU-9150 FIFO.
+ * @details Reads are only started here and run in TWI interrupt, task is posted again when read
+ *          finishes. In AHRS mode every frame is fed to orientation filter and only its output is
+ *          stored, on every AHRS output divider-th frame. In FIFO mode hardware FIFO is read out in bursts and is reset on overflow, since
+ *          frame boundaries are lost at that point, and all frames it held are counted as dropped.
+ *          While not connected or while MPU stream is disabled over BLE control point, frames are
+ *          not read and are discarded by reset. Frame is dropped and counted as overflow if MPU-9150
+ *          FIFO is full. Configuration requested over BLE is applied here, between reads. MPU-9150
+ *          is put to low power mode when no motion is detected in frames for
+ *          NRF51_MUHA_MPU9150_QUIET_TIMEOUT_MS and returns to sampling on motion interrupt or on
+ *          configuration request.
+ ***************************************************************************************************
+ * @param [in]  *queue - pointer to MPU-9150 FIFO structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_mpuAcquireTask(void *queue) {
+
+    mpu_fifo_t *fifo = (mpu_fifo_t *) queue;
+    BSP_MPU9150_err_E mpuErr = BSP_MPU9150_err_NONE;
+    NRF51_MUHA_mpuSample_S *mpuSample = NULL;
+    uint8_t frameCount = 0u;
+    uint16_t readTicks = 0u;
+    uint16_t periodTicks = 0u;
+    uint16_t frameTicks = 0u;
+    bool isStreamed = ((muhaConnected == true) && (NRF51_MUHA_isStreamEnabled(BLE_ECGS_RECORD_MPU) == true));
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == true)
+    BSP_MPU9150_frame_S mpuFrame;
+    AHRS_output_S ahrsOutput;
+#endif
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+    bool isMotion = false;
+    uint32_t nowTicks = 0u;
+    uint32_t quietTicks = 0u;
+#endif
+
+    // MPU-9150 is still being initialized, configuration stays pending until sampling starts
+    if((mpuReadBusy == true) || (muhaSampling == false)) {
+        return;
+    }
+
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+    if(mpuLowPower == true) {
+        // nothing is sampled until motion or configuration request wakes MPU-9150 up, configuration
+        // is applied on next run, transition in progress is finished first
+        if((muhaHandle->mpu9150->lpState == BSP_MPU9150_lpState_IDLE) &&
+                ((mpuMotionPending == true) || (mpuConfigPending == true))) {
+            mpuMotionPending = false;
+            NRF51_MUHA_mpuExitLowPower(muhaHandle);
+        }
+        return;
+    }
+#endif
+
+    frameCount = mpuReadCount;
+    readTicks = mpuReadTicks;
+    mpuReadCount = 0u;
+    periodTicks = (uint16_t) (ecgTimerFrequency / BSP_MPU9150_getOutputRate(muhaHandle->mpu9150));
+
+    for(uint8_t i = 0u; i < frameCount; i++) {
+        // frames were sampled one period apart, the last one right before read finished
+        frameTicks = (uint16_t) (readTicks - ((frameCount - 1u - i) * periodTicks));
+
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+        if(BSP_MPU9150_detectMotion(muhaHandle->mpu9150, &mpuRawFrames[i]) == true) {
+            isMotion = true;
+        }
+#endif
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == true)
+        BSP_MPU9150_convertFrame(muhaHandle->mpu9150, &mpuRawFrames[i], &mpuFrame.data[0]);
+
+        if(AHRS_update(&muhaAhrs,
+                &mpuFrame.data[BSP_MPU9150_GYRO_DATA_INDEX],
+                &mpuFrame.data[BSP_MPU9150_ACC_DATA_INDEX],
+#if (BSP_MPU9150_MAG_MODE == true)
+                &mpuFrame.data[BSP_MPU9150_MAG_DATA_INDEX],
+#else
+                NULL,
+#endif
+                &ahrsOutput) == true) {
+            // output is counted as overflow if there is no space
+            mpuSample = mpu_fifo_reserve(fifo);
+            if(mpuSample != NULL) {
+                mpuSample->packet = ahrsOutput;
+                mpuSample->timestamp = frameTicks;
+                mpu_fifo_commit(fifo);
+            }
+        }
+#else
+        // convert directly to FIFO storage, frame is counted as overflow if there is no space
+        mpuSample = mpu_fifo_reserve(fifo);
+        if(mpuSample != NULL) {
+            BSP_MPU9150_convertFrame(muhaHandle->mpu9150, &mpuRawFrames[i], &mpuSample->packet.data[0]);
+            mpuSample->timestamp = frameTicks;
+            mpu_fifo_commit(fifo);
+        }
+#endif
+    }
+
+    if(mpu_fifo_num_items(fifo) != 0u) {
+        PIPELINE_post(&muhaBleTxTask);
+    }
+
+    if(mpuConfigPending == true) {
+        // frames read so far are converted with previous ranges, TWI is idle at this point
+        NRF51_MUHA_applyMpuConfig(muhaHandle);
+    }
+
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+    nowTicks = app_timer_cnt_get();
+    if(isMotion == true) {
+        mpuLastMotionTicks = nowTicks;
+    }
+
+    (void) app_timer_cnt_diff_compute(nowTicks, mpuLastMotionTicks, &quietTicks);
+    if(quietTicks >= MPU_QUIET_TIMEOUT) {
+        NRF51_MUHA_mpuEnterLowPower(muhaHandle);
+        return;
+    }
+#endif
+
+#if (BSP_MPU9150_FIFO_MODE == true)
+    if(frameCount == NRF51_MUHA_MPU9150_BURST_FRAMES) {
+        // burst was full, there may be more frames waiting in hardware FIFO
+        mpuReadPending = true;
+    }
+
+    if(mpuFifoOverflowPending == true) {
+        mpuFifoOverflowPending = false;
+
+        if(BSP_MPU9150_checkFifoOverflow(muhaHandle->mpu9150, &mpuErr) == true) {
+            BSP_MPU9150_resetFifo(muhaHandle->mpu9150, &mpuErr);
+            mpuFifoOverflowCount += BSP_MPU9150_FIFO_MAX_FRAMES;
+            mpuReadPending = false;
+            return;
+        }
+    }
+
+    if(isStreamed == false) {
+        BSP_MPU9150_resetFifo(muhaHandle->mpu9150, &mpuErr);
+        mpuReadPending = false;
+        return;
+    }
+#endif // #if (BSP_MPU9150_FIFO_MODE == true)
+
+    if((mpuReadPending == true) && (isStreamed == true)) {
+        mpuReadPending = false;
+        mpuReadBusy = true;
+
+#if (BSP_MPU9150_FIFO_MODE == true)
+        BSP_MPU9150_readFifoFramesAsync(muhaHandle->mpu9150,
+                &mpuRawFrames[0],
+                NRF51_MUHA_MPU9150_BURST_FRAMES,
+                NRF51_MUHA_mpuReadDone,
+                NULL,
+                &mpuErr);
+#else
+        BSP_MPU9150_readFrameAsync(muhaHandle->mpu9150,
+                &mpuRawFrames[0],
+                NRF51_MUHA_mpuReadDone,
+                NULL,
+                &mpuErr);
+#endif // #if (BSP_MPU9150_FIFO_MODE == true)
+
+        if(mpuErr != BSP_MPU9150_err_NONE) {
+            mpuReadBusy = false;
+        }
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function applies MPU-9150 configuration requested over BLE.
+ * @details Each setting is applied separately and is left unchanged if it is out of range.
+ *          Orientation filter and FIFO drain period follow actual sample rate. Applied
+ *          configuration is written back to MPU configuration characteristic, and is responded
+ *          with if it was requested over BLE control point.
+ ***************************************************************************************************
+ * @param [in]  *muha - pointer to main handle structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_applyMpuConfig(NRF51_MUHA_handle_S *muha) {
+
+    BSP_MPU9150_err_E mpuErr = BSP_MPU9150_err_NONE;
+    BLE_ECGS_mpuConfig_S request;
+    uint8_t response[BLE_ECGS_MPU_CONFIG_BYTE_SIZE];
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == true)
+    AHRS_err_E ahrsErr = AHRS_err_NONE;
+#endif
+
+    CRITICAL_REGION_ENTER();
+    request = mpuConfigRequest;
+    mpuConfigPending = false;
+    CRITICAL_REGION_EXIT();
+
+    // DLPF first, it selects gyroscope output rate sample rate is divided from
+    BSP_MPU9150_setDlpf(muha->mpu9150, (BSP_MPU9150_dlpf_E) request.dlpf, &mpuErr);
+    BSP_MPU9150_setRanges(muha->mpu9150,
+            (BSP_MPU9150_gyroFsRange_E) request.gyroRange,
+            (BSP_MPU9150_accFsRange_E) request.accRange,
+            &mpuErr);
+    BSP_MPU9150_setOutputRate(muha->mpu9150, request.sampleRateHz, &mpuErr);
+
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == true)
+    AHRS_setSampleRate(&muhaAhrs, BSP_MPU9150_getOutputRate(muha->mpu9150), &ahrsErr);
+#endif
+
+#if (BSP_MPU9150_FIFO_MODE == true)
+    // FIFO was reset, frames sampled with previous configuration are gone
+    mpuReadPending = false;
+    mpuFifoOverflowPending = false;
+    (void) app_timer_stop(m_mpu_fifo_timer_id);
+    (void) app_timer_start(m_mpu_fifo_timer_id,
+            NRF51_MUHA_getMpuDrainInterval(BSP_MPU9150_getOutputRate(muha->mpu9150)),
+            NULL);
+#endif
+
+    NRF51_MUHA_publishMpuConfig(muha);
+
+    if(mpuConfigAckPending == true) {
+        mpuConfigAckPending = false;
+
+        // same layout as MPU configuration characteristic
+        (void) uint16_encode(BSP_MPU9150_getOutputRate(muha->mpu9150), &response[0]);
+        response[2] = (uint8_t) muha->mpu9150->config->dlpf;
+        response[3] = (uint8_t) muha->mpu9150->config->gyroRange;
+        response[4] = (uint8_t) muha->mpu9150->config->accRange;
+
+        (void) BLE_ECGS_controlPointRespond(muha->customService,
+                BLE_ECGS_CP_OP_SET_MPU_CONFIG,
+                BLE_ECGS_CP_RESULT_SUCCESS,
+                &response[0],
+                BLE_ECGS_MPU_CONFIG_BYTE_SIZE);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function writes current MPU-9150 configuration to MPU configuration characteristic.
+ ***************************************************************************************************
+ * @param [in]  *muha - pointer to main handle structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_publishMpuConfig(NRF51_MUHA_handle_S *muha) {
+
+    BLE_ECGS_mpuConfig_S current;
+
+    current.sampleRateHz = BSP_MPU9150_getOutputRate(muha->mpu9150);
+    current.dlpf = (uint8_t) muha->mpu9150->config->dlpf;
+    current.gyroRange = (uint8_t) muha->mpu9150->config->gyroRange;
+    current.accRange = (uint8_t) muha->mpu9150->config->accRange;
+
+    (void) BLE_ECGS_mpuConfigUpdate(muha->customService, &current);
+}
+
+#if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+/***********************************************************************************************//**
+ * @brief Function starts putting MPU-9150 into low power mode, where only motion is signaled.
+ * @details Flag is set before MPU-9150 enables motion interrupt, so no motion is taken for data
+ *          ready or FIFO overflow. FIFO is not drained while in low power mode. Entry is finished
+ *          from init task, once motion detection high pass filter settles.
+ ***************************************************************************************************
+ * @param [in]  *muha - pointer to main handle structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_mpuEnterLowPower(NRF51_MUHA_handle_S *muha) {
+
+    BSP_MPU9150_err_E mpuErr = BSP_MPU9150_err_NONE;
+    uint32_t waitMs = 0u;
+
+    mpuMotionPending = false;
+    mpuLowPower = true;
+
+    BSP_MPU9150_enterLowPowerMode(muha->mpu9150, &waitMs, &mpuErr);
+
+    if(mpuErr == BSP_MPU9150_err_NONE) {
+#if (BSP_MPU9150_FIFO_MODE == true)
+        (void) app_timer_stop(m_mpu_fifo_timer_id);
+        mpuFifoOverflowPending = false;
+#endif
+        mpuReadPending = false;
+        NRF51_MUHA_scheduleInitStep(m_mpu_init_timer_id, waitMs, &mpuInitStepPending);
+    } else {
+        // keep sampling, entry is retried after next quiet timeout
+        mpuLowPower = false;
+        mpuLastMotionTicks = app_timer_cnt_get();
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function starts returning MPU-9150 from low power mode to sampling, called on motion.
+ * @details Exit is finished from init task, once gyroscope PLL settles. On error MPU-9150 stays in
+ *          low power mode, wake up is retried on next motion.
+ ***************************************************************************************************
+ * @param [in]  *muha - pointer to main handle structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_mpuExitLowPower(NRF51_MUHA_handle_S *muha) {
+
+    BSP_MPU9150_err_E mpuErr = BSP_MPU9150_err_NONE;
+    uint32_t waitMs = 0u;
+
+    BSP_MPU9150_exitLowPowerMode(muha->mpu9150, &waitMs, &mpuErr);
+
+    if(mpuErr == BSP_MPU9150_err_NONE) {
+        NRF51_MUHA_scheduleInitStep(m_mpu_init_timer_id, waitMs, &mpuInitStepPending);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function finishes MPU-9150 low power mode entry or exit, once settle time elapsed.
+ * @details Motion signaled before reference was held is discarded. Acquire task is posted, so
+ *          motion or configuration request that came during transition is handled.
+ ***************************************************************************************************
+ * @param [in]  *muha - pointer to main handle structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_mpuLowPowerStep(NRF51_MUHA_handle_S *muha) {
+
+    BSP_MPU9150_err_E mpuErr = BSP_MPU9150_err_NONE;
+    bool isExiting = false;
+
+    isExiting = (muha->mpu9150->lpState == BSP_MPU9150_lpState_EXITING);
+
+    BSP_MPU9150_lowPowerStep(muha->mpu9150, &mpuErr);
+
+    if(isExiting == true) {
+        if(mpuErr == BSP_MPU9150_err_NONE) {
+            mpuLastMotionTicks = app_timer_cnt_get();
+            mpuLowPower = false;
+#if (BSP_MPU9150_FIFO_MODE == true)
+            (void) app_timer_start(m_mpu_fifo_timer_id,
+                    NRF51_MUHA_getMpuDrainInterval(BSP_MPU9150_getOutputRate(muha->mpu9150)),
+                    NULL);
+#endif
+        }
+    } else {
+        if(mpuErr == BSP_MPU9150_err_NONE) {
+            mpuMotionPending = false;
+        } else {
+            // keep sampling, entry is retried after next quiet timeout
+            mpuLowPower = false;
+            mpuLastMotionTicks = app_timer_cnt_get();
+#if (BSP_MPU9150_FIFO_MODE == true)
+            (void) app_timer_start(m_mpu_fifo_timer_id,
+                    NRF51_MUHA_getMpuDrainInterval(BSP_MPU9150_getOutputRate(muha->mpu9150)),
+                    NULL);
+#endif
+        }
+    }
+
+    PIPELINE_post(&muhaMpuAcquireTask);
+}
+#endif // #if (NRF51_MUHA_MPU9150_LOW_POWER_MODE == true)
+
+#if (BSP_MPU9150_FIFO_MODE == true)
+/***********************************************************************************************//**
+ * @brief Function calculates MPU-9150 FIFO drain period for given sample rate.
+ * @details FIFO is drained when it is about half full, but not less often than every
+ *          NRF51_MUHA_MPU9150_FIFO_DRAIN_MS.
+ ***************************************************************************************************
+ * @param [in]  sampleRateHz - MPU-9150 sample rate in Hz.
+ ***************************************************************************************************
+ * @return Drain period in application timer ticks.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint32_t NRF51_MUHA_getMpuDrainInterval(uint16_t sampleRateHz) {
+
+    uint32_t drainMs = (BSP_MPU9150_FIFO_MAX_FRAMES * 1000u) / (2u * sampleRateHz);
+
+    if(drainMs > NRF51_MUHA_MPU9150_FIFO_DRAIN_MS) {
+        drainMs = NRF51_MUHA_MPU9150_FIFO_DRAIN_MS;
+    }
+
+    return APP_TIMER_TICKS(drainMs, APP_TIMER_PRESCALER);
+}
+#endif
+
+/***********************************************************************************************//**
+ * @brief Called from TWI interrupt when MPU-9150 read finishes, hands frames to acquisition task.
+ ***************************************************************************************************
+ * @param [in]  err        - read result.
+ * @param [in]  frameCount - number of frames read into mpuRawFrames.
+ * @param [in]  *context   - not used.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_mpuReadDone(BSP_MPU9150_err_E err, uint8_t frameCount, void *context) {
+
+    (void) context;
+
+    mpuReadTicks = (uint16_t) DRV_TIMER_captureTimer(muhaHandle->timer1, MPU_READ_CAPTURE_CHANNEL, NULL);
+    mpuReadCount = (err == BSP_MPU9150_err_NONE) ? frameCount : 0u;
+    mpuReadBusy = false;
+    PIPELINE_post(&muhaMpuAcquireTask);
+}
+
+/***********************************************************************************************//**
+ * @brief Pipeline task that sends queued ADS1192 and MPU-9150 data over BLE notifications.
+ * @details Data is written as records to BLE sensor data stream, which packs records of all types
+ *          into 20 byte notifications, so partially filled ECG notification is topped up with MPU
+ *          data. Fills every free SoftDevice TX buffer, so all of them go out in next connection
+ *          event. BLE_EVT_TX_COMPLETE returns credits and posts the task again. ECG and MPU records
+ *          take turns, so neither of them is starved when credits run out. Lead-off status change
+ *          is written first.
+ ***************************************************************************************************
+ * @param [in]  *queue - not used, task takes data from both sensor FIFOs.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_bleTxTask(void *queue) {
+
+    bool written = false;
+
+    (void) queue;
+
+    if(muhaConnected == true) {
+
+        // record that does not fit in stream buffer stays in FIFO until notifications make room
+        do {
+            written = false;
+
+            if(ecgLeadOffPending == true) {
+                // cleared before status is read, change reported in the meantime sets it again
+                ecgLeadOffPending = false;
+
+                if(NRF51_MUHA_sendLeadOff(muhaHandle) == NRF_ERROR_NO_MEM) {
+                    ecgLeadOffPending = true;
+                } else {
+                    written = true;
+                }
+            }
+
+            if((NRF51_MUHA_ecgPacketReady() == true) &&
+                    (NRF51_MUHA_sendEcgPacket(muhaHandle) != NRF_ERROR_NO_MEM)) {
+                written = true;
+            }
+
+            if((mpu_fifo_num_items(&mpuFifoStruct) != 0u) &&
+                    (NRF51_MUHA_sendMpuPacket(muhaHandle) != NRF_ERROR_NO_MEM)) {
+                written = true;
+            }
+
+            (void) BLE_ECGS_streamFlush(muhaHandle->customService);
+        } while((written == true) && (BLE_ECGS_txCreditsGet(muhaHandle->customService) != 0u));
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function puts CPU to sleep until next interrupt and updates CPU duty cycle.
+ * @details Sleep is done through nrf_pwr_mgmt (sd_app_evt_wait), interrupt that happened after the
+ *          last check of posted tasks wakes the CPU up immediately.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static void NRF51_MUHA_sleep(void) {
+
+    uint32_t sleepStart = app_timer_cnt_get();
+    uint32_t sleepTicks = 0u;
+    uint32_t windowTicks = 0u;
+
+    nrf_pwr_mgmt_run();
+
+    uint32_t sleepEnd = app_timer_cnt_get();
+
+    (void) app_timer_cnt_diff_compute(sleepEnd, sleepStart, &sleepTicks);
+    (void) app_timer_cnt_diff_compute(sleepEnd, cpuWindowStart, &windowTicks);
+
+    cpuSleepTicks += sleepTicks;
+
+    if(windowTicks >= CPU_DUTY_CYCLE_WINDOW) {
+        cpuDutyCycle = (uint16_t) (1000u - ((cpuSleepTicks * 1000u) / windowTicks));
+        cpuSleepTicks = 0u;
+        cpuWindowStart = sleepEnd;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Function checks if there is enough ADS1192 samples in FIFO for ECG BLE notification packet.
+ * @details When ECG codec is selected, packet is encoded here and kept until it is sent. Codec
+ *          parameters are selected from all samples given to it, so encoding waits for
+ *          ECG_CODEC_MAX_SAMPLES samples, which always fill a packet.
+ ***************************************************************************************************
+ * @return true if ECG packet can be sent.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static bool NRF51_MUHA_ecgPacketReady(void) {
+
+    bool isReady = false;
+#if (NRF51_MUHA_ADS1192_CODEC_MODE == true)
+    uint16_t sampleCount = ecg_fifo_num_items(&ecgFifoStruct);
+
+    if(ecgCodecEnabled == true) {
+        if((ecgCodecPacketSamples == 0u) && (sampleCount >= ECG_CODEC_MAX_SAMPLES)) {
+            sampleCount = ecg_fifo_peek_arr(&ecgFifoStruct, &ecgCodecSamples[0], ECG_CODEC_MAX_SAMPLES);
+            ecgCodecPacketSamples = ECG_CODEC_encode(&ecgCodec,
+                    &ecgCodecSamples[0].ch[0],
+                    sampleCount,
+                    &ecgCodecPacket[0],
+                    &ecgCodecPacketSize);
+        }
+
+        isReady = (ecgCodecPacketSamples != 0u);
+    } else
+#endif
+    {
+        isReady = (ecg_fifo_num_items(&ecgFifoStruct) >= NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT);
+    }
+
+    return isReady;
+}
+
+/***********************************************************************************************//**
+ * @brief Function writes one ECG record from ADS1192 FIFO to BLE sensor data stream.
+ * @details When ECG codec is selected, packet encoded by NRF51_MUHA_ecgPacketReady is written.
+ *          Otherwise channel values of NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT samples are copied into
+ *          record payload.
+ *          Header carries lead-off and codec flags and timestamp of the first sample in record.
+ *          Samples are removed from FIFO unless stream buffer is full, in which case they are
+ *          retried later. Samples removed without being written are counted as dropped.
+ ***************************************************************************************************
+ * @param [in]  *muha - pointer to main handle structure.
+ * @return error code returned by BLE_ECGS_recordWrite.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint32_t NRF51_MUHA_sendEcgPacket(NRF51_MUHA_handle_S *muha) {
+
+    uint32_t err_code = NRF_SUCCESS;
+    BLE_ECGS_recordHeader_S header;
+    int16_t payload[NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT * NRF51_MUHA_ADS1192_CHANNEL_COUNT];
+
+    header.flags = (ecgLeadOff != 0u) ? BLE_ECGS_FLAG_LEAD_OFF : 0u;
+#if (NRF51_MUHA_ADS1192_CODEC_MODE == true)
+    if(ecgCodecEnabled == true) {
+        header.flags |= BLE_ECGS_FLAG_CODEC;
+        if(ECG_CODEC_isKeyframe(&ecgCodec) == true) {
+            header.flags |= BLE_ECGS_FLAG_KEYFRAME;
+        }
+        header.sampleCount = ecgCodecPacketSamples;
+        header.timestamp = ecgCodecSamples[0].timestamp;
+
+        err_code = BLE_ECGS_recordWrite(muha->customService,
+                BLE_ECGS_RECORD_ECG,
+                &header,
+                &ecgCodecPacket[0],
+                ecgCodecPacketSize);
+
+        if(err_code != NRF_ERROR_NO_MEM) {
+            // codec advances on dropped packet too, receiver waits for next keyframe
+            if(err_code != NRF_SUCCESS) {
+                ecgStreamDroppedCount += ecgCodecPacketSamples;
+            }
+            ecg_fifo_release(&ecgFifoStruct, ecgCodecPacketSamples);
+            ECG_CODEC_commit(&ecgCodec);
+            ecgCodecPacketSamples = 0u;
+        }
+    } else
+#endif
+    {
+        (void) ecg_fifo_peek_arr(&ecgFifoStruct, &ecgPacketBuffer[0], NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT);
+
+        // timestamps stay on device, only channel values are sent
+        for(uint8_t i = 0u; i < NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT; i++) {
+            for(uint8_t c = 0u; c < NRF51_MUHA_ADS1192_CHANNEL_COUNT; c++) {
+                payload[(i * NRF51_MUHA_ADS1192_CHANNEL_COUNT) + c] = ecgPacketBuffer[i].ch[c];
+            }
+        }
+
+        header.sampleCount = NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT;
+        header.timestamp = ecgPacketBuffer[0].timestamp;
+
+        err_code = BLE_ECGS_recordWrite(muha->customService,
+                BLE_ECGS_RECORD_ECG,
+                &header,
+                (const uint8_t *) &payload[0],
+                NRF51_MUHA_ADS1192_BLE_BYTE_SIZE);
+
+        if(err_code != NRF_ERROR_NO_MEM) {
+            if(err_code != NRF_SUCCESS) {
+                ecgStreamDroppedCount += NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT;
+            }
+            ecg_fifo_release(&ecgFifoStruct, NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT);
+        }
+    }
+
+    return err_code;
+}
+
+/***********************************************************************************************//**
+ * @brief Function writes one MPU record from MPU-9150 FIFO to BLE sensor data stream.
+ * @details Each record carries a single sample and its timestamp. Sample is removed from FIFO
+ *          unless stream buffer is full, in which case it is retried later. Sample removed without
+ *          being written is counted as dropped.
+ ***************************************************************************************************
+ * @param [in]  *muha - pointer to main handle structure.
+ * @return error code returned by BLE_ECGS_recordWrite.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint32_t NRF51_MUHA_sendMpuPacket(NRF51_MUHA_handle_S *muha) {
+
+    uint32_t err_code = NRF_SUCCESS;
+    uint16_t spanCount = 0u;
+    const NRF51_MUHA_mpuSample_S *sample = mpu_fifo_peek_contiguous(&mpuFifoStruct, &spanCount);
+    BLE_ECGS_recordHeader_S header;
+
+    header.flags = 0u;
+    header.sampleCount = 1u;
+    header.timestamp = sample->timestamp;
+
+    err_code = BLE_ECGS_recordWrite(muha->customService,
+            BLE_ECGS_RECORD_MPU,
+            &header,
+            (const uint8_t *) &sample->packet,
+            NRF51_MUHA_MPU9150_BLE_BYTE_SIZE);
+
+    if(err_code != NRF_ERROR_NO_MEM) {
+        if(err_code != NRF_SUCCESS) {
+            mpuStreamDroppedCount++;
+        }
+        mpu_fifo_release(&mpuFifoStruct, 1u);
+    }
+
+    return err_code;
+}
+
+/***********************************************************************************************//**
+ * @brief Function reports ADS1192 lead-off status change.
+ * @details Lead-off status characteristic is updated and lead-off record is written to BLE sensor
+ *          data stream, timestamped with DRDY of the frame the change was seen in. Record is not
+ *          written while lead-off stream is disabled over BLE control point.
+ ***************************************************************************************************
+ * @param [in]  *muha - pointer to main handle structure.
+ * @return error code returned by BLE_ECGS_recordWrite.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static uint32_t NRF51_MUHA_sendLeadOff(NRF51_MUHA_handle_S *muha) {
+
+    uint32_t err_code = NRF_SUCCESS;
+    BLE_ECGS_recordHeader_S header;
+    uint8_t leadOff = ecgLeadOff;
+
+    header.flags = (leadOff != 0u) ? BLE_ECGS_FLAG_LEAD_OFF : 0u;
+    header.sampleCount = 1u;
+    header.timestamp = ecgLeadOffTimestamp;
+
+    (void) BLE_ECGS_leadOffUpdate(muha->customService, leadOff);
+
+    if(NRF51_MUHA_isStreamEnabled(BLE_ECGS_RECORD_LEAD_OFF) == true) {
+        err_code = BLE_ECGS_recordWrite(muha->customService,
+                BLE_ECGS_RECORD_LEAD_OFF,
+                &header,
+                &leadOff,
+                BLE_ECGS_LEAD_OFF_BYTE_SIZE);
+    }
+
+    return err_code;
 }
 
 /***************************************************************************************************
@@ -30,15 +30,81 @@
 #include "bsp_mpu9150.h"
 #include "drv_timer.h"
 #include "ble_ecgs.h"
+#include "ahrs.h"
+#include "decimator.h"
+#include "ecg_codec.h"
 
 /***************************************************************************************************
  *                              DEFINES
  **************************************************************************************************/
-//TODO: increase this to 20 when Magnetometer data is included
+//! If set to true MPU9150 samples are fused on device and orientation is sent instead of sensor values
+#define NRF51_MUHA_MPU9150_AHRS_MODE        true
+
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == true) && (BSP_MPU9150_CONVERSION_MODE == BSP_MPU9150_CONVERSION_RAW)
+#error "AHRS needs sensor values converted to physical units"
+#endif
+
+//! If set to true MPU9150 drops to accelerometer only low power mode while still, motion wakes it up
+#define NRF51_MUHA_MPU9150_LOW_POWER_MODE   true
+//! Time without motion after which MPU9150 enters low power mode in ms (below 512 s app timer counter wrap)
+#define NRF51_MUHA_MPU9150_QUIET_TIMEOUT_MS (10000u)
+
 //! Number of bytes to send for MPU9150 in each BLE connection event
-#define NRF51_MUHA_MPU9150_BLE_BYTE_SIZE    (14u)
-//! Number of bytes to send for ADS1192 in each BLE connection event
-#define NRF51_MUHA_ADS1192_BLE_BYTE_SIZE    (BSP_ECG_ADS1192_CONNECTION_EVENT_SIZE * sizeof(int16_t))
+#define NRF51_MUHA_MPU9150_BLE_BYTE_SIZE    (sizeof(NRF51_MUHA_mpuPacket_S))
+
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == false) && \
+        ((BSP_MPU9150_SENSOR_DATA_INT16_SIZE * 2u) > BLE_ECGS_RECORD_MAX_PAYLOAD)
+#error "MPU9150 frame does not fit in BLE stream record"
+#endif
+
+#define NRF51_MUHA_ADS1192_CHANNEL_1        (0x01u) //!< ADS1192 channel 1 selection bit
+#define NRF51_MUHA_ADS1192_CHANNEL_2        (0x02u) //!< ADS1192 channel 2 selection bit
+//! ADS1192 channels sent over BLE, if both are selected channel 1 and channel 2 values are interleaved
+#define NRF51_MUHA_ADS1192_CHANNELS         (NRF51_MUHA_ADS1192_CHANNEL_1 | NRF51_MUHA_ADS1192_CHANNEL_2)
+
+#if (NRF51_MUHA_ADS1192_CHANNELS == (NRF51_MUHA_ADS1192_CHANNEL_1 | NRF51_MUHA_ADS1192_CHANNEL_2))
+#define NRF51_MUHA_ADS1192_CHANNEL_COUNT    (2u)    //!< Number of ADS1192 channels sent over BLE
+#elif (NRF51_MUHA_ADS1192_CHANNELS == NRF51_MUHA_ADS1192_CHANNEL_1) || \
+        (NRF51_MUHA_ADS1192_CHANNELS == NRF51_MUHA_ADS1192_CHANNEL_2)
+#define NRF51_MUHA_ADS1192_CHANNEL_COUNT    (1u)    //!< Number of ADS1192 channels sent over BLE
+#else
+#error "At least one ADS1192 channel has to be selected"
+#endif
+
+//! Number of ADS1192 samples (values of all selected channels) in uncompressed BLE stream record
+#define NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT (BLE_ECGS_RECORD_MAX_PAYLOAD / (NRF51_MUHA_ADS1192_CHANNEL_COUNT * sizeof(int16_t)))
+//! Number of bytes of uncompressed ADS1192 BLE stream record payload
+#define NRF51_MUHA_ADS1192_BLE_BYTE_SIZE    (NRF51_MUHA_ADS1192_BLE_SAMPLE_COUNT * NRF51_MUHA_ADS1192_CHANNEL_COUNT * sizeof(int16_t))
+
+/**
+ * If set to true ADS1192 samples are compressed losslessly (ecg_codec) before they are sent over BLE.
+ * Measured with tools/ecg_codec.py bench, synthetic ECG (synth, 250 SPS) sent in 20 byte notifications:
+ * - 2 channels, 1.5 mV R wave, 1.5 LSB noise: 15.0 samples per notification (3.9 raw).
+ * - 1 channel, same signal: 27.3 samples per notification (7.8 raw).
+ * - 2 channels, 18 mV R wave, 6 LSB noise (-a 3000 -n 6): 9.1 samples per notification.
+ * Agreed deviation: with 2 channels the 25 - 40 samples per notification target is not met. It would
+ * take ~2.5 bits per channel value, while the lossless residual takes ~4 bits, mostly amplifier and
+ * electrode noise. Both leads are kept, select a single channel above where the target is a must.
+ * Figures above are from synthetic signal only. To bench a real ADS1192 recording, run with this
+ * set to false, log stream notifications as hex, convert with ecg_codec.py decode and pass the CSV
+ * to ecg_codec.py bench.
+ */
+#define NRF51_MUHA_ADS1192_CODEC_MODE       true
+
+#if (NRF51_MUHA_ADS1192_CODEC_MODE == true) && (ECG_CODEC_PACKET_SIZE > BLE_ECGS_RECORD_MAX_PAYLOAD)
+#error "ECG codec packet has to fit in BLE stream record payload"
+#endif
+
+//! ADS1192 FIFO size in decimated samples (power of two), covers ~2 s of BLE stall at 250 SPS
+#define NRF51_MUHA_ADS1192_FIFO_SIZE        (512u)
+//! MPU-9150 FIFO size in frames (power of two), holds at least two FIFO drain bursts
+#define NRF51_MUHA_MPU9150_FIFO_SIZE        (32u)
+//! Period of reading out MPU-9150 hardware FIFO in ms (10 frames at 100 Hz sample rate)
+#define NRF51_MUHA_MPU9150_FIFO_DRAIN_MS    (100u)
+//! Max number of frames read from MPU-9150 hardware FIFO in single burst
+#define NRF51_MUHA_MPU9150_BURST_FRAMES     (10u)
+//! ADS1192 raw frames FIFO size (power of two), filled in DRDY interrupt and emptied by ECG acquisition task
+#define NRF51_MUHA_ADS1192_FRAME_FIFO_SIZE  (16u)
 
 /***************************************************************************************************
  *                              DATA STRUCTURES
@@ -60,6 +126,15 @@ typedef enum ERR_ENUM {
     ERR_ECG_ADS1192_START_FAIL,                     //!< ADS1192 device start error.
     ERR_MPU9150_START_FAIL,                         //!< MPU9150 device start error.
     ERR_HAL_WATCHDOG_INIT_FAIL,                     //!< WATCHDOG module initialization error.
+    ERR_APP_TIMER_INIT_FAIL,                        //!< Application timer creation or start error.
+    ERR_PWR_MGMT_INIT_FAIL,                         //!< Power management initialization error.
+    ERR_PIPELINE_INIT_FAIL,                         //!< Pipeline scheduler initialization error.
+    ERR_PPI_INIT_FAIL,                              //!< PPI channels initialization error.
+    ERR_AHRS_INIT_FAIL,                             //!< AHRS orientation filter initialization error.
+    ERR_DECIMATOR_INIT_FAIL,                        //!< ADS1192 decimation filter initialization error.
+    ERR_ECG_CODEC_INIT_FAIL,                        //!< ADS1192 compression codec initialization error.
+    ERR_BLE_CONN_PARAMS_INVALID,                    //!< Requested BLE connection parameters out of range.
+    ERR_BLE_CONN_PARAMS_UPDATE_FAIL,                //!< BLE connection parameters update error.
 
     ERR_COUNT                                       //!< Total number of errors.
 } ERR_E;
@@ -73,11 +148,43 @@ typedef struct NRF51_MUHA_handle_STRUCT {
 
 } NRF51_MUHA_handle_S;
 
+//! MPU9150 BLE packet, either orientation or sensor values
+#if (NRF51_MUHA_MPU9150_AHRS_MODE == true)
+typedef AHRS_output_S NRF51_MUHA_mpuPacket_S;
+#else
+typedef BSP_MPU9150_frame_S NRF51_MUHA_mpuPacket_S;
+#endif
+
+//! MPU9150 BLE packet as stored in MPU9150 FIFO
+typedef struct NRF51_MUHA_mpuSample_STRUCT {
+    NRF51_MUHA_mpuPacket_S packet;                  //!< Packet sent over BLE.
+    uint16_t timestamp;                             //!< TIMER1 value estimated for MPU9150 sample.
+} NRF51_MUHA_mpuSample_S;
+
+//! ADS1192 sample as stored in ADS1192 FIFO, only channel values are sent over BLE
+typedef struct NRF51_MUHA_ecgSample_STRUCT {
+    int16_t ch[NRF51_MUHA_ADS1192_CHANNEL_COUNT];  //!< Values of selected channels, lower channel first.
+    uint16_t timestamp;                             //!< TIMER1 value of DRDY of the last ADS1192 sample decimated into it.
+} NRF51_MUHA_ecgSample_S;
+
+//! ADS1192 frame read in DRDY interrupt
+typedef struct NRF51_MUHA_ecgFrame_STRUCT {
+    BSP_ECG_ADS1192_rawFrame_S raw;                 //!< Frame as clocked out of ADS1192.
+    uint16_t missedBefore;                          //!< Number of samples lost right before this frame.
+    uint16_t timestamp;                             //!< TIMER1 value captured by hardware on DRDY.
+} NRF51_MUHA_ecgFrame_S;
+
 /***************************************************************************************************
  *                         PUBLIC FUNCTION DECLARATIONS
  **************************************************************************************************/
 void NRF51_MUHA_init(NRF51_MUHA_handle_S *muha, ERR_E *outErr);
 void NRF51_MUHA_start(NRF51_MUHA_handle_S *muha, ERR_E *error);
+void NRF51_MUHA_getDroppedCount(uint32_t *outEcgDropped, uint32_t *outMpuDropped);
+uint16_t NRF51_MUHA_getCpuDutyCycle(void);
+uint32_t NRF51_MUHA_getTimeToFirstSample(void);
+void NRF51_MUHA_requestMpuConfig(const BLE_ECGS_mpuConfig_S *config);
+void NRF51_MUHA_requestControl(const BLE_ECGS_cpRequest_S *request, const BLE_ECGS_mpuConfig_S *mpuConfig);
+void NRF51_MUHA_requestBleTx(void);
 
 #endif // #ifndef NRF51_MUHA_H_
 /***************************************************************************************************
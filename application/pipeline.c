@@ -0,0 +1,217 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    pipeline.c
+ * @author  mario.kodba
+ * @brief   Run-to-completion task scheduler for sensor and BLE pipeline stages source file.
+ * @details Each stage registers as a task with a priority and an input queue. Interrupts post tasks,
+ *          posting a task that is already pending has no effect, so task handler should empty its
+ *          input queue. HIGH priority tasks run from SWI3 interrupt and preempt NORMAL and LOW
+ *          priority tasks which run from main loop through PIPELINE_run.
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include <stddef.h>
+
+#include "pipeline.h"
+#include "nrf.h"
+#include "app_util_platform.h"
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+#define PIPELINE_SWI_IRQn           SWI3_IRQn               //!< Software interrupt running HIGH priority tasks
+#define PIPELINE_SWI_IRQ_PRIORITY   APP_IRQ_PRIORITY_LOW    //!< Software interrupt priority
+
+/***************************************************************************************************
+ *                              GLOBAL VARIABLES
+ **************************************************************************************************/
+static PIPELINE_task_S *pipelineTasks[PIPELINE_MAX_TASKS];          //!< Registered tasks, indexed by task ID
+static uint8_t pipelineTaskCount = 0u;                              //!< Number of registered tasks
+static volatile uint32_t pipelinePending[PIPELINE_priority_COUNT];  //!< Pending tasks mask for each priority
+
+/***************************************************************************************************
+ *                          PRIVATE FUNCTION DECLARATIONS
+ **************************************************************************************************/
+static PIPELINE_task_S *PIPELINE_takeTask(PIPELINE_priority_E first, PIPELINE_priority_E last);
+
+/***************************************************************************************************
+ *                         PUBLIC FUNCTION DEFINITIONS
+ **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Initializes pipeline scheduler and software interrupt used for HIGH priority tasks.
+ ***************************************************************************************************
+ * @param [out] *outErr - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void PIPELINE_init(PIPELINE_err_E *outErr) {
+
+    uint8_t i = 0u;
+
+    pipelineTaskCount = 0u;
+
+    for(i = 0u; i < PIPELINE_priority_COUNT; i++) {
+        pipelinePending[i] = 0u;
+    }
+
+    NVIC_SetPriority(PIPELINE_SWI_IRQn, PIPELINE_SWI_IRQ_PRIORITY);
+    NVIC_ClearPendingIRQ(PIPELINE_SWI_IRQn);
+    NVIC_EnableIRQ(PIPELINE_SWI_IRQn);
+
+    if(outErr != NULL) {
+        *outErr = PIPELINE_err_NONE;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Registers pipeline task, must be done before the task is posted for the first time.
+ ***************************************************************************************************
+ * @param [in]  *task   - pointer to task structure, handler and priority must be set.
+ * @param [out] *outErr - error parameter.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void PIPELINE_registerTask(PIPELINE_task_S *task, PIPELINE_err_E *outErr) {
+
+    PIPELINE_err_E err = PIPELINE_err_NONE;
+
+    if((task == NULL) || (task->handler == NULL) || (task->priority >= PIPELINE_priority_COUNT)) {
+        err = PIPELINE_err_NULL_PARAM;
+    }
+
+    if(err == PIPELINE_err_NONE) {
+        if(pipelineTaskCount >= PIPELINE_MAX_TASKS) {
+            err = PIPELINE_err_TABLE_FULL;
+        }
+    }
+
+    if(err == PIPELINE_err_NONE) {
+        task->id = pipelineTaskCount;
+        pipelineTasks[pipelineTaskCount] = task;
+        pipelineTaskCount++;
+    }
+
+    if(outErr != NULL) {
+        *outErr = err;
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Posts pipeline task to be run, safe to call from any interrupt priority.
+ ***************************************************************************************************
+ * @param [in]  *task - pointer to registered task structure.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void PIPELINE_post(PIPELINE_task_S *task) {
+
+    CRITICAL_REGION_ENTER();
+    pipelinePending[task->priority] |= (1uL << task->id);
+    CRITICAL_REGION_EXIT();
+
+    if(task->priority == PIPELINE_priority_HIGH) {
+        NVIC_SetPendingIRQ(PIPELINE_SWI_IRQn);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Runs pending NORMAL and LOW priority tasks, to be called from main loop.
+ * @details Highest priority pending task is picked again after each task completes, so LOW priority
+ *          task never delays NORMAL priority task by more than one task run.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void PIPELINE_run(void) {
+
+    PIPELINE_task_S *task = NULL;
+
+    while((task = PIPELINE_takeTask(PIPELINE_priority_NORMAL, PIPELINE_priority_LOW)) != NULL) {
+        task->handler(task->queue);
+    }
+}
+
+/***********************************************************************************************//**
+ * @brief Checks if there is any NORMAL or LOW priority task pending.
+ ***************************************************************************************************
+ * @return true if main loop can go to sleep, false otherwise.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+bool PIPELINE_isIdle(void) {
+
+    return ((pipelinePending[PIPELINE_priority_NORMAL] | pipelinePending[PIPELINE_priority_LOW]) == 0u);
+}
+
+/***********************************************************************************************//**
+ * @brief Software interrupt handler, runs pending HIGH priority tasks.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+void SWI3_IRQHandler(void) {
+
+    PIPELINE_task_S *task = NULL;
+
+    while((task = PIPELINE_takeTask(PIPELINE_priority_HIGH, PIPELINE_priority_HIGH)) != NULL) {
+        task->handler(task->queue);
+    }
+}
+
+/***************************************************************************************************
+ *                         PRIVATE FUNCTION DEFINITIONS
+ **************************************************************************************************/
+/***********************************************************************************************//**
+ * @brief Takes highest priority pending task within given priority range and clears its pending bit.
+ * @details Among tasks of the same priority, the one registered first is taken first.
+ ***************************************************************************************************
+ * @param [in]  first - highest priority to check.
+ * @param [in]  last  - lowest priority to check.
+ * @return pointer to taken task structure, NULL if no task is pending.
+ ***************************************************************************************************
+ * @author  mario.kodba
+ * @date    17.10.2026.
+ **************************************************************************************************/
+static PIPELINE_task_S *PIPELINE_takeTask(PIPELINE_priority_E first, PIPELINE_priority_E last) {
+
+    PIPELINE_task_S *task = NULL;
+    uint32_t priority = 0u;
+    uint8_t id = 0u;
+
+    CRITICAL_REGION_ENTER();
+    for(priority = first; (priority <= last) && (task == NULL); priority++) {
+        if(pipelinePending[priority] != 0u) {
+            while((pipelinePending[priority] & (1uL << id)) == 0u) {
+                id++;
+            }
+            pipelinePending[priority] &= ~(1uL << id);
+            task = pipelineTasks[id];
+        }
+    }
+    CRITICAL_REGION_EXIT();
+
+    return task;
+}
+
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
@@ -0,0 +1,80 @@
+/***********************************************************************************************//**
+ * Copyright 2021 Mario Kodba
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ***************************************************************************************************
+ * @file    pipeline.h
+ * @author  mario.kodba
+ * @brief   Run-to-completion task scheduler for sensor and BLE pipeline stages header file.
+ **************************************************************************************************/
+
+#ifndef PIPELINE_H_
+#define PIPELINE_H_
+
+/***************************************************************************************************
+ *                              INCLUDE FILES
+ **************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/***************************************************************************************************
+ *                              DEFINES
+ **************************************************************************************************/
+#define PIPELINE_MAX_TASKS      (8u)        //!< Maximum number of registered pipeline tasks
+
+/***************************************************************************************************
+ *                              ENUMERATIONS
+ **************************************************************************************************/
+//! Pipeline error enumeration
+typedef enum PIPELINE_err_ENUM {
+    PIPELINE_err_NONE           = 0u,       //!< No error
+    PIPELINE_err_NULL_PARAM,                //!< NULL parameter error
+    PIPELINE_err_TABLE_FULL                 //!< No room for another task
+} PIPELINE_err_E;
+
+//! Pipeline task priority enumeration
+typedef enum PIPELINE_priority_ENUM {
+    PIPELINE_priority_HIGH      = 0u,       //!< Runs from software interrupt, preempts NORMAL and LOW tasks
+    PIPELINE_priority_NORMAL    = 1u,       //!< Runs from main loop
+    PIPELINE_priority_LOW       = 2u,       //!< Runs from main loop, only when no NORMAL task is pending
+
+    PIPELINE_priority_COUNT
+} PIPELINE_priority_E;
+
+/***************************************************************************************************
+ *                              DATA STRUCTURES
+ **************************************************************************************************/
+//! Pipeline task handler type, receives task input queue
+typedef void (*PIPELINE_taskHandler_T)(void *queue);
+
+//! Pipeline task structure
+typedef struct PIPELINE_task_STRUCT {
+    PIPELINE_taskHandler_T  handler;        //!< Task handler, runs to completion once per post
+    void                   *queue;          //!< Task input queue, passed to handler
+    PIPELINE_priority_E     priority;       //!< Task priority
+    uint8_t                 id;             //!< Task index, assigned on registration
+} PIPELINE_task_S;
+
+/***************************************************************************************************
+ *                         PUBLIC FUNCTION DECLARATIONS
+ **************************************************************************************************/
+void PIPELINE_init(PIPELINE_err_E *outErr);
+void PIPELINE_registerTask(PIPELINE_task_S *task, PIPELINE_err_E *outErr);
+void PIPELINE_post(PIPELINE_task_S *task);
+void PIPELINE_run(void);
+bool PIPELINE_isIdle(void);
+
+#endif // #ifndef PIPELINE_H_
+/***************************************************************************************************
+ *                          END OF FILE
+ **************************************************************************************************/
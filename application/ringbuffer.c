@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include "ringbuffer.h"
 
 /**
@@ -24,11 +26,28 @@ void ring_buffer_queue(ring_buffer_t *buffer, char data) {
 }
 
 void ring_buffer_queue_arr(ring_buffer_t *buffer, const char *data, ring_buffer_size_t size) {
-  /* Add bytes; one by one */
-  ring_buffer_size_t i;
-  for(i = 0; i < size; i++) {
-    ring_buffer_queue(buffer, data[i]);
+  /* Only the newest RING_BUFFER_SIZE-1 bytes can be held */
+  if(size > RING_BUFFER_MASK) {
+    data += (size - RING_BUFFER_MASK);
+    size = RING_BUFFER_MASK;
+  }
+
+  /* Is going to overwrite the oldest bytes? */
+  ring_buffer_size_t free_space = RING_BUFFER_MASK - ring_buffer_num_items(buffer);
+  if(size > free_space) {
+    /* Increase tail index past the overwritten bytes */
+    buffer->tail_index = ((buffer->tail_index + (size - free_space)) & RING_BUFFER_MASK);
   }
+
+  /* Copy up to the end of the buffer memory, then wrap around */
+  size_t head = buffer->head_index;
+  size_t first = RING_BUFFER_SIZE - head;
+  if(first > size) {
+    first = size;
+  }
+  memcpy(&buffer->buffer[head], data, first);
+  memcpy(buffer->buffer, data + first, size - first);
+  buffer->head_index = ((head + size) & RING_BUFFER_MASK);
 }
 
 uint8_t ring_buffer_dequeue(ring_buffer_t *buffer, char *data) {
@@ -43,17 +62,24 @@ uint8_t ring_buffer_dequeue(ring_buffer_t *buffer, char *data) {
 }
 
 ring_buffer_size_t ring_buffer_dequeue_arr(ring_buffer_t *buffer, char *data, ring_buffer_size_t len) {
-  if(ring_buffer_is_empty(buffer)) {
+  ring_buffer_size_t cnt = ring_buffer_num_items(buffer);
+  if(cnt == 0) {
     /* No items */
     return 0;
   }
+  if(cnt > len) {
+    cnt = len;
+  }
 
-  char *data_ptr = data;
-  ring_buffer_size_t cnt = 0;
-  while((cnt < len) && ring_buffer_dequeue(buffer, data_ptr)) {
-    cnt++;
-    data_ptr++;
+  /* Copy up to the end of the buffer memory, then wrap around */
+  size_t tail = buffer->tail_index;
+  size_t first = RING_BUFFER_SIZE - tail;
+  if(first > cnt) {
+    first = cnt;
   }
+  memcpy(data, &buffer->buffer[tail], first);
+  memcpy(data + first, buffer->buffer, cnt - first);
+  buffer->tail_index = ((tail + cnt) & RING_BUFFER_MASK);
   return cnt;
 }
 
@@ -1,4 +1,5 @@
 #include <inttypes.h>
+#include <string.h>
 
 /**
  * @file
@@ -23,9 +24,16 @@
 /**
  * The type which is used to hold the size
  * and the indicies of the buffer.
- * Must be able to fit \c RING_BUFFER_SIZE .
+ * Selected at compile time as the smallest unsigned
+ * type able to hold <tt> RING_BUFFER_SIZE-1 </tt>.
  */
+#if RING_BUFFER_SIZE <= 256
 typedef uint8_t ring_buffer_size_t;
+#elif RING_BUFFER_SIZE <= 65536
+typedef uint16_t ring_buffer_size_t;
+#else
+typedef uint32_t ring_buffer_size_t;
+#endif
 
 /**
  * Used as a modulo operator
@@ -70,6 +78,9 @@ void ring_buffer_queue(ring_buffer_t *buffer, char data);
 
 /**
  * Adds an array of bytes to a ring buffer.
+ * The data is copied with at most two memcpy calls. If there is not
+ * enough free space, the oldest bytes are overwritten, same as for
+ * ring_buffer_queue().
  * @param buffer The buffer in which the data should be placed.
  * @param data A pointer to the array of bytes to place in the queue.
  * @param size The size of the array.
@@ -86,6 +97,7 @@ uint8_t ring_buffer_dequeue(ring_buffer_t *buffer, char *data);
 
 /**
  * Returns the <em>len</em> oldest bytes in a ring buffer.
+ * The data is copied with at most two memcpy calls.
  * @param buffer The buffer from which the data should be returned.
  * @param data A pointer to the array at which the data should be placed.
  * @param len The maximum number of bytes to return.
@@ -129,4 +141,125 @@ inline ring_buffer_size_t ring_buffer_num_items(ring_buffer_t *buffer) {
   return ((buffer->head_index - buffer->tail_index) & RING_BUFFER_MASK);
 }
 
+/**
+ * Loads an index written by the other side of a SPSC ring buffer.
+ * Later memory accesses are not reordered before the load.
+ */
+#define RING_BUFFER_LOAD_ACQUIRE(index) __atomic_load_n(&(index), __ATOMIC_ACQUIRE)
+
+/**
+ * Publishes an index to the other side of a SPSC ring buffer.
+ * Earlier memory accesses are completed before the store.
+ */
+#define RING_BUFFER_STORE_RELEASE(index, value) __atomic_store_n(&(index), (value), __ATOMIC_RELEASE)
+
+/**
+ * Generates a typed SPSC ring buffer named <em>name</em>.
+ * Each instance type has its own element type and power of two
+ * capacity, so records are queued whole and every ring is sized
+ * to its own use. The head index is only written by the producer
+ * and the tail index only by the consumer, so the producer can run
+ * in an interrupt while the consumer runs in thread mode, without
+ * any locking. A full buffer never overwrites the oldest data, new
+ * data is dropped and counted instead.
+ * - <tt>name_t</tt>: the ring buffer structure.
+ * - <tt>name_init()</tt>: empties the ring buffer.
+ * - <tt>name_queue()</tt>, <tt>name_reserve()</tt>, <tt>name_commit()</tt>: producer side.
+ * - <tt>name_dequeue()</tt>, <tt>name_peek_contiguous()</tt>, <tt>name_peek_arr()</tt>,
+ *   <tt>name_release()</tt>: consumer side.
+ * - <tt>name_num_items()</tt>, <tt>name_overflow_count()</tt>: either side.
+ *
+ * Only <tt> size-1 </tt> elements can be contained in the buffer.
+ * @param name Prefix of the generated type and functions.
+ * @param type Element type.
+ * @param size Number of elements, a power of two not larger than 32768.
+ */
+#define RING_BUFFER_TYPED_DEFINE(name, type, size)                                              \
+  typedef char name##_size_check[(((size) & ((size) - 1)) == 0 && (size) <= 32768) ? 1 : -1];  \
+                                                                                                \
+  typedef struct name##_t {                                                                     \
+    type buffer[size];                                                                          \
+    volatile uint16_t tail_index;                                                               \
+    volatile uint16_t head_index;                                                               \
+    volatile uint32_t overflow_count;                                                           \
+  } name##_t;                                                                                   \
+                                                                                                \
+  static inline void name##_init(name##_t *ring) {                                              \
+    ring->tail_index = 0;                                                                       \
+    ring->head_index = 0;                                                                       \
+    ring->overflow_count = 0;                                                                   \
+  }                                                                                             \
+                                                                                                \
+  static inline uint16_t name##_num_items(name##_t *ring) {                                     \
+    return ((RING_BUFFER_LOAD_ACQUIRE(ring->head_index) -                                       \
+             RING_BUFFER_LOAD_ACQUIRE(ring->tail_index)) & ((size) - 1));                       \
+  }                                                                                             \
+                                                                                                \
+  static inline uint32_t name##_overflow_count(name##_t *ring) {                                \
+    return ring->overflow_count;                                                                \
+  }                                                                                             \
+                                                                                                \
+  static inline type *name##_reserve(name##_t *ring) {                                          \
+    uint16_t head = ring->head_index;                                                           \
+    uint16_t next = ((head + 1) & ((size) - 1));                                                \
+    if(next == RING_BUFFER_LOAD_ACQUIRE(ring->tail_index)) {                                    \
+      ring->overflow_count++;                                                                   \
+      return NULL;                                                                              \
+    }                                                                                           \
+    return &ring->buffer[head];                                                                 \
+  }                                                                                             \
+                                                                                                \
+  static inline void name##_commit(name##_t *ring) {                                            \
+    RING_BUFFER_STORE_RELEASE(ring->head_index,                                                 \
+                              (uint16_t) ((ring->head_index + 1) & ((size) - 1)));              \
+  }                                                                                             \
+                                                                                                \
+  static inline uint8_t name##_queue(name##_t *ring, const type *item) {                        \
+    type *slot = name##_reserve(ring);                                                          \
+    if(slot == NULL) {                                                                          \
+      return 0;                                                                                 \
+    }                                                                                           \
+    *slot = *item;                                                                              \
+    name##_commit(ring);                                                                        \
+    return 1;                                                                                   \
+  }                                                                                             \
+                                                                                                \
+  static inline const type *name##_peek_contiguous(name##_t *ring, uint16_t *count) {           \
+    uint16_t tail = ring->tail_index;                                                           \
+    uint16_t cnt = ((RING_BUFFER_LOAD_ACQUIRE(ring->head_index) - tail) & ((size) - 1));        \
+    if(cnt > ((size) - tail)) {                                                                 \
+      cnt = ((size) - tail);                                                                    \
+    }                                                                                           \
+    *count = cnt;                                                                               \
+    return (cnt != 0) ? &ring->buffer[tail] : NULL;                                             \
+  }                                                                                             \
+                                                                                                \
+  static inline uint16_t name##_peek_arr(name##_t *ring, type *items, uint16_t count) {         \
+    uint16_t tail = ring->tail_index;                                                           \
+    uint16_t cnt = ((RING_BUFFER_LOAD_ACQUIRE(ring->head_index) - tail) & ((size) - 1));        \
+    if(cnt > count) {                                                                           \
+      cnt = count;                                                                              \
+    }                                                                                           \
+    uint16_t first = ((size) - tail);                                                           \
+    if(first > cnt) {                                                                           \
+      first = cnt;                                                                              \
+    }                                                                                           \
+    memcpy(items, &ring->buffer[tail], first * sizeof(type));                                   \
+    memcpy(items + first, ring->buffer, (cnt - first) * sizeof(type));                          \
+    return cnt;                                                                                 \
+  }                                                                                             \
+                                                                                                \
+  static inline void name##_release(name##_t *ring, uint16_t count) {                           \
+    RING_BUFFER_STORE_RELEASE(ring->tail_index,                                                 \
+                              (uint16_t) ((ring->tail_index + count) & ((size) - 1)));          \
+  }                                                                                             \
+                                                                                                \
+  static inline uint8_t name##_dequeue(name##_t *ring, type *item) {                            \
+    if(name##_peek_arr(ring, item, 1) == 0) {                                                   \
+      return 0;                                                                                 \
+    }                                                                                           \
+    name##_release(ring, 1);                                                                    \
+    return 1;                                                                                   \
+  }
+
 #endif /* RINGBUFFER_H */
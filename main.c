@@ -28,7 +28,6 @@
 #include "cfg_ble_muha.h"
 #include "cfg_drv_timer.h"
 
-#include "nrf_delay.h"
 #include "nrf_log_ctrl.h"
 #include "nrf_log.h"
 
@@ -49,8 +48,6 @@
  **************************************************************************************************/
 int main(void) {
 
-    nrf_delay_ms(200u);
-
     ERR_E error = ERR_NONE;
 
     // in case NRF logging is used
@@ -0,0 +1,471 @@
+#!/usr/bin/env python3
+# Copyright 2021 Mario Kodba
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+"""Host side reference for ADS1192 ECG codec (application/ecg_codec.c).
+
+decode - decodes stream characteristic notifications, one notification per line as hex, to CSV
+         samples. Both codec and raw ECG records are decoded, other records are skipped.
+bench  - encodes recorded ECG (CSV, one sample per line, one column per channel) the same way
+         the firmware does, checks that decoding gives back the input and prints packet statistics.
+synth  - writes synthetic two lead ECG (CSV) for bench, amplitude in ADS1192 LSB (~6 uV at PGA 12X).
+"""
+
+import argparse
+import csv
+import math
+import random
+import struct
+import sys
+
+# BLE sensor data stream (application/ble_ecgs.h)
+STREAM_HEADER_SIZE = 2
+STREAM_PAYLOAD_SIZE = 18
+STREAM_VERSION = 1
+STREAM_VERSION_SHIFT = 6
+STREAM_OFFSET_MASK = 0x3F
+STREAM_NO_RECORD = 0x3F
+SEQUENCE_MASK = 0xFF
+RECORD_TL_SIZE = 2
+RECORD_HEADER_SIZE = 5
+RECORD_MAX_PAYLOAD = 32
+RECORD_TYPE_SHIFT = 4
+RECORD_FLAGS_MASK = 0x0F
+RECORD_ECG = 0
+LEAD_OFF_FLAG = 0x01
+CODEC_FLAG = 0x02
+KEYFRAME_FLAG = 0x04
+
+# encoded packet, payload of ECG record (application/ecg_codec.h)
+PACKET_SIZE = 32
+MAX_SAMPLES = 40
+PREDICTOR_BITS = 2
+RICE_PARAM_BITS = 4
+MAX_RICE_PARAM = 15
+ESCAPE_LENGTH = 16
+RAW_WIDTH = 16
+PACKET_BITS = PACKET_SIZE * 8
+
+# ECG_CODEC_predictor_E
+FIRST_ORDER = 0
+SECOND_ORDER = 1
+CROSS_FIRST = 2
+CROSS_SECOND = 3
+PREDICTOR_COUNT = 4
+
+
+def prediction(predictor, sample, prev, channel):
+    """Cross-channel predictors take channel 1 of the same sample, so channel 1 is decoded first."""
+    if predictor == SECOND_ORDER:
+        return 2 * prev[0][channel] - prev[1][channel]
+    if predictor == CROSS_FIRST:
+        return prev[0][channel] + sample[0] - prev[0][0]
+    if predictor == CROSS_SECOND:
+        return 2 * prev[0][channel] - prev[1][channel] + sample[0] - (2 * prev[0][0] - prev[1][0])
+    return prev[0][channel]
+
+
+def residual(predictor, sample, prev, channel):
+    return sample[channel] - prediction(predictor, sample, prev, channel)
+
+
+def map_residual(value):
+    return -2 * value - 1 if value < 0 else 2 * value
+
+
+def unmap_residual(value):
+    return -((value + 1) >> 1) if value & 1 else value >> 1
+
+
+def rice_bits(value, rice_param):
+    quotient = value >> rice_param
+    return quotient + 1 + rice_param if quotient < ESCAPE_LENGTH else ESCAPE_LENGTH + RAW_WIDTH
+
+
+def select_parameters(samples, first, history, channel):
+    """Mirrors ECG_CODEC_selectParameters, returns (predictor, Rice parameter)."""
+    best = None
+    for predictor in range(CROSS_FIRST if channel == 0 else PREDICTOR_COUNT):
+        prev = [list(history[0]), list(history[1])]
+        total = 0
+        for sample in samples[first:]:
+            total += map_residual(residual(predictor, sample, prev, channel))
+            prev = [list(sample), prev[0]]
+        if best is None or total < best[1]:
+            best = (predictor, total)
+
+    rice_param = 0
+    if len(samples) > first:
+        mean = best[1] // (len(samples) - first)
+        while mean >> (rice_param + 1) and rice_param < MAX_RICE_PARAM:
+            rice_param += 1
+    return best[0], rice_param
+
+
+def to_signed(value, width):
+    if width and value & (1 << (width - 1)):
+        value -= 1 << width
+    return value
+
+
+class BitReader:
+    def __init__(self, packet, position):
+        self.packet = packet
+        self.position = position
+
+    def read_rice(self, rice_param):
+        """Returns mapped residual, or None if raw sample follows."""
+        quotient = 0
+        while quotient < ESCAPE_LENGTH and self.read(1):
+            quotient += 1
+        if quotient == ESCAPE_LENGTH:
+            return None
+        return (quotient << rice_param) | self.read(rice_param)
+
+    def read(self, width):
+        value = 0
+        for _ in range(width):
+            bit = (self.packet[self.position >> 3] >> (7 - (self.position & 7))) & 1
+            value = (value << 1) | bit
+            self.position += 1
+        return value
+
+
+class BitWriter:
+    def __init__(self):
+        self.packet = bytearray(PACKET_SIZE)
+        self.position = 0
+
+    def write_rice(self, value, rice_param, sample):
+        quotient = value >> rice_param
+        if quotient < ESCAPE_LENGTH:
+            self.write(((1 << quotient) - 1) << 1, quotient + 1)
+            self.write(value, rice_param)
+        else:
+            self.write((1 << ESCAPE_LENGTH) - 1, ESCAPE_LENGTH)
+            self.write(sample & 0xFFFF, RAW_WIDTH)
+
+    def write(self, value, width):
+        for i in range(width - 1, -1, -1):
+            if (value >> i) & 1:
+                self.packet[self.position >> 3] |= 0x80 >> (self.position & 7)
+            self.position += 1
+
+    def bytes(self):
+        return bytes(self.packet[:(self.position + 7) >> 3])
+
+
+def parse_record(record):
+    """Returns (type, flags, sample count, timestamp, payload) of stream record."""
+    timestamp, = struct.unpack_from("<H", record, 3)
+    return (record[0] >> RECORD_TYPE_SHIFT, record[0] & RECORD_FLAGS_MASK, record[2], timestamp,
+            record[RECORD_HEADER_SIZE:])
+
+
+def build_record(record_type, flags, count, timestamp, payload):
+    return struct.pack("<BBBH", (record_type << RECORD_TYPE_SHIFT) | flags,
+                       RECORD_HEADER_SIZE - RECORD_TL_SIZE + len(payload), count, timestamp & 0xFFFF) + payload
+
+
+class StreamWriter:
+    """Mirrors BLE_ECGS_recordWrite and BLE_ECGS_streamSend, all records are sent in full notifications."""
+
+    def __init__(self):
+        self.buffer = b""
+        self.record_offset = 0
+        self.sequence = 0
+
+    def write(self, record):
+        self.buffer += record
+
+    def notifications(self, flush=False):
+        while len(self.buffer) >= STREAM_PAYLOAD_SIZE or (flush and self.buffer):
+            size = min(len(self.buffer), STREAM_PAYLOAD_SIZE)
+            offset = self.record_offset if self.record_offset < size else STREAM_NO_RECORD
+            yield bytes([(STREAM_VERSION << STREAM_VERSION_SHIFT) | offset, self.sequence]) + self.buffer[:size]
+            while self.record_offset < size:
+                self.record_offset += RECORD_TL_SIZE + self.buffer[self.record_offset + 1]
+            self.record_offset -= size
+            self.buffer = self.buffer[size:]
+            self.sequence = (self.sequence + 1) & SEQUENCE_MASK
+
+
+class StreamReader:
+    """Reassembles records from notifications, resumes at first whole record after a lost notification."""
+
+    def __init__(self):
+        self.buffer = None
+        self.sequence = None
+        self.lost_notifications = 0
+
+    def read(self, notification):
+        """Returns (records, gap), gap is true if records were lost before returned ones."""
+        if len(notification) < STREAM_HEADER_SIZE:
+            raise ValueError("notification has to be at least %d bytes" % STREAM_HEADER_SIZE)
+        if notification[0] >> STREAM_VERSION_SHIFT != STREAM_VERSION:
+            raise ValueError("unsupported stream version %d" % (notification[0] >> STREAM_VERSION_SHIFT))
+        offset = notification[0] & STREAM_OFFSET_MASK
+        sequence = notification[1]
+        payload = notification[STREAM_HEADER_SIZE:]
+        gap = False
+
+        if self.sequence is not None and sequence != self.sequence:
+            self.lost_notifications += (sequence - self.sequence) & SEQUENCE_MASK
+            self.buffer = None
+        self.sequence = (sequence + 1) & SEQUENCE_MASK
+
+        if self.buffer is None:
+            if offset == STREAM_NO_RECORD:
+                return [], False
+            gap = True
+            self.buffer = payload[offset:]
+        else:
+            self.buffer += payload
+
+        records = []
+        while len(self.buffer) >= RECORD_TL_SIZE and len(self.buffer) >= RECORD_TL_SIZE + self.buffer[1]:
+            size = RECORD_TL_SIZE + self.buffer[1]
+            records.append(self.buffer[:size])
+            self.buffer = self.buffer[size:]
+        return records, gap
+
+
+class Decoder:
+    """Decodes ECG records in order of reception, waits for keyframe after a lost record."""
+
+    def __init__(self, channel_count):
+        self.channel_count = channel_count
+        self.history = None
+
+    def reset(self):
+        self.history = None
+
+    def decode(self, record):
+        record_type, flags, count, _, packet = parse_record(record)
+        if record_type != RECORD_ECG:
+            return []
+
+        if not flags & CODEC_FLAG:
+            values = struct.unpack("<%dh" % (count * self.channel_count), packet)
+            return [list(values[i:i + self.channel_count]) for i in range(0, len(values), self.channel_count)]
+
+        keyframe = (flags & KEYFRAME_FLAG) != 0
+        if self.history is None and not keyframe:
+            return []
+
+        # bits past the end of trimmed packet are zero
+        reader = BitReader(packet + bytes(PACKET_SIZE - len(packet)), 0)
+        parameters = [(reader.read(PREDICTOR_BITS), reader.read(RICE_PARAM_BITS)) for _ in range(self.channel_count)]
+        samples = []
+        for i in range(count):
+            if keyframe and i == 0:
+                sample = [to_signed(reader.read(RAW_WIDTH), RAW_WIDTH) for _ in range(self.channel_count)]
+                self.history = [list(sample), list(sample)]
+            else:
+                sample = []
+                for c, (predictor, rice_param) in enumerate(parameters):
+                    value = reader.read_rice(rice_param)
+                    if value is None:
+                        sample.append(to_signed(reader.read(RAW_WIDTH), RAW_WIDTH))
+                    else:
+                        sample.append(unmap_residual(value) + prediction(predictor, sample, self.history, c))
+                self.history = [list(sample), self.history[0]]
+            samples.append(sample)
+        return samples
+
+
+class Encoder:
+    """Mirrors ECG_CODEC_encode and ECG_CODEC_commit."""
+
+    def __init__(self, channel_count, keyframe_interval):
+        self.channel_count = channel_count
+        self.keyframe_interval = keyframe_interval
+        self.history = [[0] * channel_count, [0] * channel_count]
+        self.packets_to_keyframe = 0
+
+    def encode(self, samples, timestamp=0):
+        """Returns (ECG record, sample count) or (None, 0) if more samples are needed."""
+        keyframe = self.packets_to_keyframe == 0
+        samples = samples[:MAX_SAMPLES]
+        prev = [list(self.history[0]), list(self.history[1])]
+        writer = BitWriter()
+        count = first = 0
+        full = False
+
+        if keyframe and samples:
+            prev = [list(samples[0]), list(samples[0])]
+            count = first = 1
+
+        parameters = [select_parameters(samples, first, prev, c) for c in range(self.channel_count)]
+        for predictor, rice_param in parameters:
+            writer.write(predictor, PREDICTOR_BITS)
+            writer.write(rice_param, RICE_PARAM_BITS)
+        for sample in samples[:first]:
+            for value in sample:
+                writer.write(value & 0xFFFF, RAW_WIDTH)
+
+        i = count
+        while i < len(samples) and not full:
+            values = [map_residual(residual(p, samples[i], prev, c)) for c, (p, _) in enumerate(parameters)]
+            sample_bits = sum(rice_bits(v, k) for v, (_, k) in zip(values, parameters))
+            if writer.position + sample_bits > PACKET_BITS:
+                full = True
+            else:
+                for c, (_, rice_param) in enumerate(parameters):
+                    writer.write_rice(values[c], rice_param, samples[i][c])
+                prev = [list(samples[i]), prev[0]]
+                count = i + 1
+                full = count == MAX_SAMPLES
+            i += 1
+
+        if not full:
+            return None, 0
+
+        self._next = (prev, keyframe)
+        flags = CODEC_FLAG | (KEYFRAME_FLAG if keyframe else 0)
+        return build_record(RECORD_ECG, flags, count, timestamp, writer.bytes()), count
+
+    def commit(self):
+        self.history, keyframe = self._next
+        if keyframe:
+            self.packets_to_keyframe = self.keyframe_interval - 1
+        else:
+            self.packets_to_keyframe -= 1
+
+
+def decode_stream(decoder, reader, notification):
+    samples = []
+    records, gap = reader.read(notification)
+    if gap:
+        decoder.reset()
+    for record in records:
+        samples.extend(decoder.decode(record))
+    return samples
+
+
+def read_samples(path, channel_count):
+    samples = []
+    with open(path, newline="") as f:
+        for row in csv.reader(f):
+            values = [v.strip() for v in row if v.strip()]
+            try:
+                sample = [int(float(v)) for v in values[:channel_count]]
+            except ValueError:
+                continue    # header line
+            if len(sample) == channel_count:
+                samples.append([max(-32768, min(32767, v)) for v in sample])
+    return samples
+
+
+def bench(args):
+    samples = read_samples(args.input, args.channels)
+    encoder = Encoder(args.channels, args.keyframe_interval)
+    stream = StreamWriter()
+    reader = StreamReader()
+    decoder = Decoder(args.channels)
+    decoded = []
+    counts = []
+    keyframes = 0
+    notifications = 0
+    position = 0
+
+    while True:
+        record, count = encoder.encode(samples[position:position + MAX_SAMPLES])
+        if count == 0:
+            break
+        keyframes += (record[0] & KEYFRAME_FLAG) != 0
+        encoder.commit()
+        stream.write(record)
+        counts.append(count)
+        position += count
+
+    for notification in stream.notifications(flush=True):
+        decoded.extend(decode_stream(decoder, reader, notification))
+        notifications += 1
+
+    if decoded != samples[:position]:
+        print("decoded samples do not match input", file=sys.stderr)
+        return 1
+    if not counts:
+        print("not enough samples for one record", file=sys.stderr)
+        return 1
+
+    # uncompressed records, as sent with NRF51_MUHA_ADS1192_CODEC_MODE set to false
+    raw_samples = RECORD_MAX_PAYLOAD // (args.channels * 2)
+    raw_records = -(-position // raw_samples)
+    raw_notifications = (raw_records * RECORD_HEADER_SIZE + position * args.channels * 2) / STREAM_PAYLOAD_SIZE
+    print("samples            %d x %d channels" % (position, args.channels))
+    print("records            %d (%d keyframes)" % (len(counts), keyframes))
+    print("samples per record %.1f avg, %d min, %d max" % (position / len(counts), min(counts), max(counts)))
+    print("notifications      %d, raw would take %.1f" % (notifications, raw_notifications))
+    print("samples per notif. %.1f (%d byte notifications)" % (position / notifications,
+                                                              STREAM_HEADER_SIZE + STREAM_PAYLOAD_SIZE))
+    print("compression ratio  %.2f" % (raw_notifications / notifications))
+    print("round trip         lossless")
+    return 0
+
+
+def decode(args):
+    reader = StreamReader()
+    decoder = Decoder(args.channels)
+    writer = csv.writer(sys.stdout)
+    with open(args.input) as f:
+        for line in f:
+            line = line.strip().replace(" ", "").replace(":", "").replace("-", "")
+            if line:
+                writer.writerows(decode_stream(decoder, reader, bytes.fromhex(line)))
+    if reader.lost_notifications:
+        print("lost notifications: %d" % reader.lost_notifications, file=sys.stderr)
+    return 0
+
+
+def synth(args):
+    """Two leads sharing QRS complex at 75 bpm, with baseline wander and independent noise."""
+    rng = random.Random(args.seed)
+    scale = args.amplitude / 3000.0
+    with open(args.input, "w", newline="") as f:
+        writer = csv.writer(f)
+        writer.writerow(["ch1", "ch2"])
+        for n in range(int(args.seconds * args.rate)):
+            t = n / args.rate
+            phase = (t % 0.8) / 0.8
+            qrs = 3000 * math.exp(-((phase - 0.3) / 0.012) ** 2) - 600 * math.exp(-((phase - 0.27) / 0.01) ** 2)
+            t_wave = 500 * math.exp(-((phase - 0.6) / 0.05) ** 2)
+            p_wave = 200 * math.exp(-((phase - 0.15) / 0.03) ** 2)
+            baseline = 300 * math.sin(2 * math.pi * 0.25 * t)
+            writer.writerow([round((qrs + t_wave + p_wave + baseline) * scale + rng.gauss(0, args.noise)),
+                             round((0.7 * qrs - t_wave + p_wave + 0.5 * baseline) * scale + rng.gauss(0, args.noise))])
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("command", choices=["decode", "bench", "synth"])
+    parser.add_argument("input", help="hex notifications (decode), CSV samples (bench) or output CSV (synth)")
+    parser.add_argument("-c", "--channels", type=int, choices=[1, 2], default=2,
+                        help="NRF51_MUHA_ADS1192_CHANNEL_COUNT (default 2)")
+    parser.add_argument("-k", "--keyframe-interval", type=int, default=16,
+                        help="ecgCodecConfig.keyframeInterval (default 16)")
+    parser.add_argument("-a", "--amplitude", type=float, default=250,
+                        help="synth: R wave amplitude of lead 1 in LSB (default 250, ~1.5 mV at PGA 12X)")
+    parser.add_argument("-n", "--noise", type=float, default=1.5, help="synth: noise RMS in LSB (default 1.5)")
+    parser.add_argument("-s", "--seconds", type=float, default=60, help="synth: duration (default 60)")
+    parser.add_argument("-r", "--rate", type=float, default=250, help="synth: sample rate (default 250)")
+    parser.add_argument("--seed", type=int, default=1, help="synth: noise seed (default 1)")
+    args = parser.parse_args()
+    commands = {"bench": bench, "decode": decode, "synth": synth}
+    return commands[args.command](args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())